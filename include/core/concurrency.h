@@ -1,7 +1,7 @@
-#pragma once
-
-#include <atomic>
-
-#include "core/concurrency/condition_variable.h"
-#include "core/concurrency/mutex.h"
-#include "core/concurrency/thread.h"
+#pragma once
+
+#include <atomic>
+
+#include "core/concurrency/condition_variable.h"
+#include "core/concurrency/mutex.h"
+#include "core/concurrency/thread.h"
@@ -1,40 +1,63 @@
-#pragma once
-
-#include <pthread.h>
-
-#include "core/concurrency/mutex.h"
-
-class ConditionVariable
-   {
-   public:
-      ConditionVariable( ) noexcept
-         { pthread_cond_init( &_handle, nullptr ); }
-
-      ConditionVariable( const ConditionVariable & ) = delete;
-      ConditionVariable &operator=( const ConditionVariable & ) = delete;
-      ConditionVariable( ConditionVariable && ) = delete;
-      ConditionVariable &operator=( ConditionVariable && ) = delete;
-
-      ~ConditionVariable( ) noexcept
-         { pthread_cond_destroy( &_handle ); }
-
-      template<typename Mutex>
-      void wait( UniqueLock<Mutex> &lock )
-         { pthread_cond_wait( &_handle, &lock.mutex( ).handle( ) ); }
-
-      template<typename Mutex, typename Predicate>
-      void wait( UniqueLock<Mutex> &lock, Predicate predicate )
-         { while ( !predicate( ) ) wait( lock ); }
-
-      void notifyOne( ) noexcept
-         { pthread_cond_signal( &_handle ); }
-
-      void notifyAll( ) noexcept
-         { pthread_cond_broadcast( &_handle ); }
-
-      pthread_cond_t &handle( ) noexcept
-         { return _handle; }
-
-   private:
-      pthread_cond_t _handle;
-   };
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <pthread.h>
+
+#include "core/concurrency/mutex.h"
+
+class ConditionVariable
+   {
+   public:
+      ConditionVariable( ) noexcept
+         { pthread_cond_init( &_handle, nullptr ); }
+
+      ConditionVariable( const ConditionVariable & ) = delete;
+      ConditionVariable &operator=( const ConditionVariable & ) = delete;
+      ConditionVariable( ConditionVariable && ) = delete;
+      ConditionVariable &operator=( ConditionVariable && ) = delete;
+
+      ~ConditionVariable( ) noexcept
+         { pthread_cond_destroy( &_handle ); }
+
+      template<typename Mutex>
+      void wait( UniqueLock<Mutex> &lock )
+         { pthread_cond_wait( &_handle, &lock.mutex( ).handle( ) ); }
+
+      template<typename Mutex, typename Predicate>
+      void wait( UniqueLock<Mutex> &lock, Predicate predicate )
+         { while ( !predicate( ) ) wait( lock ); }
+
+      /// Waits until a predicate holds or a timeout elapses.
+      /// \param lock The lock to release while waiting.
+      /// \param timeout The maximum time to wait.
+      /// \param predicate The predicate.
+      /// \return The value of the predicate when the wait ends.
+      template<typename Mutex, typename Predicate>
+      bool waitFor( UniqueLock<Mutex> &lock, std::chrono::milliseconds timeout, Predicate predicate )
+         {
+         const auto deadline = std::chrono::system_clock::now( ) + timeout;
+         const auto deadlineSeconds = std::chrono::time_point_cast<std::chrono::seconds>( deadline );
+         const timespec deadlineSpec{
+               .tv_sec = static_cast<time_t>(deadlineSeconds.time_since_epoch( ).count( )),
+               .tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     deadline - deadlineSeconds ).count( ))
+         };
+         while ( !predicate( ) )
+            if ( pthread_cond_timedwait( &_handle, &lock.mutex( ).handle( ), &deadlineSpec ) == ETIMEDOUT )
+               return predicate( );
+         return true;
+         }
+
+      void notifyOne( ) noexcept
+         { pthread_cond_signal( &_handle ); }
+
+      void notifyAll( ) noexcept
+         { pthread_cond_broadcast( &_handle ); }
+
+      pthread_cond_t &handle( ) noexcept
+         { return _handle; }
+
+   private:
+      pthread_cond_t _handle;
+   };
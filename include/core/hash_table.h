@@ -1,6 +1,7 @@
-#pragma once
-
-#include "core/hash_table/bloom_filter.h"
-#include "core/hash_table/hash.h"
-#include "core/hash_table/hash_map.h"
-#include "core/hash_table/hash_set.h"
+#pragma once
+
+#include "core/hash_table/bloom_filter.h"
+#include "core/hash_table/hash.h"
+#include "core/hash_table/hash_map.h"
+#include "core/hash_table/hash_set.h"
+#include "core/hash_table/perfect_hash_set.h"
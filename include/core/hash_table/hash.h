@@ -1,11 +1,11 @@
-#pragma once
-
-#include <functional>
-
-template<typename T>
-struct Hash
-   {
-   public:
-      size_t operator()( const T &value ) const
-         { return std::hash<T>( )( value ); }
-   };
+#pragma once
+
+#include <functional>
+
+template<typename T>
+struct Hash
+   {
+   public:
+      size_t operator()( const T &value ) const
+         { return std::hash<T>( )( value ); }
+   };
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "core/exception.h"
+#include "core/hash_table/hash_set.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Provides case-insensitive membership queries over a fixed set of strings through a perfect hash function built
+/// with the hash-and-displace method. Lookups hash the key once, probe exactly one slot, and never allocate.
+class PerfectHashSet
+   {
+   public:
+      /// Initializes an empty `PerfectHashSet`.
+      PerfectHashSet( ) = default;
+
+      /// Initializes a `PerfectHashSet` with the specified keys.
+      /// \param keys The keys, which are compared case-insensitively; later duplicates are ignored.
+      explicit PerfectHashSet( const Vector<String> &keys )
+         {
+         HashSet<String> uniqueKeys;
+         for ( const auto &key : keys )
+            {
+            String lowercaseKey( key.size( ), '\0' );
+            std::transform( key.cbegin( ), key.cend( ), lowercaseKey.begin( ), toLower );
+            if ( uniqueKeys.insert( lowercaseKey ).second )
+               _keys.emplace_back( std::move( lowercaseKey ) ), _values.emplace_back( &key - keys.data( ) );
+            }
+         if ( _keys.empty( ) ) return;
+
+         while ( !tryBuild( ) )
+            if ( ++_seed == _maxNumSeeds )
+               throw InvalidOperationException( "The perfect hash function cannot be built." );
+         }
+
+      /// Gets the number of keys in the `PerfectHashSet`.
+      /// \return The number of keys.
+      [[nodiscard]] int size( ) const noexcept
+         { return static_cast<int>(_keys.size( )); }
+
+      /// Indicates if the `PerfectHashSet` is empty.
+      /// \return `true` if the `PerfectHashSet` is empty.
+      [[nodiscard]] bool empty( ) const noexcept
+         { return _keys.empty( ); }
+
+      /// Finds a key.
+      /// \param key The key to find, compared case-insensitively.
+      /// \return The index of the key in the vector passed to the constructor, or -1 if it is not found.
+      [[nodiscard]] int find( StringView key ) const noexcept
+         {
+         if ( _keys.empty( ) ) return -1;
+         const auto hashValue = getHash( key, _seed );
+         const auto slot = _slots[ getSlot( hashValue, _displacements[ hashValue % _displacements.size( ) ] ) ];
+         if ( slot == -1 || !equalsIgnoreCase( _keys[ slot ], key ) ) return -1;
+         return _values[ slot ];
+         }
+
+      /// Indicates if a key is contained in the `PerfectHashSet`.
+      /// \param key The key to check, compared case-insensitively.
+      /// \return `true` if the key is contained in the `PerfectHashSet`.
+      [[nodiscard]] bool contains( StringView key ) const noexcept
+         { return find( key ) != -1; }
+
+   private:
+      static uint64_t getHash( StringView key, uint64_t seed ) noexcept
+         {
+         // FNV-1a over the lowercase key, followed by a finalizer so that the low bits are well mixed.
+         auto hashValue = 14695981039346656037ull ^ ( seed * 0x9e3779b97f4a7c15ull );
+         for ( const auto c : key )
+            hashValue = ( hashValue ^ static_cast<unsigned char>(toLower( c )) ) * 1099511628211ull;
+         hashValue ^= hashValue >> 33, hashValue *= 0xff51afd7ed558ccdull, hashValue ^= hashValue >> 33;
+         return hashValue;
+         }
+
+      [[nodiscard]] size_t getSlot( uint64_t hashValue, uint32_t displacement ) const noexcept
+         {
+         auto mixed = ( hashValue >> 32 | hashValue << 32 ) ^ ( displacement * 0xc4ceb9fe1a85ec53ull );
+         mixed ^= mixed >> 29;
+         return mixed % _slots.size( );
+         }
+
+      static bool equalsIgnoreCase( StringView lowercase, StringView other ) noexcept
+         {
+         return std::equal( lowercase.cbegin( ), lowercase.cend( ), other.cbegin( ), other.cend( ),
+                            [ ]( char lhs, char rhs )
+                               { return lhs == toLower( rhs ); } );
+         }
+
+      bool tryBuild( )
+         {
+         const auto numKeys = _keys.size( );
+         _displacements.assign( std::max<size_t>( numKeys / 4, 1 ), 0 );
+         _slots.assign( numKeys + numKeys / 4 + 1, -1 );
+
+         // Groups keys by bucket and places the largest buckets first, while most slots are still free.
+         Vector<Vector<int>> buckets( _displacements.size( ) );
+         Vector<uint64_t> hashValues( numKeys );
+         for ( size_t i = 0; i < numKeys; ++i )
+            {
+            hashValues[ i ] = getHash( _keys[ i ], _seed );
+            buckets[ hashValues[ i ] % buckets.size( ) ].emplace_back( i );
+            }
+         Vector<int> bucketOrder( buckets.size( ) );
+         std::iota( bucketOrder.begin( ), bucketOrder.end( ), 0 );
+         std::sort( bucketOrder.begin( ), bucketOrder.end( ), [ & ]( int lhs, int rhs )
+            { return buckets[ lhs ].size( ) > buckets[ rhs ].size( ); } );
+
+         // Searches for a displacement that sends every key of a bucket to a distinct free slot.
+         Vector<size_t> candidateSlots;
+         for ( const auto bucket : bucketOrder )
+            {
+            if ( buckets[ bucket ].empty( ) ) break;
+            auto isPlaced = false;
+            for ( uint32_t displacement = 0; displacement < _maxNumDisplacements && !isPlaced; ++displacement )
+               {
+               candidateSlots.clear( );
+               isPlaced = true;
+               for ( const auto key : buckets[ bucket ] )
+                  {
+                  const auto slot = getSlot( hashValues[ key ], displacement );
+                  if ( _slots[ slot ] != -1 ||
+                       std::find( candidateSlots.cbegin( ), candidateSlots.cend( ), slot ) != candidateSlots.cend( ) )
+                     {
+                     isPlaced = false;
+                     break;
+                     }
+                  candidateSlots.emplace_back( slot );
+                  }
+               if ( isPlaced )
+                  {
+                  _displacements[ bucket ] = displacement;
+                  for ( size_t i = 0; i < candidateSlots.size( ); ++i )
+                     _slots[ candidateSlots[ i ] ] = buckets[ bucket ][ i ];
+                  }
+               }
+            if ( !isPlaced ) return false;
+            }
+         return true;
+         }
+
+      static constexpr uint64_t _maxNumSeeds = 64;
+      static constexpr uint32_t _maxNumDisplacements = 1 << 16;
+
+      Vector<String> _keys;
+      Vector<int> _values;
+      Vector<uint32_t> _displacements;
+      Vector<int> _slots;
+      uint64_t _seed = 0;
+   };
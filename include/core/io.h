@@ -1,6 +1,6 @@
-#pragma once
-
-#include <iomanip>
-#include <iostream>
-
-#include "core/io/stream_writer.h"
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+
+#include "core/io/stream_writer.h"
@@ -1,6 +1,6 @@
-#pragma once
-
-#include "core/net/http.h"
-#include "core/net/socket.h"
-#include "core/net/ssl.h"
-#include "core/net/url.h"
+#pragma once
+
+#include "core/net/http.h"
+#include "core/net/socket.h"
+#include "core/net/ssl.h"
+#include "core/net/url.h"
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "core/concurrency.h"
+#include "core/hash_table.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+/// Identifies an interned host; IDs are dense and start at 0, so they can index flat per-host tables.
+using HostId = uint32_t;
+
+/// Interns host strings into dense `HostId`s. The table is safe for concurrent use and never forgets a host.
+class HostTable
+   {
+   public:
+      HostTable( ) = default;
+
+      HostTable( const HostTable & ) = delete;
+      HostTable &operator=( const HostTable & ) = delete;
+      HostTable( HostTable && ) = delete;
+      HostTable &operator=( HostTable && ) = delete;
+
+      /// Gets the process-wide `HostTable` used by `Url`.
+      /// \return The process-wide `HostTable`.
+      static HostTable &global( )
+         {
+         static HostTable hostTable;
+         return hostTable;
+         }
+
+      /// Gets the ID of a host, assigning the next free ID if the host is new.
+      /// \param host The host.
+      /// \return The ID of the host.
+      HostId intern( StringView host );
+
+      /// Gets the ID of a host if it has been interned.
+      /// \param host The host.
+      /// \return The ID of the host if it has been interned.
+      [[nodiscard]] std::optional<HostId> find( StringView host ) const;
+
+      /// Gets the host of an ID.
+      /// \param id An ID returned by `intern`.
+      /// \return The host, which stays valid for the lifetime of the table.
+      [[nodiscard]] StringView hostOf( HostId id ) const noexcept
+         { return _chunks[ id / _chunkSize ].load( std::memory_order_acquire )[ id % _chunkSize ]; }
+
+      /// Gets the number of interned hosts, which is also the next ID to be assigned.
+      /// \return The number of interned hosts.
+      [[nodiscard]] HostId size( ) const noexcept
+         { return _size.load( std::memory_order_acquire ); }
+
+   private:
+      struct Shard
+         {
+         public:
+            HashMap<StringView, HostId> ids;
+            mutable Mutex mutex;
+         };
+
+      static constexpr auto _numShards = 64;
+      static constexpr auto _chunkSize = 1 << 16;
+      static constexpr auto _maxNumChunks = 1 << 16;
+
+      std::array<Shard, _numShards> _shards;
+      std::array<std::atomic<String *>, _maxNumChunks> _chunks{ };
+      Vector<UniquePtr<String[]>> _ownedChunks;
+      Mutex _chunksMutex;
+      std::atomic<HostId> _size = 0;
+   };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/hash_table.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Answers public suffix queries against a trie of Public Suffix List rules.
+class PublicSuffixList
+   {
+   public:
+      /// Initializes a `PublicSuffixList` with the specified rules.
+      /// \param rules The rules in the Public Suffix List format, one rule per element, without comments.
+      explicit PublicSuffixList( const Vector<StringView> &rules );
+
+      PublicSuffixList( const PublicSuffixList & ) = delete;
+      PublicSuffixList &operator=( const PublicSuffixList & ) = delete;
+
+      /// Gets the `PublicSuffixList` built from the snapshot bundled at compile time.
+      /// \return The bundled `PublicSuffixList`.
+      static const PublicSuffixList &bundled( );
+
+      /// Gets the public suffix of a host.
+      /// \param host The host, which is matched case-insensitively.
+      /// \return The public suffix as a view into `host`; the last label if no rule matches.
+      [[nodiscard]] StringView publicSuffix( StringView host ) const noexcept;
+
+      /// Gets the registrable domain of a host, i.e. its public suffix plus one more label.
+      /// \param host The host, which is matched case-insensitively.
+      /// \return The registrable domain as a view into `host`; `host` itself if it is a public suffix or an IP address.
+      [[nodiscard]] StringView registrableDomain( StringView host ) const noexcept;
+
+   private:
+      struct Node
+         {
+         public:
+            bool isRule = false;
+            bool isException = false;
+         };
+
+      struct Edge
+         {
+         public:
+            int parent;
+            StringView label;
+
+            bool operator==( const Edge &rhs ) const noexcept;
+         };
+
+      struct EdgeHash
+         {
+         public:
+            size_t operator()( const Edge &edge ) const noexcept;
+         };
+
+      static StringView trailingLabels( StringView host, int numLabels ) noexcept;
+
+      static bool isIPAddress( StringView host ) noexcept;
+
+      [[nodiscard]] int findChild( int parent, StringView label ) const noexcept;
+
+      [[nodiscard]] int countSuffixLabels( StringView host ) const noexcept;
+
+      static constexpr auto _root = 0;
+
+      String _labels;
+      Vector<Node> _nodes;
+      std::unordered_map<Edge, int, EdgeHash> _edges;
+   };
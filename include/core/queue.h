@@ -1,6 +1,6 @@
-#pragma once
-
-#include <queue>
-
-template<typename T>
-using Queue = std::queue<T>;
+#pragma once
+
+#include <queue>
+
+template<typename T>
+using Queue = std::queue<T>;
@@ -1,6 +1,6 @@
-#pragma once
-
-#include <vector>
-
-template<typename T>
-using Vector = std::vector<T>;
+#pragma once
+
+#include <vector>
+
+template<typename T>
+using Vector = std::vector<T>;
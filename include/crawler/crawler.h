@@ -1,110 +1,182 @@
-#pragma once
-
-#include <optional>
-
-#include <thread>
-#include "core/concurrency.h"
-#include "core/exception.h"
-#include "core/file_system.h"
-#include "core/hash_table.h"
-#include "core/io.h"
-#include "core/net.h"
-#include "core/string.h"
-#include "core/vector.h"
-#include "crawler/robots_catalog.h"
-#include "html_parser/html_parser.h"
-
-class Distributed;
-
-/// Represents configuration for the crawler.
-struct CrawlerConfiguration
-   {
-   public:
-      std::optional<std::filesystem::path> logPath; ///< The log path to write to; std::clog if `nullopt`.
-      std::filesystem::path dataDir; ///< The directory to store parsed html data.
-      std::filesystem::path checkpointPath; ///< The checkpoint path to write to.
-      int statsRefreshInterval = 5; ///< The interval in seconds at which the statistics refreshes.
-      int expectedNumUrls = 1'000'000; ///< The expected total number of URLs to crawl.
-      int checkpointInterval = 600; ///< The interval in seconds at which the crawler creates a createCheckpoint.
-   };
-
-/// Retrieves HTML files from the Internet recursively by traversing links within HTML files.
-class Crawler
-   {
-   public:
-      /// Initializes a `Crawler` with the specified seed list and configuration.
-      /// \param seedList The seed list to initialize the frontier.
-      /// \param config The crawler configuration.
-      Crawler( const Vector<Url> &seedList, const CrawlerConfiguration &config );
-
-      /// Initializes a `Crawler` from the specified checkpoint file and configuration.
-      /// \param checkpointFilePath The checkpoint file path.
-      /// \param config The crawler configuration.
-      Crawler( StringView checkpointFilePath, const CrawlerConfiguration &config );
-
-      Crawler( const Crawler & ) = delete;
-      Crawler &operator=( const Crawler & ) = delete;
-      Crawler( Crawler && ) = delete;
-      Crawler &operator=( Crawler && ) = delete;
-
-      ~Crawler( )
-         { if ( _isRunning ) endCrawl( ); }
-
-      /// Begins crawling HTML files using the specified number of worker threads.
-      /// \param numThreads The number of threads to use.
-      void beginCrawl( int numThreads );
-
-      /// Ends crawling HTML files and waits for worker threads to finish.
-      void endCrawl( );
-
-      void insertFrontier( const Url &url );
-
-      void setDistributed( Distributed *distributed );
-
-   private:
-      explicit Crawler( CrawlerConfiguration config );
-
-      void doWork( int threadId, int numThreads );
-
-      [[nodiscard]] static int getUrlScore( const Url &url );
-
-      [[nodiscard]] Vector<Url> getNextUrlBatch( int batchSize, int sampleFactor = 2 );
-
-      [[nodiscard]] HttpResponseMessage getHttpResponse( Url &requestUrl );
-
-      [[nodiscard]] static bool filterLink( const Url &url, const TagInfo &tagInfo );
-
-      void createCheckpoint( ) const;
-
-      static constexpr auto _frontierSizeLimit = 1'000'000;
-      static constexpr auto _filterFalsePositiveRate = 1e-3;
-      static constexpr auto _hostHitRateLimit = 2'048;
-      static constexpr auto _garbageCollectionInterval = 30;
-
-      CrawlerConfiguration _config;
-      UniquePtr<StreamWriter> _logger;
-
-      std::atomic<int> _numCrawledDuringLastInterval = 0;
-      std::atomic<int> _numCrawledTotal = 0;
-
-      ConditionVariable _cv;
-      std::atomic<bool> _isRunning = false;
-      Vector<Thread> _threadPool;
-      Thread _gcThread, _statsThread, _checkpointThread;
-
-      HttpClient _httpClient;
-      HtmlParser _htmlParser;
-
-      HashSet<Url> _frontier;
-      mutable Mutex _frontierMutex;
-
-      BloomFilter<Url> _scheduledUrls;
-      mutable Mutex _scheduledUrlsMutex;
-
-      HashMap<String, int> _hitsCache;
-      mutable Mutex _hitsCacheMutex;
-
-      RobotsCatalog _robotsCatalog;
-
-      Distributed *_distributed;
-   };
+#pragma once
+
+#include <optional>
+
+#include <thread>
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/file_system.h"
+#include "core/hash_table.h"
+#include "core/io.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "crawler/link_filter.h"
+#include "crawler/near_duplicate_index.h"
+#include "crawler/page_sink.h"
+#include "crawler/redirect_catalog.h"
+#include "crawler/robots_catalog.h"
+#include "crawler/trap_detector.h"
+#include "html_parser/html_parser.h"
+#include "storage/link_graph.h"
+#include "storage/page_record.h"
+#include "storage/term_dictionary.h"
+#include "storage/warc_archive.h"
+
+class Distributed;
+
+/// Defines how URLs are grouped by host.
+enum class HostGrouping
+   {
+      Host, ///< URLs are grouped by exact host.
+      RegistrableDomain ///< URLs are grouped by registrable domain, e.g. `a.example.com` and `b.example.com`.
+   };
+
+/// Represents configuration for the crawler.
+struct CrawlerConfiguration
+   {
+   public:
+      std::optional<std::filesystem::path> logPath; ///< The log path to write to; std::clog if `nullopt`.
+      std::filesystem::path dataDir; ///< The directory to store parsed html data.
+      SegmentStoreConfiguration pageStore; ///< The segment sizes and commit batching of the parsed html data.
+      WriteBehindConfiguration pageQueue; ///< The queue that moves page writes off the fetch threads.
+      std::optional<DnsEndPoint> pageStream; ///< The consumer to stream pages to instead of storing them, if any.
+      bool checksumsPages = false; ///< Appends a checksum to each page record, which is verified on reading.
+      /// The dictionary to store the words of pages as term IDs of; stored as strings if `nullopt`.
+      std::optional<std::filesystem::path> termDictionaryPath;
+      std::optional<std::filesystem::path> archiveDir; ///< The raw response archive; not archived if `nullopt`.
+      std::optional<std::filesystem::path> linkGraphDir; ///< The link graph shard of this node; not kept if `nullopt`.
+      std::filesystem::path checkpointPath; ///< The checkpoint path to write to.
+      int statsRefreshInterval = 5; ///< The interval in seconds at which the statistics refreshes.
+      int expectedNumUrls = 1'000'000; ///< The expected total number of URLs to crawl.
+      int checkpointInterval = 600; ///< The interval in seconds at which the crawler creates a createCheckpoint.
+      HostGrouping politenessGrouping = HostGrouping::Host; ///< The grouping that shares a hit rate limit.
+      std::optional<HostGrouping> partitionGrouping; ///< The grouping assigned to one server; by URL if `nullopt`.
+      TrapDetectorConfiguration trapDetector; ///< The thresholds for flagging crawler traps.
+      NearDuplicateIndexConfiguration nearDuplicates; ///< The thresholds for skipping near-duplicate pages.
+      std::optional<std::filesystem::path> linkFilterPath; ///< The link filter rules; the default rules if `nullopt`.
+      std::optional<std::filesystem::path> redirectCatalogPath; ///< The known redirects; not persisted if `nullopt`.
+      ParseMode parseMode = ParseMode::Full; ///< How much of a page is parsed, e.g. only links to feed the frontier.
+      bool recoversMalformedPages = true; ///< Keeps what parses from malformed pages instead of discarding them.
+   };
+
+/// Retrieves HTML files from the Internet recursively by traversing links within HTML files.
+class Crawler
+   {
+   public:
+      /// Initializes a `Crawler` with the specified seed list and configuration.
+      /// \param seedList The seed list to initialize the frontier.
+      /// \param config The crawler configuration.
+      Crawler( const Vector<Url> &seedList, const CrawlerConfiguration &config );
+
+      /// Initializes a `Crawler` from the specified checkpoint file and configuration.
+      /// \param checkpointFilePath The checkpoint file path.
+      /// \param config The crawler configuration.
+      Crawler( StringView checkpointFilePath, const CrawlerConfiguration &config );
+
+      Crawler( const Crawler & ) = delete;
+      Crawler &operator=( const Crawler & ) = delete;
+      Crawler( Crawler && ) = delete;
+      Crawler &operator=( Crawler && ) = delete;
+
+      ~Crawler( )
+         { if ( _isRunning ) endCrawl( ); }
+
+      /// Begins crawling HTML files using the specified number of worker threads.
+      /// \param numThreads The number of threads to use.
+      void beginCrawl( int numThreads );
+
+      /// Ends crawling HTML files and waits for worker threads to finish.
+      void endCrawl( );
+
+      void insertFrontier( const Url &url );
+
+      void setDistributed( Distributed *distributed );
+
+      /// Requests the running crawlers to reload their link filter rules; safe to call from a signal handler.
+      static void requestLinkFilterReload( ) noexcept
+         { _isLinkFilterReloadRequested = true; }
+
+      /// Gets the hash value that decides which server a URL is assigned to.
+      /// \param url The absolute URL.
+      /// \return The hash value of the URL under the configured partition grouping.
+      [[nodiscard]] size_t partitionHash( const Url &url ) const
+         {
+         return _config.partitionGrouping.has_value( ) ?
+                Hash<StringView>( )( groupKey( url, _config.partitionGrouping.value( ) ) ) : Hash<Url>( )( url );
+         }
+
+   private:
+      struct LinkBatch;
+
+      explicit Crawler( CrawlerConfiguration config );
+
+      void doWork( int threadId, int numThreads );
+
+      [[nodiscard]] static StringView groupKey( const Url &url, HostGrouping grouping );
+
+      [[nodiscard]] HostId groupId( const Url &url, HostGrouping grouping );
+
+      [[nodiscard]] static int getUrlScore( const Url &url );
+
+      [[nodiscard]] Vector<Url> getNextUrlBatch( int batchSize, int sampleFactor = 2 );
+
+      [[nodiscard]] HttpResponseMessage getHttpResponse( Url &requestUrl );
+
+      // Judges an absolute link by the current rules.
+      [[nodiscard]] bool filterLink( const Url &url, const TagInfo &tagInfo ) const
+         { return _linkFilter.load( )->isAllowed( url, tagInfo ); }
+
+      void reloadLinkFilter( );
+
+      void createCheckpoint( ) const;
+
+      static constexpr auto _frontierSizeLimit = 1'000'000;
+      static constexpr auto _filterFalsePositiveRate = 1e-3;
+      static constexpr auto _hostHitRateLimit = 2'048;
+      static constexpr auto _garbageCollectionInterval = 30;
+
+      CrawlerConfiguration _config;
+      UniquePtr<StreamWriter> _logger;
+
+      std::atomic<int> _numCrawledDuringLastInterval = 0;
+      std::atomic<int> _numCrawledTotal = 0;
+      std::atomic<int> _numRecoveredPages = 0;
+      std::atomic<int> _numLostPages = 0;
+
+      ConditionVariable _cv;
+      std::atomic<bool> _isRunning = false;
+      Vector<Thread> _threadPool;
+      Thread _gcThread, _statsThread, _checkpointThread;
+
+      HttpClient _httpClient;
+      HtmlParser _htmlParser;
+
+      std::atomic<SharedPtr<const LinkFilter>> _linkFilter;
+      inline static std::atomic<bool> _isLinkFilterReloadRequested = false;
+
+      HashSet<Url> _frontier;
+      mutable Mutex _frontierMutex;
+
+      BloomFilter<Url> _scheduledUrls;
+      mutable Mutex _scheduledUrlsMutex;
+
+      Vector<int> _hitsCache; ///< The number of hits indexed by the ID of the politeness group.
+      HostTable _domainTable; ///< The IDs of the registrable domains, apart from those of the hosts.
+      mutable Mutex _hitsCacheMutex;
+
+      RobotsCatalog _robotsCatalog;
+
+      RedirectCatalog _redirectCatalog;
+
+      TrapDetector _trapDetector;
+
+      NearDuplicateIndex _nearDuplicateIndex;
+
+      UniquePtr<PageSink> _pageSink; ///< The parsed pages, each a `PageRecord` of the request URL and the HTML info.
+      UniquePtr<WarcWriter> _archive; ///< The raw responses, so that pages can be parsed again without refetching.
+      UniquePtr<LinkGraphWriter> _linkGraph; ///< The links of the crawled pages, for ranking without the page records.
+      UniquePtr<TermDictionary> _termDictionary; ///< The terms of the words of the pages, if they are stored as IDs.
+
+      Distributed *_distributed;
+   };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+
+#include "core/exception.h"
+#include "core/hash_table.h"
+#include "core/memory.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "html_parser/html_parser.h"
+
+/// Decides which extracted links are worth crawling from a declarative rule configuration.
+///
+/// The configuration has one rule per line, a directive followed by whitespace-separated values; `#` starts a comment.
+/// - `deny_extension <ext>...` rejects local paths ending with one of the extensions.
+/// - `allow_host <host>...`, `deny_host <host>...` match the exact host.
+/// - `allow_domain <domain>...`, `deny_domain <domain>...` match the domain and all of its subdomains.
+/// - `deny_path <glob>...` rejects local paths matching a glob, where `*` matches any run and `?` any character.
+/// - `allow_language <language>...` rejects links whose `hreflang` or `lang` attribute names none of the languages.
+/// - `deny_language_prefix <prefix>...` rejects hosts whose first label is one of the prefixes, e.g. `de.`.
+///
+/// Once any `allow_host` or `allow_domain` rule exists, hosts matching no allow rule are rejected. A host or domain may
+/// not be both allowed and denied. All matching is case-insensitive. The rules are compiled into perfect hash sets when
+/// the filter is loaded, so evaluation probes a constant number of slots per host label and does not allocate.
+class LinkFilter
+   {
+   public:
+      /// The default rules, which keep HTML pages in English.
+      static const StringView defaultRules;
+
+      /// Compiles a rule configuration.
+      /// \param rules The rule configuration.
+      /// \return The compiled `LinkFilter`.
+      /// \throw FormatException The rule configuration is malformed, or allows and denies the same host or domain.
+      static LinkFilter compile( StringView rules );
+
+      /// Loads and compiles a rule configuration file.
+      /// \param path The rule configuration file path.
+      /// \return The compiled `LinkFilter`.
+      /// \throw IOException The file cannot be opened.
+      /// \throw FormatException The rule configuration is malformed.
+      static LinkFilter load( const std::filesystem::path &path );
+
+      /// Indicates if a link passes the rules, and counts a hit for the rule that rejects it. Does not throw for a
+      /// relative URL, which has no host, but judges it by the rules on its path and tag alone.
+      /// \param url The URL of the link, which should be resolved against the page first.
+      /// \param tagInfo The tag that contains the link.
+      /// \return `true` if the link passes the rules.
+      bool isAllowed( const Url &url, const TagInfo &tagInfo ) const;
+
+      /// Gets the number of rules.
+      /// \return The number of rules, including the implicit rule that rejects hosts missing from the allow lists.
+      [[nodiscard]] int numRules( ) const noexcept
+         { return static_cast<int>(_rules.size( )); }
+
+      /// Gets the number of links rejected by a rule.
+      /// \param rule The index of the rule, in configuration order.
+      /// \return The number of links rejected by the rule.
+      [[nodiscard]] long numHits( int rule ) const noexcept
+         { return _numHits[ rule ].load( std::memory_order_relaxed ); }
+
+      /// Gets the total number of rejected links.
+      /// \return The total number of rejected links.
+      [[nodiscard]] long numRejected( ) const noexcept;
+
+      friend std::ostream &operator<<( std::ostream &stream, const LinkFilter &linkFilter );
+
+   private:
+      enum class RuleType
+         {
+            DenyExtension,
+            AllowHost,
+            DenyHost,
+            AllowDomain,
+            DenyDomain,
+            DenyPath,
+            AllowLanguage,
+            DenyLanguagePrefix,
+            NotAllowed
+         };
+
+      struct Rule
+         {
+         public:
+            RuleType type;
+            String text;
+         };
+
+      LinkFilter( ) = default;
+
+      bool reject( int rule ) const noexcept;
+
+      static bool matchesGlob( StringView string, StringView pattern ) noexcept;
+
+      Vector<Rule> _rules;
+      UniquePtr<std::atomic<long>[]> _numHits;
+
+      PerfectHashSet _extensions, _hosts, _domains, _languagePrefixes;
+      Vector<int> _extensionRules, _hostRules, _domainRules, _languagePrefixRules;
+      Vector<std::pair<String, int>> _pathGlobs;
+      Vector<String> _allowedLanguages;
+      int _allowLanguageRule = -1;
+      int _notAllowedRule = -1;
+   };
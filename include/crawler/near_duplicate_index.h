@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "core/concurrency.h"
+#include "core/hash_table.h"
+#include "core/queue.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Represents thresholds for the near-duplicate index.
+struct NearDuplicateIndexConfiguration
+   {
+   public:
+      int maxDistance = 3; ///< The maximum number of differing fingerprint bits between near-duplicates, up to 15.
+      int minNumWords = 50; ///< The minimum number of words for a page to be indexed; shorter pages are never skipped.
+      int maxBucketSize = 64; ///< The number of fingerprints per band value beyond which the oldest are forgotten.
+      int maxNumBuckets = 1 << 20; ///< The number of band values per band beyond which the oldest are forgotten.
+      bool expandsLinks = false; ///< `true` if the links of near-duplicate pages are still scheduled.
+   };
+
+/// Indexes the SimHash fingerprints of crawled pages to find near-duplicates, i.e. fingerprints that differ in at most
+/// `maxDistance` bits. The fingerprint is split into `maxDistance + 1` bands, so that a near-duplicate matches at least
+/// one band exactly, and each band has its own table and lock.
+class NearDuplicateIndex
+   {
+   public:
+      /// Initializes a `NearDuplicateIndex` with the specified thresholds.
+      /// \param config The thresholds.
+      explicit NearDuplicateIndex( const NearDuplicateIndexConfiguration &config = { } );
+
+      NearDuplicateIndex( const NearDuplicateIndex & ) = delete;
+      NearDuplicateIndex &operator=( const NearDuplicateIndex & ) = delete;
+
+      /// Checks if a near-duplicate of a fingerprint is indexed, and indexes the fingerprint otherwise.
+      /// \param fingerprint The fingerprint of a page.
+      /// \return `true` if a near-duplicate is indexed.
+      bool findOrInsert( uint64_t fingerprint );
+
+      /// Gets the number of fingerprints checked.
+      /// \return The number of fingerprints checked.
+      [[nodiscard]] long numChecked( ) const noexcept
+         { return _numChecked.load( std::memory_order_relaxed ); }
+
+      /// Gets the number of fingerprints that had a near-duplicate.
+      /// \return The number of near-duplicates.
+      [[nodiscard]] long numDuplicates( ) const noexcept
+         { return _numDuplicates.load( std::memory_order_relaxed ); }
+
+      friend std::ostream &operator<<( std::ostream &stream, const NearDuplicateIndex &nearDuplicateIndex );
+
+   private:
+      struct Band
+         {
+         public:
+            int shift = 0; ///< The position of the lowest bit of the band.
+            uint64_t mask = 0; ///< The bits of the band after shifting.
+            HashMap<uint64_t, Vector<uint64_t>> buckets; ///< The fingerprints by band value, oldest first.
+            Queue<uint64_t> insertionOrder; ///< The band values of the buckets, oldest first.
+            Mutex mutex;
+         };
+
+      static constexpr auto _maxNumBands = 16;
+
+      NearDuplicateIndexConfiguration _config;
+
+      std::array<Band, _maxNumBands> _bands;
+      int _numBands;
+
+      std::atomic<long> _numChecked = 0;
+      std::atomic<long> _numDuplicates = 0;
+   };
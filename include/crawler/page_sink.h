@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/net.h"
+#include "core/queue.h"
+#include "core/string.h"
+#include "storage/segment_store.h"
+#include "storage/write_behind_queue.h"
+
+/// Receives the page records of the crawler, so that the pages can be stored or handed to a live consumer.
+class PageSink
+   {
+   public:
+      virtual ~PageSink( ) = default;
+
+      /// Writes a page record. Safe to call from multiple threads, and waits while the sink is backed up.
+      /// \param record The page record.
+      /// \throw SystemException An earlier page record cannot be written.
+      virtual void write( String record ) = 0;
+
+      /// Waits until the page records written so far are durable or delivered.
+      /// \throw SystemException The page records cannot be written.
+      virtual void flush( ) = 0;
+
+      /// Writes the statistics of the sink.
+      friend std::ostream &operator<<( std::ostream &stream, const PageSink &pageSink )
+         {
+         pageSink.writeStatistics( stream );
+         return stream;
+         }
+
+   protected:
+      virtual void writeStatistics( std::ostream &stream ) const = 0;
+   };
+
+/// Appends page records to a segment store through a write-behind queue.
+class SegmentPageSink : public PageSink
+   {
+   public:
+      /// Opens the segment store and starts its writer threads.
+      /// \param directory The directory of the segment store.
+      /// \param storeConfig The configuration of the segment store.
+      /// \param queueConfig The configuration of the write-behind queue.
+      /// \throw SystemException A segment file cannot be opened.
+      SegmentPageSink( const std::filesystem::path &directory, const SegmentStoreConfiguration &storeConfig,
+                       const WriteBehindConfiguration &queueConfig ) :
+            _pageStore( directory, storeConfig ), _pageWriteQueue( _pageStore, queueConfig ),
+            _isCompressed( storeConfig.compression != Compression::None )
+         { }
+
+      void write( String record ) override
+         { _pageWriteQueue.push( std::move( record ) ); }
+
+      void flush( ) override
+         { _pageWriteQueue.flush( ); }
+
+   protected:
+      void writeStatistics( std::ostream &stream ) const override
+         {
+         if ( _isCompressed ) stream << _pageStore << '\t';
+         stream << _pageWriteQueue;
+         }
+
+   private:
+      SegmentWriter _pageStore;
+      WriteBehindQueue _pageWriteQueue;
+      bool _isCompressed;
+   };
+
+/// Represents configuration for streaming page records over a socket.
+struct PageStreamConfiguration
+   {
+   public:
+      size_t maxQueueSize = size_t( 64 ) << 20; ///< The number of queued bytes beyond which writers wait.
+      size_t maxSendSize = size_t( 1 ) << 20; ///< The number of bytes of frames sent at once.
+      int minReconnectDelay = 100; ///< The delay in milliseconds before the first reconnect after a failure.
+      int maxReconnectDelay = 30'000; ///< The delay in milliseconds that doubling reconnect delays stop at.
+      int flushTimeout = 60'000; ///< The time in milliseconds that a flush waits for the records to be sent.
+   };
+
+/// Streams page records to a consumer over a TCP connection, so that the consumer gets the pages as they are crawled
+/// without touching disk.
+///
+/// Each page record is a frame of its length in 4 bytes in network order followed by its bytes, and the end of the
+/// stream is the end of the connection. The consumer grants credits as 4-byte counts in network order, each allowing
+/// that many more frames, and the sink never sends a frame without a credit, so a slow consumer backs up the queue of
+/// the sink instead of its own memory. Records are queued by the writers and sent on a dedicated thread.
+///
+/// When the connection fails, the sender reconnects with exponentially growing delays while the writers keep queueing
+/// records, so a consumer that restarts resumes the stream. The records of the failed send, and those that the old
+/// consumer had not read yet, are lost.
+class SocketPageSink : public PageSink
+   {
+   public:
+      /// Connects to a consumer and starts the sender thread.
+      /// \param host The host name or IP address of the consumer.
+      /// \param port The port of the consumer.
+      /// \param config The configuration of the stream.
+      /// \throw SocketException The consumer cannot be connected initially.
+      SocketPageSink( StringView host, int port, const PageStreamConfiguration &config = { } );
+
+      SocketPageSink( const SocketPageSink & ) = delete;
+      SocketPageSink &operator=( const SocketPageSink & ) = delete;
+
+      /// Sends the queued page records within the flush timeout, ends the stream, and waits a few seconds at most for
+      /// the consumer to close. Records still queued after the timeout are dropped.
+      ~SocketPageSink( ) override;
+
+      /// Queues a page record, waiting while the queue is full, including while the sink reconnects.
+      /// \param record The page record.
+      void write( String record ) override;
+
+      /// Waits until the page records written so far are sent or lost with a failed connection.
+      /// \throw SocketException The records are not sent within the flush timeout.
+      void flush( ) override;
+
+      /// Gets the number of times that the sender waited for credits from the consumer.
+      /// \return The number of waits.
+      [[nodiscard]] long numCreditStalls( ) const noexcept
+         { return _numCreditStalls.load( std::memory_order_relaxed ); }
+
+      /// Gets the number of times that the connection failed and the sender reconnected or tried to.
+      /// \return The number of reconnects.
+      [[nodiscard]] long numReconnects( ) const noexcept
+         { return _numReconnects.load( std::memory_order_relaxed ); }
+
+   protected:
+      void writeStatistics( std::ostream &stream ) const override;
+
+   private:
+      void connect( );
+
+      void sendRecords( );
+
+      void receiveCredits( );
+
+      String _host;
+      int _port;
+      PageStreamConfiguration _config;
+      Socket _socket; ///< Replaced by the sender thread under the mutex when it reconnects.
+      bool _isConnected = false;
+      uint64_t _numCredits = 0;
+
+      Queue<String> _records;
+      size_t _queueSize = 0;
+      uint64_t _numPushed = 0, _numSent = 0;
+      bool _isClosing = false;
+      mutable Mutex _mutex;
+      ConditionVariable _recordPushed, _recordsSent;
+
+      Thread _senderThread;
+      std::atomic<long> _numCreditStalls = 0, _numReconnects = 0;
+   };
+
+/// Receives the page records streamed by a `SocketPageSink`, granting credits as it consumes them.
+class PageStreamReceiver
+   {
+   public:
+      /// Listens for a sink on a port of all network interfaces.
+      /// \param port The port, or 0 for a port chosen by the system.
+      /// \param window The number of frames that may be in flight, i.e. sent but not received yet.
+      /// \throw SocketException The port cannot be listened on.
+      explicit PageStreamReceiver( int port, int window = 256 );
+
+      /// Gets the port listened on.
+      /// \return The port.
+      [[nodiscard]] int port( ) const noexcept
+         { return _port; }
+
+      /// Receives the next page record, accepting the connection of the sink first if it is not accepted yet.
+      /// \param record The string to receive the record into.
+      /// \return `false` if the stream ended.
+      /// \throw SocketException The connection failed.
+      /// \throw FormatException The stream ended in the middle of a frame.
+      bool receive( String &record );
+
+   private:
+      bool receiveAll( char *data, size_t size );
+
+      void grantCredits( uint32_t numCredits );
+
+      Socket _listener;
+      std::optional<Socket> _socket;
+      int _port = 0;
+      int _window;
+      int _numReceivedSinceGrant = 0;
+      bool _isEnded = false;
+   };
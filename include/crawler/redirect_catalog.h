@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+
+#include "core/concurrency.h"
+#include "core/hash_table.h"
+#include "core/net.h"
+#include "core/queue.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Remembers permanent redirects and hosts that always upgrade to HTTPS, so that links can be rewritten before they
+/// cost a round trip.
+class RedirectCatalog
+   {
+   public:
+      /// Initializes a `RedirectCatalog` that remembers up to the specified number of redirects.
+      /// \param capacity The maximum number of redirects; the oldest redirects are forgotten first.
+      explicit RedirectCatalog( size_t capacity = 1'000'000 ) : _capacity( capacity )
+         { }
+
+      RedirectCatalog( const RedirectCatalog & ) = delete;
+      RedirectCatalog &operator=( const RedirectCatalog & ) = delete;
+
+      /// Records a permanent redirect. A redirect that only upgrades the scheme to HTTPS marks the host as HTTPS-only
+      /// instead of being stored.
+      /// \param url The absolute URL that is moved.
+      /// \param redirectedUrl The absolute URL that the URL is moved to.
+      void addRedirect( const Url &url, const Url &redirectedUrl );
+
+      /// Marks a host as HTTPS-only, e.g. after a `Strict-Transport-Security` header.
+      /// \param url An absolute URL on the host.
+      void addHttpsOnlyHost( const Url &url );
+
+      /// Applies a `Strict-Transport-Security` header received over HTTPS (RFC 6797): a positive `max-age` marks the
+      /// host as HTTPS-only, `max-age=0` forgets that it is, and a header without a valid `max-age` is ignored.
+      /// \param url An absolute URL on the host.
+      /// \param header The value of the header.
+      void addStrictTransportSecurity( const Url &url, StringView header );
+
+      /// Rewrites a URL by following the known permanent redirects and upgrading HTTPS-only hosts.
+      /// \param url The absolute URL.
+      /// \return The rewritten URL, which is `url` itself if nothing is known about it.
+      [[nodiscard]] Url rewrite( const Url &url ) const;
+
+      friend std::istream &operator>>( std::istream &stream, RedirectCatalog &redirectCatalog );
+
+      friend std::ostream &operator<<( std::ostream &stream, const RedirectCatalog &redirectCatalog );
+
+      /// Writes the hit-rate metrics.
+      /// \param stream The stream to write to.
+      void writeStatistics( std::ostream &stream ) const;
+
+   private:
+      // Finds the host rather than interning it, since every discovered link is rewritten.
+      [[nodiscard]] bool isHttpsOnly( const Url &url ) const
+         {
+         const auto hostId = HostTable::global( ).find( url.host( ) );
+         return hostId.has_value( ) && hostId.value( ) < _isHttpsOnly.size( ) && _isHttpsOnly[ hostId.value( ) ];
+         }
+
+      static constexpr auto _maxNumHops = 5;
+
+      size_t _capacity;
+      HashMap<Url, Url> _redirects;
+      Queue<Url> _insertionOrder;
+      Vector<bool> _isHttpsOnly; ///< The HTTPS-only flags indexed by `HostId`.
+      mutable SharedMutex _mutex; ///< Held for writing by the setters, and for reading by `rewrite` on every link.
+
+      mutable std::atomic<long> _numLookups = 0, _numRedirectHits = 0, _numHttpsUpgrades = 0;
+   };
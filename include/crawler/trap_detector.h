@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "core/concurrency.h"
+#include "core/hash_table.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Defines the signals that flag a URL as part of a crawler trap.
+enum class TrapSignal
+   {
+      None, ///< The URL does not look like a trap.
+      PathDepth, ///< The local path has too many segments.
+      RepeatingSegments, ///< A path segment repeats too often, e.g. `/a/b/a/b/a/b/`.
+      ParameterExplosion, ///< Many variants share one host and path pattern, e.g. calendars and session IDs, and
+                          ///< their crawled pages are mostly duplicates.
+      HostGrowth ///< The host keeps yielding URLs whose crawled pages are mostly duplicates.
+   };
+
+/// Represents thresholds for the crawler trap detector.
+struct TrapDetectorConfiguration
+   {
+   public:
+      int maxPathDepth = 16; ///< The maximum number of segments in a local path, up to 64.
+      int maxSegmentOccurrences = 2; ///< The maximum number of times one segment may appear in a local path.
+      int maxVariantsPerPattern = 500; ///< The number of distinct URLs per host and path pattern before it is checked.
+      int maxTrackedPatterns = 1'000'000; ///< The number of pattern slots, in which frequent patterns evict rare ones.
+      int minPagesChecked = 50; ///< The number of pages crawled from a host or pattern before its duplicates count.
+      double maxDuplicateRatio = 0.8; ///< The ratio of duplicate pages of a host or pattern beyond which it is a trap.
+      int pageWindow = 1'000; ///< The number of recent pages that the ratio is measured over, older ones counting less.
+      int probeInterval = 100; ///< One in this many URLs of a trap is let through, so that its flag can clear.
+      int expectedNumUrls = 10'000'000; ///< The expected number of discovered URLs, which sizes the URL filter.
+      int expectedNumPages = 1'000'000; ///< The expected number of crawled pages, which sizes the content filter.
+   };
+
+/// Flags URLs that lead into infinite URL spaces before they reach the frontier.
+///
+/// The structural signals flag a URL by its path alone. The other signals flag the URLs of a host, or of a host and
+/// path pattern with many variants, only while the pages crawled from it mostly duplicate each other, so that large
+/// sites with distinct pages, e.g. `/article/<id>`, are never flagged. The duplicate counts are halved every
+/// `pageWindow` pages, and a sample of the flagged URLs is let through, so that a flag clears once the host or pattern
+/// yields new content again.
+class TrapDetector
+   {
+   public:
+      /// Initializes a `TrapDetector` with the specified thresholds.
+      /// \param config The thresholds.
+      explicit TrapDetector( const TrapDetectorConfiguration &config = { } );
+
+      TrapDetector( const TrapDetector & ) = delete;
+      TrapDetector &operator=( const TrapDetector & ) = delete;
+
+      /// Inspects a URL discovered at link extraction time and counts it toward its host and pattern.
+      /// \param url The absolute URL.
+      /// \return The signal that flags the URL as a trap, or `TrapSignal::None`.
+      TrapSignal inspect( const Url &url );
+
+      /// Records the content of a crawled page, which counts as a duplicate if the host already yielded it.
+      /// \param url The URL of the page.
+      /// \param contentHash The hash value of the page content.
+      void recordContent( const Url &url, size_t contentHash );
+
+      /// Records a crawled page that nearly duplicates another crawled page, as found by its SimHash.
+      /// \param url The URL of the page.
+      void recordNearDuplicate( const Url &url );
+
+      /// Gets the number of URLs flagged by a signal.
+      /// \param signal The signal.
+      /// \return The number of URLs flagged by the signal.
+      [[nodiscard]] long numFlagged( TrapSignal signal ) const noexcept
+         { return _numFlagged[ static_cast<int>(signal) ].load( std::memory_order_relaxed ); }
+
+      friend std::ostream &operator<<( std::ostream &stream, const TrapDetector &trapDetector );
+
+   private:
+      // The pages crawled from a host or pattern, with the counts halved every `pageWindow` pages.
+      struct PageCounts
+         {
+         public:
+            int numPages = 0;
+            int numDuplicatePages = 0;
+            int numBlockedUrls = 0; ///< The number of URLs flagged since the last probe.
+         };
+
+      struct PatternState
+         {
+         public:
+            size_t patternHash = 0;
+            int numUrls = 0; ///< The number of distinct URLs discovered, less those of colliding patterns.
+            PageCounts pageCounts;
+         };
+
+      [[nodiscard]] TrapSignal inspectPath( StringView localPath ) const noexcept;
+
+      [[nodiscard]] static size_t getPatternHash( const Url &url );
+
+      void recordPage( const Url &url, size_t contentHash, bool isNearDuplicate );
+
+      [[nodiscard]] bool isTrap( const PageCounts &pageCounts ) const noexcept;
+
+      bool isBlocked( PageCounts &pageCounts ) const noexcept;
+
+      TrapSignal flag( TrapSignal signal ) noexcept;
+
+      static constexpr auto _numSignals = 5;
+      static constexpr auto _maxPathDepth = 64;
+      static constexpr auto _filterFalsePositiveRate = 1e-3;
+
+      TrapDetectorConfiguration _config;
+
+      Vector<PageCounts> _hostStates; ///< The per-host counters indexed by `HostId`.
+      Vector<PatternState> _patternStates; ///< The per-pattern counters, in slots indexed by pattern hash.
+      BloomFilter<size_t> _seenUrls;
+      BloomFilter<size_t> _seenContents;
+      mutable Mutex _mutex;
+
+      std::array<std::atomic<long>, _numSignals> _numFlagged{ };
+   };
@@ -1,114 +1,630 @@
-#pragma once
-
-#include <optional>
-
-#include "core/exception.h"
-#include "core/io.h"
-#include "core/net.h"
-#include "core/string.h"
-#include "core/vector.h"
-
-/// Defines tag types.
-enum class TagType
-   {
-      Opening,
-      Closing,
-      SelfClosing
-   };
-
-/// Represents the parsed information of a tag.
-struct TagInfo
-   {
-   public:
-      TagType type; ///< The type of the tag.
-      String name; ///< The name of the tag.
-
-      /// Parses a tag.
-      /// \param tagString The string representation of the tag.
-      /// \return The parsed information of the tag.
-      /// \throw FormatException The tag is malformed.
-      static TagInfo parse( StringView tagString );
-
-      /// Gets the value of a parameter if it exists.
-      /// \param param The parameter name.
-      /// \return The value of a parameter if it exists.
-      [[nodiscard]] std::optional<String> valueOf( StringView param ) const;
-
-      /// Gets the string representation of the corresponding closing tag.
-      /// \return The string representation of the corresponding closing tag.
-      /// \throw InvalidOperationException The tag is not an opening tag.
-      [[nodiscard]] String getClosingTagString( ) const;
-
-   private:
-      String _params;
-   };
-
-/// Represents the parsed information of a hyperlink.
-struct LinkInfo
-   {
-   public:
-      Url url; ///< The URL of the hyperlink.
-      Vector<String> anchorWords; ///< The anchor words that appear in some HTML files.
-
-      /// Initializes a `Link` with a specified URL.
-      /// \param url The URL of the hyperlink.
-      explicit LinkInfo( Url url ) noexcept: url( std::move( url ) )
-         { }
-
-      /// Initializes a `Link` with a specified URL string.
-      /// \param url The URL string of the hyperlink.
-      explicit LinkInfo( StringView urlString = "" ) noexcept: url( urlString )
-         { }
-
-      friend std::istream &operator>>( std::istream &stream, LinkInfo &linkInfo );
-
-      friend std::ostream &operator<<( std::ostream &stream, const LinkInfo &linkInfo );
-   };
-
-/// Represents the parsed information from an HTML file.
-struct HtmlInfo
-   {
-   public:
-      Vector<String> words; ///< The words that appear in the HTML file, converted to lowercase.
-      Vector<String> titleWords; ///< The words that appear in the HTML tile, converted to lowercase.
-      Vector<LinkInfo> links; ///< The links that appear in the HTML file.
-      std::optional<Url> base; ///< The base URL of the HTML file.
-
-      friend std::istream &operator>>( std::istream &stream, HtmlInfo &htmlInfo );
-
-      friend std::ostream &operator<<( std::ostream &stream, const HtmlInfo &htmlInfo );
-   };
-
-/// Parses information from an HTML file.
-class HtmlParser
-   {
-   public:
-      ///< Checks if a hyperlink will be included in the parsed result.
-      std::function<bool( const Url &, const TagInfo & )> linkFilter = [ ]( const Url &, const TagInfo & )
-         { return true; };
-
-      /// Parses an HTML file.
-      /// \param htmlString The string representation of an HTML file.
-      /// \return The parsed information from the HTML file.
-      /// \throw FormatException The HTML file is malformed.
-      [[nodiscard]] HtmlInfo parse( StringView htmlString ) const;
-
-   private:
-      enum class TagAction
-         {
-            Anchor,
-            Base,
-            Discard,
-            DiscardElement,
-            Embed,
-            Title
-         };
-
-      static Vector<String> tokenize( StringView string );
-
-      static bool preprocessToken( String &token );
-
-      static bool preprocessUrlString( String &urlString );
-
-      static const HashMap<StringView, TagAction> _actionMap;
-   };
+#pragma once
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <span>
+
+#include "core/exception.h"
+#include "core/io.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "html_parser/sim_hash.h"
+#include "html_parser/tokenizer.h"
+
+/// Defines tag types.
+enum class TagType
+   {
+      Opening,
+      Closing,
+      SelfClosing
+   };
+
+/// Represents the parsed information of a tag, whose attributes are views into the string representation of the tag.
+struct TagInfo
+   {
+   public:
+      /// Represents an attribute of a tag.
+      struct Attribute
+         {
+         public:
+            StringView name; ///< The name of the attribute, in its original case.
+            StringView value; ///< The value of the attribute without quotes, or empty if it has none.
+         };
+
+      static constexpr size_t maxNumAttributes = 32; ///< The number of attributes kept; the rest are ignored.
+
+      TagType type; ///< The type of the tag.
+      String name; ///< The name of the tag, converted to lowercase.
+
+      /// Parses a tag and indexes its attributes in one pass.
+      /// \param tagString The string representation of the tag, which must outlive the parsed information.
+      /// \return The parsed information of the tag.
+      /// \throw FormatException The tag is malformed.
+      static TagInfo parse( StringView tagString );
+
+      /// Gets the value of an attribute if it exists. The first of duplicate attributes wins.
+      /// \param attributeName The attribute name in lowercase, which is matched case-insensitively.
+      /// \return The value of the attribute if it exists.
+      [[nodiscard]] std::optional<StringView> valueOf( StringView attributeName ) const noexcept;
+
+      /// Gets the attributes of the tag in order of appearance.
+      /// \return The attributes of the tag.
+      [[nodiscard]] std::span<const Attribute> attributes( ) const noexcept
+         { return { _attributes.data( ), _numAttributes }; }
+
+      /// Gets the string representation of the corresponding closing tag.
+      /// \return The string representation of the corresponding closing tag.
+      /// \throw InvalidOperationException The tag is not an opening tag.
+      [[nodiscard]] String getClosingTagString( ) const;
+
+   private:
+      std::array<Attribute, maxNumAttributes> _attributes;
+      size_t _numAttributes = 0;
+   };
+
+/// Represents the directives of a page to crawlers, from a robots meta tag or an `X-Robots-Tag` header.
+struct RobotsDirectives
+   {
+   public:
+      bool isNoIndex = false; ///< `true` if the page must not be stored.
+      bool isNoFollow = false; ///< `true` if the links of the page must not be followed.
+
+      /// Parses a list of directives separated by commas or whitespace, e.g. `noindex, nofollow`, where `none` means
+      /// both. Other directives are ignored.
+      /// \param directives The list of directives.
+      /// \return The parsed directives.
+      static RobotsDirectives parse( StringView directives ) noexcept;
+
+      /// Parses `X-Robots-Tag` headers, one per line. A header that starts with a user agent and a colon, e.g.
+      /// `otherbot: noindex`, applies only to that user agent.
+      /// \param headers The headers.
+      /// \param userAgent The `User-Agent` of the crawler, whose product name up to a slash or space is matched
+      /// without case.
+      /// \return The directives that apply to the user agent.
+      static RobotsDirectives parseHeaders( StringView headers, StringView userAgent ) noexcept;
+
+      RobotsDirectives &operator|=( const RobotsDirectives &other ) noexcept
+         {
+         isNoIndex |= other.isNoIndex;
+         isNoFollow |= other.isNoFollow;
+         return *this;
+         }
+   };
+
+/// Represents the parsed information of a hyperlink.
+struct LinkInfo
+   {
+   public:
+      Url url; ///< The URL of the hyperlink.
+      Vector<String> anchorWords; ///< The anchor words that appear in some HTML files.
+      bool isNoFollow = false; ///< `true` if the anchor has `rel="nofollow"`, which is not in the text format.
+
+      /// Initializes a `Link` with a specified URL.
+      /// \param url The URL of the hyperlink.
+      explicit LinkInfo( Url url ) noexcept: url( std::move( url ) )
+         { }
+
+      /// Initializes a `Link` with a specified URL string.
+      /// \param url The URL string of the hyperlink.
+      explicit LinkInfo( StringView urlString = "" ) noexcept: url( urlString )
+         { }
+
+      friend std::istream &operator>>( std::istream &stream, LinkInfo &linkInfo );
+
+      friend std::ostream &operator<<( std::ostream &stream, const LinkInfo &linkInfo );
+   };
+
+/// Represents the parsed information from an HTML file.
+struct HtmlInfo
+   {
+   public:
+      Vector<String> words; ///< The words that appear in the HTML file, converted to lowercase.
+      Vector<String> titleWords; ///< The words that appear in the HTML tile, converted to lowercase.
+      Vector<LinkInfo> links; ///< The links that appear in the HTML file.
+      std::optional<Url> base; ///< The base URL of the HTML file.
+      std::optional<Url> canonical; ///< The URL from `<link rel="canonical">`, which is not in the text format.
+      RobotsDirectives robots; ///< The directives of the robots meta tags, which are not in the text format.
+      int numErrors = 0; ///< The number of malformed constructs recovered from, which is not serialized.
+      uint64_t simHash = 0; ///< The SimHash fingerprint of the words, which is not in the text format.
+
+      friend std::istream &operator>>( std::istream &stream, HtmlInfo &htmlInfo );
+
+      friend std::ostream &operator<<( std::ostream &stream, const HtmlInfo &htmlInfo );
+   };
+
+/// Represents the parsed information of a hyperlink whose anchor words are a range of `HtmlInfoView::words`.
+struct LinkInfoView
+   {
+   public:
+      Url url; ///< The URL of the hyperlink.
+      int firstAnchorWord = 0; ///< The index of the first anchor word in `HtmlInfoView::words`.
+      int numAnchorWords = 0; ///< The number of anchor words.
+      bool isNoFollow = false; ///< `true` if the anchor has `rel="nofollow"`.
+
+      /// Initializes a `LinkInfoView` with a specified URL.
+      /// \param url The URL of the hyperlink.
+      /// \param firstAnchorWord The index of the first anchor word in `HtmlInfoView::words`.
+      LinkInfoView( Url url, int firstAnchorWord ) noexcept: url( std::move( url ) ), firstAnchorWord( firstAnchorWord )
+         { }
+   };
+
+/// Represents the parsed information from an HTML file whose words are views into a `PageArena`.
+struct HtmlInfoView
+   {
+   public:
+      Vector<StringView> words; ///< The words that appear in the HTML file, converted to lowercase.
+      Vector<StringView> titleWords; ///< The words that appear in the HTML tile, converted to lowercase.
+      Vector<LinkInfoView> links; ///< The links that appear in the HTML file.
+      std::optional<Url> base; ///< The base URL of the HTML file.
+      std::optional<Url> canonical; ///< The canonical URL from `<link rel="canonical">`.
+      RobotsDirectives robots; ///< The directives of the robots meta tags.
+      int numErrors = 0; ///< The number of malformed constructs recovered from.
+      uint64_t simHash = 0; ///< The SimHash fingerprint of the words, or 0 unless parsed by `ParseMode::Full`.
+
+      /// Gets the anchor words of a link.
+      /// \param linkInfo A link of this `HtmlInfoView`.
+      /// \return The anchor words of the link.
+      [[nodiscard]] std::span<const StringView> anchorWordsOf( const LinkInfoView &linkInfo ) const noexcept
+         { return { words.data( ) + linkInfo.firstAnchorWord, static_cast<size_t>(linkInfo.numAnchorWords) }; }
+
+      /// Copies the parsed information into an `HtmlInfo` that owns its words.
+      /// \return The copied `HtmlInfo`.
+      [[nodiscard]] HtmlInfo toHtmlInfo( ) const;
+
+      /// Writes the parsed information in the same format as `HtmlInfo`.
+      friend std::ostream &operator<<( std::ostream &stream, const HtmlInfoView &htmlInfo );
+
+   private:
+      friend class HtmlParser;
+
+      void clear( ) noexcept;
+   };
+
+/// Holds the memory of parsed pages, i.e. the lowercase copy of the page that words view and the vectors of the
+/// parsed information, so that it is reused across pages instead of allocated per word. Keep one per worker thread.
+class PageArena
+   {
+   public:
+      PageArena( ) = default;
+
+      PageArena( const PageArena & ) = delete;
+      PageArena &operator=( const PageArena & ) = delete;
+
+   private:
+      friend class HtmlParser;
+
+      String _lowercasePage;
+      HtmlInfoView _htmlInfo;
+   };
+
+/// Defines how much of an HTML file is parsed.
+enum class ParseMode
+   {
+      Full, ///< Parses the words, the title words, the links with their anchor words, and the base URL.
+      LinksOnly, ///< Parses the links and the base URL without tokenizing any text.
+      LinksWithAnchorText ///< Parses the links with their anchor words, which are the only words, and the base URL.
+   };
+
+/// Parses information from an HTML file.
+class HtmlParser
+   {
+   public:
+      ///< Checks if a hyperlink will be included in the parsed result.
+      std::function<bool( const Url &, const TagInfo & )> linkFilter = [ ]( const Url &, const TagInfo & )
+         { return true; };
+
+      /// Recovers from malformed constructs instead of throwing, so that everything else in the HTML file is kept: a
+      /// malformed tag is skipped, a `<` without a closing angle bracket is text, and an element without a closing tag
+      /// ends at the end of the HTML file. Each recovery is counted in `numErrors` of the parsed information.
+      bool isRecovering = false;
+
+      /// Parses an HTML file.
+      /// \param htmlString The string representation of an HTML file.
+      /// \param mode How much of the HTML file is parsed.
+      /// \return The parsed information from the HTML file.
+      /// \throw FormatException The HTML file is malformed and the parser is not recovering.
+      [[nodiscard]] HtmlInfo parse( StringView htmlString, ParseMode mode = ParseMode::Full ) const;
+
+      /// Parses an HTML file into the memory of an arena.
+      /// \param htmlString The string representation of an HTML file.
+      /// \param arena The arena that holds the parsed information.
+      /// \param mode How much of the HTML file is parsed.
+      /// \return The parsed information, which stays valid until the arena is used to parse another HTML file.
+      /// \throw FormatException The HTML file is malformed and the parser is not recovering.
+      const HtmlInfoView &parse( StringView htmlString, PageArena &arena, ParseMode mode = ParseMode::Full ) const;
+
+      /// Parses an HTML file into the memory of an arena, and passes each link straight to a policy, e.g. to append it
+      /// to a frontier batch. The policy replaces `linkFilter`, and its calls are inlined into the parse loop.
+      /// \tparam LinkPolicy A type with `bool filterLink( const Url &, const TagInfo & )`, which receives each link as
+      /// written in the page, possibly relative, so a policy resolves it before judging it by its host,
+      /// `void addLink( const Url &, bool isNoFollow )` that receives each link that passes the filter, and
+      /// `static constexpr bool recordsLinks`, which is `true` if the links are also recorded in `HtmlInfoView::links`
+      /// with their anchor words.
+      /// \param htmlString The string representation of an HTML file.
+      /// \param arena The arena that holds the parsed information.
+      /// \param linkPolicy The policy that filters and receives the links.
+      /// \param mode How much of the HTML file is parsed.
+      /// \return The parsed information, which stays valid until the arena is used to parse another HTML file.
+      /// \throw FormatException The HTML file is malformed and the parser is not recovering.
+      template<typename LinkPolicy>
+      const HtmlInfoView &parse( StringView htmlString, PageArena &arena, LinkPolicy &linkPolicy,
+                                 ParseMode mode = ParseMode::Full ) const;
+
+   private:
+      friend class HtmlStreamParser;
+      friend struct RobotsDirectives;
+
+      enum class TagAction
+         {
+            Anchor,
+            Base,
+            Discard,
+            DiscardElement,
+            Embed,
+            Link,
+            Meta,
+            Title
+         };
+
+      /// Represents the state that carries over from one chunk to the next.
+      struct ParseState
+         {
+         public:
+            TagAction element = TagAction::Discard; ///< The element whose closing tag is pending, if not `Discard`.
+            String closingTagString; ///< The closing tag of the element.
+         };
+
+      struct ViewSink;
+      struct OwningSink;
+      template<typename LinkPolicy>
+      struct PolicySink;
+
+      /// Parses a chunk of an HTML file into a sink.
+      /// \tparam mode How much of the chunk is parsed; modes other than `ParseMode::Full` require a final chunk.
+      /// \param htmlString The unparsed bytes.
+      /// \param lowercaseString The unparsed bytes converted to lowercase for `ParseMode::Full`, otherwise a buffer of
+      /// the same size that text is lowercased into when it is needed.
+      /// \param isFinal `true` if no more bytes follow.
+      /// \param state The state carried over from the previous chunk.
+      /// \param sink The sink that collects the parsed information.
+      /// \return The number of bytes parsed; the rest must be passed again with the next chunk.
+      template<ParseMode mode, typename Sink>
+      size_t parseChunk( StringView htmlString, String &lowercaseString, bool isFinal, ParseState &state,
+                         Sink &sink ) const;
+
+      template<typename Sink>
+      const HtmlInfoView &parseInto( StringView htmlString, PageArena &arena, ParseMode mode, Sink &sink ) const;
+
+      static size_t findIgnoreCase( StringView string, StringView lowercasePattern, size_t pos ) noexcept;
+
+      static TagAction getTagAction( StringView tagString ) noexcept;
+
+      static bool hasToken( StringView tokens, StringView lowercaseToken ) noexcept;
+
+      static bool preprocessUrlString( StringView &urlString ) noexcept;
+   };
+
+/// Parses an HTML file incrementally as its chunks arrive. Only the unparsed tail of the received bytes is held, e.g. a
+/// tag or a word cut by the end of a chunk, so parsing overlaps with the download and large pages are never held whole.
+class HtmlStreamParser
+   {
+   public:
+      /// Initializes an `HtmlStreamParser` that parses with the link filter of the specified parser.
+      /// \param htmlParser The parser, which must outlive the `HtmlStreamParser`.
+      explicit HtmlStreamParser( const HtmlParser &htmlParser ) noexcept: _htmlParser( htmlParser )
+         { }
+
+      /// Parses the next chunk of an HTML file.
+      /// \param chunk The next chunk.
+      /// \throw FormatException The HTML file is malformed.
+      void feed( StringView chunk );
+
+      /// Parses the rest of the HTML file once all of its chunks have been fed, and resets the `HtmlStreamParser` for
+      /// the next HTML file.
+      /// \return The parsed information from the HTML file.
+      /// \throw FormatException The HTML file is malformed.
+      HtmlInfo finish( );
+
+      /// Gets the information parsed so far, e.g. to schedule the links found before the HTML file is complete.
+      /// \return The information parsed so far.
+      [[nodiscard]] const HtmlInfo &htmlInfo( ) const noexcept
+         { return _htmlInfo; }
+
+   private:
+      const HtmlParser &_htmlParser;
+      String _buffer, _lowercaseBuffer;
+      HtmlParser::ParseState _state;
+      HtmlInfo _htmlInfo;
+      int _currentLink = -1;
+      SimHash _simHash;
+   };
+
+/// Collects the parsed information as views into the lowercase page. Anchor words are the words tokenized while a
+/// link is open, so they are a range of the words rather than a copy.
+struct HtmlParser::ViewSink
+   {
+   public:
+      HtmlInfoView &htmlInfo;
+      const std::function<bool( const Url &, const TagInfo & )> &linkFilter;
+      int currentLink = -1;
+      SimHash simHash;
+
+      [[nodiscard]] bool filterLink( const Url &url, const TagInfo &tagInfo ) const
+         { return linkFilter( url, tagInfo ); }
+
+      void addWord( StringView word )
+         {
+         htmlInfo.words.emplace_back( word );
+         simHash.add( word );
+         if ( currentLink != -1 ) ++htmlInfo.links[ currentLink ].numAnchorWords;
+         }
+
+      void addTitleWord( StringView word )
+         { htmlInfo.titleWords.emplace_back( word ); }
+
+      void addLink( Url url, bool isAnchor, bool isNoFollow )
+         {
+         if ( isAnchor ) currentLink = static_cast<int>(htmlInfo.links.size( ));
+         htmlInfo.links.emplace_back( std::move( url ), static_cast<int>(htmlInfo.words.size( )) ).isNoFollow =
+               isNoFollow;
+         }
+
+      void closeAnchor( )
+         { currentLink = -1; }
+
+      [[nodiscard]] bool isInAnchor( ) const
+         { return currentLink != -1; }
+
+      [[nodiscard]] bool hasBase( ) const
+         { return htmlInfo.base.has_value( ); }
+
+      void setBase( Url url )
+         { htmlInfo.base.emplace( std::move( url ) ); }
+
+      [[nodiscard]] bool hasCanonical( ) const
+         { return htmlInfo.canonical.has_value( ); }
+
+      void setCanonical( Url url )
+         { htmlInfo.canonical.emplace( std::move( url ) ); }
+
+      void addRobots( const RobotsDirectives &robots )
+         { htmlInfo.robots |= robots; }
+
+      void addError( )
+         { ++htmlInfo.numErrors; }
+   };
+
+/// Passes the links to a policy, and collects the rest as a `ViewSink` does.
+template<typename LinkPolicy>
+struct HtmlParser::PolicySink : ViewSink
+   {
+   public:
+      LinkPolicy &linkPolicy;
+
+      [[nodiscard]] bool filterLink( const Url &url, const TagInfo &tagInfo ) const
+         { return linkPolicy.filterLink( url, tagInfo ); }
+
+      void addLink( Url url, bool isAnchor, bool isNoFollow )
+         {
+         linkPolicy.addLink( url, isNoFollow );
+         if constexpr ( LinkPolicy::recordsLinks ) ViewSink::addLink( std::move( url ), isAnchor, isNoFollow );
+         }
+   };
+
+template<ParseMode mode, typename Sink>
+size_t HtmlParser::parseChunk( StringView htmlString, String &lowercaseString, bool isFinal, ParseState &state,
+                               Sink &sink ) const
+   {
+   auto *lowercaseBegin = lowercaseString.data( );
+   const auto size = htmlString.size( );
+
+   // Drops a link that the filter cannot judge, e.g. a relative URL given to a filter that needs a host.
+   const auto filterLink = [ & ]( const Url &url, const TagInfo &tagInfo )
+      {
+      try
+         { return sink.filterLink( url, tagInfo ); }
+      catch ( ... )
+         { return false; }
+      };
+
+   // Finds the end of the complete words from a position, i.e. the last delimiter, unless the chunk is final, so
+   // that a word cut by the end of the chunk waits for the next chunk.
+   const auto findTextEnd = [ & ]( size_t pos )
+      {
+      if ( isFinal ) return size;
+      for ( auto endPos = size; endPos > pos; --endPos )
+         if ( HtmlTokenizer::isDelimiter( lowercaseString[ endPos - 1 ] ) ) return endPos - 1;
+      return pos;
+      };
+
+   // Parses the content of the element that is open, and returns the position to continue from.
+   const auto parseElement = [ & ]( size_t pos )
+      {
+      const auto &closingTagString = state.closingTagString;
+      const auto endPos = mode == ParseMode::Full ? lowercaseString.find( closingTagString, pos ) :
+                          findIgnoreCase( htmlString, closingTagString, pos );
+      const auto textEnd = endPos != StringView::npos ? endPos : findTextEnd( pos );
+      if ( endPos == StringView::npos && isFinal )
+         {
+         if ( !isRecovering ) throw FormatException( "A closing tag is missing" );
+         sink.addError( );
+         }
+
+      if ( mode == ParseMode::Full && state.element == TagAction::Title ) // Tokenizes the text in the title element.
+         for ( const char *text = lowercaseBegin + pos, *end = lowercaseBegin + textEnd; text < end; ++text )
+            text = HtmlTokenizer::tokenize( text, end, [ & ]( StringView word )
+               { sink.addTitleWord( word ); } );
+
+      if ( endPos != StringView::npos )
+         {
+         state.element = TagAction::Discard;
+         return endPos + closingTagString.size( );
+         }
+      if ( isFinal ) // Ends the element at the end of the HTML file.
+         {
+         state.element = TagAction::Discard;
+         return size;
+         }
+      // Keeps only the bytes that can begin the closing tag.
+      return state.element == TagAction::Title ? textEnd :
+             std::max( pos, size - std::min( size, closingTagString.size( ) - 1 ) );
+      };
+
+   const auto parseUrl = [ & ]( const TagInfo &tagInfo, StringView param ) -> std::optional<Url>
+      {
+      if ( auto urlString = tagInfo.valueOf( param );
+            urlString.has_value( ) && preprocessUrlString( urlString.value( ) ) )
+         try
+            { return Url( urlString.value( ) ); }
+         catch ( ... )
+            { }
+      return std::nullopt;
+      };
+
+   // Becomes `false` once a `<` without a closing angle bracket is recovered from, since no tag can follow it.
+   auto hasTags = true;
+
+   for ( size_t pos = 0;; )
+      {
+      // Advances the view past the element that is open.
+      if ( state.element != TagAction::Discard )
+         {
+         pos = parseElement( pos );
+         if ( state.element != TagAction::Discard ) return pos;
+         }
+
+      // Tokenizes the text before a tag and focuses the view on the tag.
+      size_t beginPos;
+      if constexpr ( mode == ParseMode::Full )
+         {
+         const auto textEnd = findTextEnd( pos );
+         beginPos = HtmlTokenizer::tokenize( lowercaseBegin + pos, lowercaseBegin + textEnd, [ & ]( StringView word )
+            { sink.addWord( word ); } ) - lowercaseBegin;
+         if ( beginPos == textEnd && ( textEnd == size || lowercaseString[ textEnd ] != '<' ) ) return textEnd;
+         }
+      else // Skips the text, except anchor text to keep, which is lowercased only when it is needed.
+         {
+         beginPos = std::min( htmlString.find( '<', pos ), size );
+         if ( mode == ParseMode::LinksWithAnchorText && sink.isInAnchor( ) )
+            {
+            HtmlTokenizer::copyToLower( htmlString.substr( pos, beginPos - pos ), lowercaseBegin + pos );
+            HtmlTokenizer::tokenize( lowercaseBegin + pos, lowercaseBegin + beginPos, [ & ]( StringView word )
+               { sink.addWord( word ); } );
+            }
+         if ( beginPos == size ) return size;
+         }
+      auto endPos = hasTags ? htmlString.find( '>', beginPos ) : StringView::npos;
+      if ( endPos == StringView::npos )
+         {
+         if ( !isFinal ) return beginPos;
+         if ( !isRecovering ) throw FormatException( "A closing angle bracket is missing." );
+         if ( hasTags ) sink.addError( ), hasTags = false;
+         pos = beginPos + 1; // Resynchronizes by treating the `<` as text.
+         continue;
+         }
+      pos = ++endPos;
+
+      // Dispatches on the raw tag name, so that the tags to discard are never parsed.
+      const auto tagString = htmlString.substr( beginPos, endPos - beginPos );
+      const auto tagAction = getTagAction( tagString );
+      if ( tagAction == TagAction::Discard ) continue;
+
+      // Parses the tag, or skips it if it is malformed and the parser is recovering.
+      TagInfo tagInfo;
+      try
+         { tagInfo = TagInfo::parse( tagString ); }
+      catch ( const FormatException & )
+         {
+         if ( !isRecovering ) throw;
+         sink.addError( );
+         continue;
+         }
+      if ( tagInfo.type == TagType::Closing )
+         {
+         if ( tagAction == TagAction::Anchor ) // Stops adding anchor words to the current link.
+            sink.closeAnchor( );
+         continue;
+         }
+      const auto isOpening = tagInfo.type == TagType::Opening;
+      switch ( tagAction )
+         {
+         case TagAction::Anchor: // Parses the link in the anchor tag, which is not to be followed if `rel="nofollow"`.
+            if ( !isOpening ) break;
+            if ( auto url = parseUrl( tagInfo, "href" ); url.has_value( ) && filterLink( url.value( ), tagInfo ) )
+               {
+               const auto rel = tagInfo.valueOf( "rel" );
+               const auto isNoFollow = rel.has_value( ) && hasToken( rel.value( ), "nofollow" );
+               sink.addLink( std::move( url.value( ) ), true, isNoFollow );
+               }
+            break;
+         case TagAction::Base: // Parses the base URL.
+            if ( !sink.hasBase( ) )
+               if ( auto url = parseUrl( tagInfo, "href" ); url.has_value( ) )
+                  sink.setBase( std::move( url.value( ) ) );
+            break;
+         case TagAction::Discard:
+            break;
+         case TagAction::DiscardElement: // Advances the view past the element.
+         case TagAction::Title: // Tokenizes the text in the title element, if parsed, and advances the view past it.
+            if ( !isOpening ) break;
+            state.element = tagAction;
+            state.closingTagString = tagInfo.getClosingTagString( );
+            break;
+         case TagAction::Embed: // Parses the link in the embed tag.
+            if ( !isOpening ) break;
+            if ( auto url = parseUrl( tagInfo, "src" ); url.has_value( ) && filterLink( url.value( ), tagInfo ) )
+               sink.addLink( std::move( url.value( ) ), false, false );
+            break;
+         case TagAction::Link: // Parses the canonical URL.
+            if ( const auto rel = tagInfo.valueOf( "rel" );
+                  !sink.hasCanonical( ) && rel.has_value( ) && hasToken( rel.value( ), "canonical" ) )
+               if ( auto url = parseUrl( tagInfo, "href" ); url.has_value( ) )
+                  sink.setCanonical( std::move( url.value( ) ) );
+            break;
+         case TagAction::Meta: // Parses the directives of a robots meta tag.
+            if ( const auto name = tagInfo.valueOf( "name" ); name.has_value( ) && hasToken( name.value( ), "robots" ) )
+               if ( const auto content = tagInfo.valueOf( "content" ); content.has_value( ) )
+                  sink.addRobots( RobotsDirectives::parse( content.value( ) ) );
+            break;
+         }
+      }
+   }
+
+template<typename Sink>
+const HtmlInfoView &HtmlParser::parseInto( StringView htmlString, PageArena &arena, ParseMode mode, Sink &sink ) const
+   {
+   auto &htmlInfo = arena._htmlInfo;
+   htmlInfo.clear( );
+
+   // Text is tokenized from a lowercase copy at the same offsets, while tags are parsed from the original bytes so
+   // that URLs keep their case.
+   auto &lowercaseString = arena._lowercasePage;
+   ParseState state;
+   switch ( mode )
+      {
+      case ParseMode::Full:
+         lowercaseString.resize( htmlString.size( ) );
+         HtmlTokenizer::copyToLower( htmlString, lowercaseString.data( ) );
+         parseChunk<ParseMode::Full>( htmlString, lowercaseString, true, state, sink );
+         break;
+      case ParseMode::LinksOnly:
+         parseChunk<ParseMode::LinksOnly>( htmlString, lowercaseString, true, state, sink );
+         break;
+      case ParseMode::LinksWithAnchorText:
+         lowercaseString.resize( htmlString.size( ) );
+         parseChunk<ParseMode::LinksWithAnchorText>( htmlString, lowercaseString, true, state, sink );
+         break;
+      }
+   if ( mode == ParseMode::Full ) htmlInfo.simHash = sink.simHash.fingerprint( );
+   return htmlInfo;
+   }
+
+template<typename LinkPolicy>
+const HtmlInfoView &HtmlParser::parse( StringView htmlString, PageArena &arena, LinkPolicy &linkPolicy,
+                                       ParseMode mode ) const
+   {
+   PolicySink<LinkPolicy> sink{ { arena._htmlInfo, linkFilter, -1, { } }, linkPolicy };
+   return parseInto( htmlString, arena, mode, sink );
+   }
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "core/string.h"
+
+/// Accumulates the SimHash fingerprint of a stream of words, so that pages with mostly the same words, e.g. mirrors and
+/// printer-friendly versions, get fingerprints that differ in few bits.
+///
+/// Each word votes on every bit of the fingerprint by the bits of its hash value, and repeated words vote repeatedly.
+/// The votes are counted in the bytes of eight words at once, i.e. bits `group`, `group + 8`, ... of the hash value in
+/// the bytes of `_pendingCounts[ group ]`, and moved to wider counters before a byte can overflow.
+class SimHash
+   {
+   public:
+      /// Adds a word to the fingerprint.
+      /// \param word The word.
+      void add( StringView word ) noexcept
+         {
+         const auto hashValue = hash( word );
+         for ( auto group = 0; group < _numGroups; ++group )
+            _pendingCounts[ group ] += hashValue >> group & _lowBytes;
+         ++_numWords;
+         if ( ++_numPendingWords == _maxNumPendingWords ) flush( );
+         }
+
+      /// Gets the fingerprint of the words added so far.
+      /// \return The fingerprint, where a bit is set if most words set it, or 0 if no words have been added.
+      [[nodiscard]] uint64_t fingerprint( ) const noexcept
+         {
+         uint64_t fingerprint = 0;
+         for ( auto bit = 0; bit < _numBits; ++bit )
+            {
+            const auto numOnes = _counts[ bit ] + static_cast<int>(_pendingCounts[ bit % _numGroups ] >>
+                                                                    bit / _numGroups * 8 & 0xff);
+            fingerprint |= static_cast<uint64_t>(numOnes * 2 > _numWords) << bit;
+            }
+         return fingerprint;
+         }
+
+      /// Gets the number of words added so far.
+      /// \return The number of words.
+      [[nodiscard]] int numWords( ) const noexcept
+         { return _numWords; }
+
+      /// Removes all the words.
+      void clear( ) noexcept
+         {
+         _counts = { }, _pendingCounts = { };
+         _numWords = _numPendingWords = 0;
+         }
+
+      /// Gets the number of bits that differ between two fingerprints.
+      /// \param lhs A fingerprint.
+      /// \param rhs The other fingerprint.
+      /// \return The Hamming distance between the fingerprints.
+      [[nodiscard]] static int distance( uint64_t lhs, uint64_t rhs ) noexcept
+         { return std::popcount( lhs ^ rhs ); }
+
+   private:
+      static constexpr auto _numBits = 64;
+      static constexpr auto _numGroups = 8;
+      static constexpr auto _maxNumPendingWords = 255;
+      static constexpr auto _lowBytes = 0x0101010101010101ull;
+
+      static uint64_t hash( StringView word ) noexcept
+         {
+         // FNV-1a, and then the SplitMix64 finalizer, which spreads short words over the high bits.
+         auto hashValue = 14695981039346656037ull;
+         for ( const auto c : word ) hashValue = ( hashValue ^ static_cast<unsigned char>(c) ) * 1099511628211ull;
+         hashValue = ( hashValue ^ ( hashValue >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+         hashValue = ( hashValue ^ ( hashValue >> 27 ) ) * 0x94d049bb133111ebull;
+         return hashValue ^ ( hashValue >> 31 );
+         }
+
+      void flush( ) noexcept
+         {
+         for ( auto bit = 0; bit < _numBits; ++bit )
+            _counts[ bit ] += static_cast<int>(_pendingCounts[ bit % _numGroups ] >> bit / _numGroups * 8 & 0xff);
+         _pendingCounts = { };
+         _numPendingWords = 0;
+         }
+
+      std::array<int, _numBits> _counts{ }; ///< The number of words that set each bit, up to the last flush.
+      std::array<uint64_t, _numGroups> _pendingCounts{ };
+      int _numWords = 0, _numPendingWords = 0;
+   };
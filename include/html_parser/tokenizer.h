@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+#include "core/string.h"
+
+/// Splits HTML text into words in a single pass, classifying 16 bytes at a time with SSE2 where it is available.
+///
+/// A word is a whitespace-separated run trimmed to its first and last alphanumeric characters, so `"(Hello,"` yields
+/// `hello` while `don't` stays whole. Text ends at the next `<`, which begins a tag.
+class HtmlTokenizer
+   {
+   public:
+      /// Copies a string and converts its ASCII letters to lowercase, leaving all other bytes and offsets unchanged.
+      /// \param string The string to copy.
+      /// \param output The buffer to write to, which holds at least `string.size( )` characters.
+      static void copyToLower( StringView string, char *output ) noexcept
+         {
+         const auto *input = string.data( );
+         const auto size = string.size( );
+         size_t i = 0;
+#if defined( __SSE2__ )
+         const auto upperA = _mm_set1_epi8( 'A' ), numLetters = _mm_set1_epi8( 'Z' - 'A' ),
+               caseBit = _mm_set1_epi8( 'a' - 'A' );
+         for ( ; i + _blockSize <= size; i += _blockSize )
+            {
+            const auto block = _mm_loadu_si128( reinterpret_cast<const __m128i *>(input + i) );
+            const auto offset = _mm_sub_epi8( block, upperA );
+            const auto isUpper = _mm_cmpeq_epi8( _mm_min_epu8( offset, numLetters ), offset );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(output + i),
+                              _mm_add_epi8( block, _mm_and_si128( isUpper, caseBit ) ) );
+            }
+#endif
+         for ( ; i < size; ++i )
+            output[ i ] = isUpperAscii( input[ i ] ) ? static_cast<char>(input[ i ] + ( 'a' - 'A' )) : input[ i ];
+         }
+
+      /// Tokenizes text up to the next tag.
+      /// \param begin The beginning of the text.
+      /// \param end The end of the text.
+      /// \param emit The function called with a view of each word, in order.
+      /// \return The position of the `<` that ends the text, or `end`.
+      template<typename Emit>
+      static const char *tokenize( const char *begin, const char *end, Emit &&emit )
+         {
+         const char *wordBegin = nullptr;
+         for ( auto *block = begin; block < end; block += _blockSize )
+            {
+            const auto size = std::min<size_t>( end - block, _blockSize );
+            auto [ isSpace, isTag ] = classify( block, size );
+            const auto isValid = size == _blockSize ? 0xffffu : ( 1u << size ) - 1;
+            auto remaining = isValid;
+
+            while ( true )
+               {
+               if ( wordBegin == nullptr )
+                  {
+                  // Skips whitespace to the beginning of the next word, unless a tag comes first.
+                  const auto isWord = ~isSpace & remaining;
+                  if ( isWord == 0 ) break;
+                  const auto pos = std::countr_zero( isWord );
+                  if ( isTag >> pos & 1 ) return block + pos;
+                  wordBegin = block + pos;
+                  remaining &= ~0u << pos;
+                  }
+               else
+                  {
+                  // Scans to the end of the current word.
+                  const auto isDelimiter = ( isSpace | isTag ) & remaining;
+                  if ( isDelimiter == 0 ) break;
+                  const auto pos = std::countr_zero( isDelimiter );
+                  emitWord( wordBegin, block + pos, emit );
+                  wordBegin = nullptr;
+                  remaining &= ~0u << pos;
+                  }
+               }
+            }
+         if ( wordBegin != nullptr ) emitWord( wordBegin, end, emit );
+         return end;
+         }
+
+      /// Indicates if a character ends a word, i.e. it is whitespace or begins a tag.
+      /// \param c The character.
+      /// \return `true` if the character ends a word.
+      static bool isDelimiter( char c ) noexcept
+         { return isSpaceAscii( c ) || c == '<'; }
+
+   private:
+      struct Masks
+         {
+         public:
+            uint32_t isSpace; ///< The bit of each whitespace byte.
+            uint32_t isTag; ///< The bit of each `<` byte.
+         };
+
+      static constexpr size_t _blockSize = 16;
+
+      static bool isUpperAscii( char c ) noexcept
+         { return c >= 'A' && c <= 'Z'; }
+
+      static bool isAlnumAscii( char c ) noexcept
+         { return ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ); }
+
+      static bool isSpaceAscii( char c ) noexcept
+         { return c == ' ' || ( c >= '\t' && c <= '\r' ); }
+
+      static Masks classify( const char *block, size_t size ) noexcept
+         {
+#if defined( __SSE2__ )
+         if ( size == _blockSize )
+            {
+            const auto bytes = _mm_loadu_si128( reinterpret_cast<const __m128i *>(block) );
+            const auto offset = _mm_sub_epi8( bytes, _mm_set1_epi8( '\t' ) );
+            const auto isControlSpace = _mm_cmpeq_epi8( _mm_min_epu8( offset, _mm_set1_epi8( '\r' - '\t' ) ), offset );
+            const auto isSpace = _mm_or_si128( isControlSpace, _mm_cmpeq_epi8( bytes, _mm_set1_epi8( ' ' ) ) );
+            return { static_cast<uint32_t>(_mm_movemask_epi8( isSpace )),
+                     static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi8( bytes, _mm_set1_epi8( '<' ) ) )) };
+            }
+#endif
+         Masks masks{ 0, 0 };
+         for ( size_t i = 0; i < size; ++i )
+            {
+            masks.isSpace |= static_cast<uint32_t>(isSpaceAscii( block[ i ] )) << i;
+            masks.isTag |= static_cast<uint32_t>(block[ i ] == '<') << i;
+            }
+         return masks;
+         }
+
+      template<typename Emit>
+      static void emitWord( const char *begin, const char *end, Emit &emit )
+         {
+         while ( begin != end && !isAlnumAscii( *begin ) ) ++begin;
+         while ( begin != end && !isAlnumAscii( *( end - 1 ) ) ) --end;
+         if ( begin != end ) emit( StringView( begin, end - begin ) );
+         }
+   };
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "core/exception.h"
+#include "core/hash_table.h"
+#include "core/memory.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "storage/segment_store.h"
+#include "storage/term_dictionary.h"
+
+/// Represents configuration for an inverted index writer.
+struct IndexWriterConfiguration
+   {
+   public:
+      size_t maxMemorySize = size_t( 256 ) << 20; ///< The size in bytes of postings beyond which they become a run.
+   };
+
+/// A document that a term occurs in, with the positions of the term in each field of the document.
+struct Posting
+   {
+   public:
+      DocId docId = 0; ///< The ID of the document.
+      Vector<uint32_t> bodyPositions; ///< The positions of the term in the words of the body, in ascending order.
+      Vector<uint32_t> titlePositions; ///< The positions of the term in the title words, in ascending order.
+
+      friend bool operator==( const Posting &lhs, const Posting &rhs ) = default;
+   };
+
+/// Builds an inverted index of the words and title words of documents incrementally, as immutable segments.
+///
+/// The postings of the documents added since the last commit are kept in memory, already compressed, and are flushed
+/// as a sorted run `run-n.tmp` whenever they reach the memory budget. A commit merges the runs into the next segment,
+/// `segment-n.terms` and `segment-n.postings`, and deletes them. The terms file starts with the first and the end
+/// document ID of the segment as 8-byte integers, and then lists the terms in byte order, each as its varint length
+/// and bytes, its varint number of documents and the varint size of its posting list. The posting lists follow each
+/// other in the postings file, in the same order. Each posting is the varint gap of its document ID from the previous
+/// posting, or from 0, followed by the varint number of positions in the body and their varint gaps, and the same for
+/// the title. Both files are synced before they are renamed into place, the terms file last, so that a segment exists
+/// only once it is durable and complete.
+///
+/// The postings in memory are keyed by the ID of their term in a `TermDictionary` of the writer, which keeps the terms
+/// for its lifetime, so that adding a document neither allocates nor hashes a string per known term. Documents whose
+/// words are stored as IDs of another dictionary map those IDs to the IDs of the writer through an array instead.
+class IndexWriter
+   {
+   public:
+      /// Opens an index for adding documents after those of its segments, creating the directory if it does not
+      /// exist, and deletes the runs of an uncommitted earlier writer.
+      /// \param directory The directory of the index.
+      /// \param config The configuration of the writer.
+      /// \param termDictionary The dictionary of the term IDs that documents can be added with, which must outlive the
+      /// writer, or `nullptr` to add documents by their words only.
+      /// \throw IOException The last segment cannot be read.
+      /// \throw FormatException The last segment is malformed.
+      explicit IndexWriter( std::filesystem::path directory, const IndexWriterConfiguration &config = { },
+                            const TermDictionary *termDictionary = nullptr );
+
+      IndexWriter( const IndexWriter & ) = delete;
+      IndexWriter &operator=( const IndexWriter & ) = delete;
+
+      /// Commits the documents added since the last commit.
+      ~IndexWriter( );
+
+      /// Adds the postings of a document. Not safe to call from multiple threads.
+      /// \param docId The ID of the document, which is at least `nextDocId( )`.
+      /// \param words The words of the body of the document.
+      /// \param titleWords The title words of the document.
+      /// \throw ArgumentException The document ID is less than `nextDocId( )`.
+      /// \throw IOException A run cannot be written.
+      void add( DocId docId, std::span<const StringView> words, std::span<const StringView> titleWords );
+
+      /// Adds the postings of a document whose words are IDs of the term dictionary of the writer. Not safe to call
+      /// from multiple threads.
+      /// \param docId The ID of the document, which is at least `nextDocId( )`.
+      /// \param wordIds The term IDs of the words of the body of the document.
+      /// \param titleWordIds The term IDs of the title words of the document.
+      /// \throw InvalidOperationException The writer has no term dictionary.
+      /// \throw ArgumentException The document ID is less than `nextDocId( )`, or a term ID is not in the dictionary.
+      /// \throw IOException A run cannot be written.
+      void add( DocId docId, std::span<const TermId> wordIds, std::span<const TermId> titleWordIds );
+
+      /// Merges the runs and the postings in memory into a new segment. Does nothing if no document was added.
+      /// \throw IOException A run cannot be read, or the segment cannot be written.
+      /// \throw SystemException The segment cannot be synced to disk.
+      /// \throw FormatException A run is malformed.
+      void commit( );
+
+      /// Gets the lowest document ID that can be added, i.e. the ID after the last document added.
+      /// \return The document ID.
+      [[nodiscard]] DocId nextDocId( ) const noexcept
+         { return _nextDocId; }
+
+      /// Gets the number of runs flushed since the last commit.
+      /// \return The number of runs.
+      [[nodiscard]] int numRuns( ) const noexcept
+         { return _numRuns; }
+
+      /// Gets the number of segments committed.
+      /// \return The number of segments.
+      [[nodiscard]] int numSegments( ) const noexcept
+         { return _numSegments; }
+
+   private:
+      friend class IndexReader;
+
+      struct PostingList
+         {
+         public:
+            String data;
+            uint64_t numDocs = 0;
+            DocId lastDocId = 0;
+         };
+
+      // A term that occurs in the document being added.
+      struct Occurrence
+         {
+         public:
+            TermId termId;
+            int field;
+            uint32_t position;
+
+            friend auto operator<=>( const Occurrence &lhs, const Occurrence &rhs ) = default;
+         };
+
+      static constexpr size_t _termOverhead = 64; ///< The estimated memory of a posting list besides its data.
+      static constexpr size_t _headerSize = 16;
+      static constexpr auto _noTermId = TermId( -1 );
+
+      static std::filesystem::path runPath( const std::filesystem::path &directory, int run );
+
+      static std::filesystem::path termsPath( const std::filesystem::path &directory, int segment );
+
+      static std::filesystem::path postingsPath( const std::filesystem::path &directory, int segment );
+
+      void addTermIds( DocId docId, std::span<const TermId> wordIds, std::span<const TermId> titleWordIds );
+
+      void flushRun( );
+
+      std::filesystem::path _directory;
+      IndexWriterConfiguration _config;
+
+      TermDictionary _terms; ///< The terms of the postings, which key them by ID.
+      const TermDictionary *_termDictionary; ///< The dictionary of the term IDs that documents are added with.
+      Vector<TermId> _termIds; ///< The IDs in `_terms` by ID in `_termDictionary`, or `_noTermId` if not known yet.
+      Vector<TermId> _wordIds, _titleWordIds;
+
+      HashMap<TermId, PostingList> _postingLists;
+      size_t _memorySize = 0;
+      Vector<Occurrence> _occurrences;
+
+      int _numRuns = 0, _numSegments = 0;
+      DocId _firstDocId = 0; ///< The first document ID of the next segment.
+      DocId _nextDocId = 0;
+   };
+
+/// Reads the postings of the terms of an inverted index across its segments.
+class IndexReader
+   {
+   public:
+      /// Loads the segments of an index.
+      /// \param directory The directory of the index.
+      /// \throw IOException A segment cannot be read.
+      /// \throw FormatException A terms file is malformed.
+      explicit IndexReader( const std::filesystem::path &directory );
+
+      /// Gets the number of segments.
+      /// \return The number of segments.
+      [[nodiscard]] int numSegments( ) const noexcept
+         { return static_cast<int>(_segments.size( )); }
+
+      /// Gets the document ID after the last document of the index.
+      /// \return The document ID.
+      [[nodiscard]] DocId endDocId( ) const noexcept
+         { return _segments.empty( ) ? 0 : _segments.back( ).endDocId; }
+
+      /// Gets the number of postings, i.e. of distinct terms of each document, in all segments.
+      /// \return The number of postings.
+      [[nodiscard]] uint64_t numPostings( ) const noexcept;
+
+      /// Gets the size in bytes of the posting lists of all segments.
+      /// \return The size in bytes.
+      [[nodiscard]] uint64_t numBytes( ) const noexcept;
+
+      /// Decodes the postings of a term from all segments.
+      /// \param term The term.
+      /// \param postings The postings in ascending order of document ID, replacing its contents.
+      /// \throw FormatException A posting list is malformed.
+      void postings( StringView term, Vector<Posting> &postings ) const;
+
+   private:
+      struct TermEntry
+         {
+         public:
+            StringView term;
+            uint64_t numDocs;
+            uint64_t offset;
+            uint64_t size;
+         };
+
+      struct Segment
+         {
+         public:
+            DocId firstDocId = 0, endDocId = 0;
+            String terms, postings;
+            Vector<TermEntry> termEntries;
+         };
+
+      Vector<Segment> _segments;
+   };
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "core/exception.h"
+#include "core/string.h"
+
+/// Defines the codecs of compressed blocks.
+enum class Compression : uint8_t
+   {
+      None, ///< The block is stored as is.
+      Zlib, ///< The block is a zlib stream.
+      Zstd ///< The block is a Zstandard frame, if built with zstd.
+   };
+
+/// Compresses and decompresses blocks as a whole, so that each block can be decompressed on its own.
+class BlockCodec
+   {
+   public:
+      BlockCodec( ) = delete;
+
+      /// Checks if a codec is available in this build.
+      /// \param compression The codec.
+      /// \return `true` if the codec is available.
+      [[nodiscard]] static bool isAvailable( Compression compression ) noexcept;
+
+      /// Compresses a block.
+      /// \param compression The codec, which must be available.
+      /// \param level The compression level of the codec, or 0 for its default level.
+      /// \param block The block.
+      /// \param compressedBlock The string to replace with the compressed block.
+      /// \throw ArgumentException The codec is not available.
+      static void compress( Compression compression, int level, StringView block, String &compressedBlock );
+
+      /// Decompresses a block.
+      /// \param compression The codec of the compressed block.
+      /// \param compressedBlock The compressed block.
+      /// \param block The memory to decompress into, whose size is the size of the block.
+      /// \throw ArgumentException The codec is not available.
+      /// \throw FormatException The compressed block is corrupt, or its size does not match.
+      static void decompress( Compression compression, StringView compressedBlock, std::span<char> block );
+   };
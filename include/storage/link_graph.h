@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/hash_table.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Identifies a URL of a merged `LinkGraph` by the rank of its fingerprint, starting at 0.
+using UrlId = uint32_t;
+
+/// Writes the links of crawled pages as a shard of a link graph, which `LinkGraph::merge` merges with the shards of
+/// other crawler nodes.
+///
+/// Each run starts a new pair of files in the shard directory. `urls-n.dat` lists each URL once, in the order it was
+/// first seen, as its 64-bit fingerprint and its varint length and bytes, and the position of a URL in the list is its
+/// ID within the run. `links-n.dat` has an adjacency list per page, as the varint ID of the page, the varint number of
+/// its links, and the IDs of the distinct linked URLs in ascending order, each as the varint gap from the previous ID.
+/// A torn record at the end of a file is ignored when merging, as are the links to URLs that the URL list lacks because
+/// a crash lost its unflushed tail.
+class LinkGraphWriter
+   {
+   public:
+      /// Opens a link graph shard for appending, creating the directory if it does not exist.
+      /// \param directory The directory of the shard.
+      /// \throw IOException The files of the run cannot be opened.
+      explicit LinkGraphWriter( std::filesystem::path directory );
+
+      LinkGraphWriter( const LinkGraphWriter & ) = delete;
+      LinkGraphWriter &operator=( const LinkGraphWriter & ) = delete;
+
+      /// Flushes the files of the run.
+      ~LinkGraphWriter( );
+
+      /// Writes the adjacency list of a page. Safe to call from multiple threads, and hashes outside the lock.
+      /// \param url The URL of the page.
+      /// \param links The absolute URLs that the page links to, in any order and with duplicates.
+      /// \throw IOException The files cannot be written.
+      void write( const Url &url, std::span<const Url> links );
+
+      /// Flushes the files of the run.
+      /// \throw IOException The files cannot be written.
+      void flush( );
+
+      /// Gets the number of pages written in this run.
+      /// \return The number of pages.
+      [[nodiscard]] size_t numPages( ) const;
+
+      /// Computes the fingerprint that identifies a URL across shards.
+      /// \param url The URL.
+      /// \return The fingerprint.
+      [[nodiscard]] static uint64_t fingerprint( StringView url ) noexcept;
+
+   private:
+      friend class LinkGraph;
+
+      static std::filesystem::path urlsPath( const std::filesystem::path &directory, int run );
+
+      static std::filesystem::path linksPath( const std::filesystem::path &directory, int run );
+
+      std::filesystem::path _directory;
+      std::ofstream _urlsStream, _linksStream;
+      HashMap<uint64_t, uint32_t> _urlIds; ///< The IDs within the run by fingerprint.
+      size_t _numPages = 0;
+      mutable Mutex _mutex;
+   };
+
+/// Reads a link graph merged from shards, with the URLs numbered densely in the order of their fingerprints.
+///
+/// `nodes.idx` has an entry per URL in ID order, and a last entry with the sizes of the other files, each entry being
+/// the fingerprint of the URL and the offsets of the URL in `urls.dat` and of its adjacency list in `links.dat`. An
+/// adjacency list is the varint number of links followed by the linked IDs in ascending order, each as the varint gap
+/// from the previous ID.
+class LinkGraph
+   {
+   public:
+      /// Loads a merged link graph.
+      /// \param directory The directory of the graph.
+      /// \throw IOException A file of the graph cannot be read.
+      /// \throw FormatException The index of the graph is malformed.
+      explicit LinkGraph( const std::filesystem::path &directory );
+
+      /// Merges link graph shards into one graph on several threads. If a page has several adjacency lists, such as
+      /// from a recrawl, the last one in shard and run order is kept. Links to URLs of torn records are dropped.
+      /// \param shardDirectories The directories of the shards.
+      /// \param directory The directory to write the graph to, which is created if it does not exist.
+      /// \param numThreads The number of threads.
+      /// \throw IOException A shard cannot be read, or the graph cannot be written.
+      /// \throw InvalidOperationException The shards have 2^32 URLs or more.
+      static void merge( std::span<const std::filesystem::path> shardDirectories,
+                         const std::filesystem::path &directory, int numThreads );
+
+      /// Gets the number of URLs.
+      /// \return The number of URLs.
+      [[nodiscard]] size_t numUrls( ) const noexcept
+         { return _nodes.size( ) - 1; }
+
+      /// Gets the URL of an ID.
+      /// \param urlId The ID of a URL, which is less than `numUrls( )`.
+      /// \return The URL, which is valid as long as the graph.
+      [[nodiscard]] StringView url( UrlId urlId ) const noexcept;
+
+      /// Finds the ID of a URL by its fingerprint.
+      /// \param url The URL.
+      /// \return The ID of the URL, or `nullopt` if the URL is not in the graph.
+      [[nodiscard]] std::optional<UrlId> find( StringView url ) const noexcept;
+
+      /// Decodes the adjacency list of a URL, which is empty if the URL was linked to but not crawled.
+      /// \param urlId The ID of a URL, which is less than `numUrls( )`.
+      /// \param links The IDs of the linked URLs in ascending order, replacing its contents.
+      /// \throw FormatException The adjacency list is malformed.
+      void links( UrlId urlId, Vector<UrlId> &links ) const;
+
+   private:
+      struct Node
+         {
+         public:
+            uint64_t fingerprint;
+            uint64_t urlOffset;
+            uint64_t linksOffset;
+         };
+
+      static std::filesystem::path nodesPath( const std::filesystem::path &directory );
+
+      static std::filesystem::path urlsPath( const std::filesystem::path &directory );
+
+      static std::filesystem::path linksPath( const std::filesystem::path &directory );
+
+      Vector<Node> _nodes;
+      String _urls, _links;
+   };
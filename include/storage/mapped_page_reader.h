@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <span>
+
+#include "core/exception.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "storage/page_record.h"
+#include "storage/segment_store.h"
+
+/// Reads the page records of a segment store through memory maps of its segment files, and partitions them so that
+/// several threads can read them at once. The documents of uncompressed segments are decoded straight from the mapped
+/// data without copying; compressed blocks are decompressed once per partition that reads them. The records committed
+/// after opening are not visible.
+class MappedPageReader
+   {
+   private:
+      struct Segment
+         {
+         public:
+            const char *data = nullptr;
+            size_t dataSize = 0;
+            std::span<const SegmentWriter::IndexEntry> entries;
+            size_t indexSize = 0;
+            bool isCompressed = false;
+            DocId firstDocId = 0;
+         };
+
+   public:
+      /// Represents a range of documents that one thread reads in order, and the memory that the views of the current
+      /// document refer to. Only one iteration of a partition may be in progress at a time.
+      class Partition
+         {
+         public:
+            /// Iterates the documents of a partition. Dereferencing gives a view that is valid until the iterator is
+            /// advanced.
+            class Iterator
+               {
+               public:
+                  using iterator_category = std::input_iterator_tag;
+                  using value_type = PageRecordView;
+                  using difference_type = std::ptrdiff_t;
+                  using pointer = const PageRecordView *;
+                  using reference = const PageRecordView &;
+
+                  Iterator( ) = default;
+
+                  /// Decodes the current document.
+                  /// \throw FormatException The record or its block is corrupt.
+                  reference operator*( ) const
+                     { return _partition->decode( _docId ); }
+
+                  pointer operator->( ) const
+                     { return &**this; }
+
+                  Iterator &operator++( ) noexcept
+                     {
+                     ++_docId;
+                     return *this;
+                     }
+
+                  void operator++( int ) noexcept
+                     { ++*this; }
+
+                  /// Gets the ID of the current document.
+                  /// \return The ID of the document.
+                  [[nodiscard]] DocId docId( ) const noexcept
+                     { return _docId; }
+
+                  friend bool operator==( const Iterator &lhs, const Iterator &rhs ) noexcept
+                     { return lhs._docId == rhs._docId; }
+
+               private:
+                  friend class Partition;
+
+                  Iterator( Partition *partition, DocId docId ) noexcept : _partition( partition ), _docId( docId )
+                     { }
+
+                  Partition *_partition = nullptr;
+                  DocId _docId = 0;
+               };
+
+            Partition( const MappedPageReader &reader, DocId firstDocId, DocId lastDocId ) noexcept :
+                  _reader( &reader ), _firstDocId( firstDocId ), _lastDocId( lastDocId )
+               { }
+
+            [[nodiscard]] Iterator begin( ) noexcept
+               { return { this, _firstDocId }; }
+
+            [[nodiscard]] Iterator end( ) noexcept
+               { return { this, _lastDocId }; }
+
+            /// Gets the number of documents in the partition.
+            /// \return The number of documents.
+            [[nodiscard]] DocId size( ) const noexcept
+               { return _lastDocId - _firstDocId; }
+
+         private:
+            const PageRecordView &decode( DocId docId );
+
+            const MappedPageReader *_reader;
+            DocId _firstDocId, _lastDocId;
+
+            PageRecordView _view;
+            DocId _viewDocId = UINT64_MAX;
+            String _block;
+            const Segment *_blockSegment = nullptr;
+            uint64_t _blockOffset = 0;
+         };
+
+      /// Maps the segment files of a segment store.
+      /// \param directory The directory of the segment store.
+      /// \param termDictionary The dictionary of the term IDs of the records, if they store them.
+      /// \throw SystemException A segment file cannot be opened or mapped.
+      explicit MappedPageReader( const std::filesystem::path &directory,
+                                 const TermDictionary *termDictionary = nullptr );
+
+      MappedPageReader( const MappedPageReader & ) = delete;
+      MappedPageReader &operator=( const MappedPageReader & ) = delete;
+
+      /// Unmaps the segment files, after which the views of the documents are no longer valid.
+      ~MappedPageReader( );
+
+      /// Sets the dictionary of the term IDs of the records. A dictionary that a crawler is still writing should be
+      /// loaded after the segments are mapped, since the crawler persists the terms before committing the records
+      /// that use them, so that the dictionary has the terms of every mapped record.
+      /// \param termDictionary The dictionary of the term IDs of the records, if they store them.
+      void setTermDictionary( const TermDictionary *termDictionary ) noexcept
+         { _termDictionary = termDictionary; }
+
+      /// Gets the number of documents.
+      /// \return The number of documents.
+      [[nodiscard]] DocId numDocuments( ) const noexcept
+         { return _numDocuments; }
+
+      /// Gets the number of bytes of the mapped data files.
+      /// \return The number of bytes.
+      [[nodiscard]] uint64_t numBytes( ) const noexcept;
+
+      /// Splits the documents into consecutive partitions of nearly equal size.
+      /// \param numPartitions The number of partitions.
+      /// \return The partitions, some of which may be empty.
+      [[nodiscard]] Vector<Partition> partition( int numPartitions ) const;
+
+      /// Reads all the documents on several threads, each reading a partition in order.
+      /// \param numThreads The number of threads.
+      /// \param callback The function called with the ID and a view of each document, which is valid during the call.
+      /// It is called from several threads at once.
+      /// \throw FormatException A record or a block is corrupt.
+      void forEach( int numThreads, const std::function<void( DocId, const PageRecordView & )> &callback ) const;
+
+   private:
+      static const char *map( const std::filesystem::path &path, size_t &size );
+
+      Vector<Segment> _segments;
+      DocId _numDocuments = 0;
+      const TermDictionary *_termDictionary;
+   };
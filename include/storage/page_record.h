@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "core/exception.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "html_parser/html_parser.h"
+#include "storage/term_dictionary.h"
+
+/// Represents a link of a `PageRecordView`, whose anchor words are a range of `PageRecordView::anchorWords`.
+struct LinkRecordView
+   {
+   public:
+      StringView url; ///< The URL of the hyperlink.
+      int firstAnchorWord = 0; ///< The index of the first anchor word in `PageRecordView::anchorWords`.
+      int numAnchorWords = 0; ///< The number of anchor words.
+      bool isNoFollow = false; ///< `true` if the anchor has `rel="nofollow"`.
+   };
+
+/// Represents a decoded page record whose strings are views into the record, which must outlive it.
+struct PageRecordView
+   {
+   public:
+      StringView url; ///< The URL that the page was requested from.
+      Vector<StringView> words; ///< The words that appear in the page.
+      Vector<StringView> titleWords; ///< The words that appear in the title of the page.
+      Vector<StringView> anchorWords; ///< The anchor words of all the links, in order.
+      Vector<LinkRecordView> links; ///< The links that appear in the page.
+      Vector<TermId> wordIds; ///< The term IDs of `words`, if the record stores term IDs; empty otherwise.
+      Vector<TermId> titleWordIds; ///< The term IDs of `titleWords`, if the record stores term IDs; empty otherwise.
+      Vector<TermId> anchorWordIds; ///< The term IDs of `anchorWords`, if the record stores term IDs; empty otherwise.
+      std::optional<StringView> base; ///< The base URL of the page.
+      std::optional<StringView> canonical; ///< The canonical URL of the page.
+      RobotsDirectives robots; ///< The directives of the robots meta tags.
+      uint64_t simHash = 0; ///< The SimHash fingerprint of the words.
+
+      /// Gets the anchor words of a link.
+      /// \param linkInfo A link of this `PageRecordView`.
+      /// \return The anchor words of the link.
+      [[nodiscard]] std::span<const StringView> anchorWordsOf( const LinkRecordView &linkInfo ) const noexcept
+         { return { anchorWords.data( ) + linkInfo.firstAnchorWord, static_cast<size_t>(linkInfo.numAnchorWords) }; }
+
+      /// Copies the page into an `HtmlInfo` that owns its words.
+      /// \return The copied `HtmlInfo`.
+      [[nodiscard]] HtmlInfo toHtmlInfo( ) const;
+   };
+
+/// Encodes the URL and the `HtmlInfo` of a page as a compact binary record, and decodes it without copying strings.
+///
+/// A record is a version byte, a flags byte, the varint length of the payload, the payload, and a CRC-32 of the payload
+/// if the flags say so. Records are self-delimiting, so they can be concatenated. The payload is the URL, the SimHash
+/// fingerprint in 8 bytes, the words, the title words, the links, and the base and canonical URLs if the flags say so.
+/// A string is its varint length followed by its bytes, a list is its varint size followed by its items, and a link is
+/// its URL, a varint of the number of anchor words shifted left once with the nofollow bit, and its anchor words. If
+/// the flags say so, each word, title word and anchor word is the varint ID of the word in a `TermDictionary` instead
+/// of a string, which the dictionary maps back when decoding.
+class PageRecord
+   {
+   public:
+      static constexpr uint8_t version = 1; ///< The format version written to every record.
+
+      /// Appends the record of a page.
+      /// \param url The URL that the page was requested from.
+      /// \param htmlInfo The parsed page.
+      /// \param record The string to append the record to.
+      /// \param hasChecksum `true` to append a checksum that is verified on decoding.
+      /// \param termDictionary The dictionary to store the words as term IDs of, or `nullptr` to store them as strings.
+      static void encode( StringView url, const HtmlInfo &htmlInfo, String &record, bool hasChecksum = false,
+                          TermDictionary *termDictionary = nullptr );
+
+      /// Appends the record of a page.
+      /// \param url The URL that the page was requested from.
+      /// \param htmlInfo The parsed page.
+      /// \param record The string to append the record to.
+      /// \param hasChecksum `true` to append a checksum that is verified on decoding.
+      /// \param termDictionary The dictionary to store the words as term IDs of, or `nullptr` to store them as strings.
+      static void encode( StringView url, const HtmlInfoView &htmlInfo, String &record, bool hasChecksum = false,
+                          TermDictionary *termDictionary = nullptr );
+
+      /// Decodes the first record of a string, reusing the memory of a view.
+      /// \param data The string that starts with the record.
+      /// \param view The view to decode into, which refers to `data` and the term dictionary afterwards.
+      /// \param termDictionary The dictionary of the term IDs if the record stores them.
+      /// \return The size of the record.
+      /// \throw FormatException The record is truncated, has an unknown version, does not match its checksum, or has a
+      /// term ID that is not in the term dictionary, or none was given.
+      static size_t decode( StringView data, PageRecordView &view, const TermDictionary *termDictionary = nullptr );
+
+   private:
+      enum Flags : uint8_t
+         {
+         HasChecksum = 1 << 0,
+         HasBase = 1 << 1,
+         HasCanonical = 1 << 2,
+         IsNoIndex = 1 << 3,
+         IsNoFollow = 1 << 4,
+         HasTermIds = 1 << 5
+         };
+
+      static constexpr auto _maxVarintSize = 10;
+
+      template<typename Info>
+      static void encode( StringView url, const Info &htmlInfo, String &record, bool hasChecksum,
+                          TermDictionary *termDictionary );
+
+      static void appendVarint( String &record, uint64_t value );
+
+      static void appendString( String &record, StringView string );
+
+      static uint64_t readVarint( const char *&data, const char *end );
+
+      static StringView readString( const char *&data, const char *end );
+
+      static uint32_t crc32( StringView data ) noexcept;
+   };
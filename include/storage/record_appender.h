@@ -0,0 +1,21 @@
+#pragma once
+
+#include <span>
+
+#include "core/string.h"
+
+/// Appends batches of records to durable storage, e.g. on the writer threads of a `WriteBehindQueue`.
+class RecordAppender
+   {
+   public:
+      virtual ~RecordAppender( ) = default;
+
+      /// Appends records, which are durable once they are committed. Safe to call from multiple threads.
+      /// \param records The records.
+      /// \throw SystemException The records cannot be written.
+      virtual void appendBatch( std::span<const StringView> records ) = 0;
+
+      /// Makes the records appended so far durable.
+      /// \throw SystemException The records cannot be written.
+      virtual void commit( ) = 0;
+   };
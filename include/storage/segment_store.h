@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <span>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/hash_table.h"
+#include "core/memory.h"
+#include "core/queue.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "storage/block_codec.h"
+#include "storage/record_appender.h"
+
+/// Identifies a record of a segment store by its insertion order, starting at 0.
+using DocId = uint64_t;
+
+/// Represents configuration for a segment store.
+struct SegmentStoreConfiguration
+   {
+   public:
+      size_t maxSegmentSize = size_t( 256 ) << 20; ///< The size in bytes beyond which a new segment is started.
+      size_t groupCommitSize = size_t( 4 ) << 20; ///< The number of buffered bytes that triggers a commit.
+      Compression compression = Compression::None; ///< The codec of the blocks; records are stored as is if `None`.
+      int compressionLevel = 0; ///< The compression level of the codec, or 0 for its default level.
+      size_t blockSize = size_t( 64 ) << 10; ///< The number of record bytes beyond which a block is compressed.
+      int numCompressionThreads = 2; ///< The number of background threads that compress blocks.
+      /// Called before each group commit writes, so that what the records refer to, e.g. the terms of a
+      /// `TermDictionary`, is durable before the records are.
+      std::function<void( )> beforeCommit = nullptr;
+   };
+
+/// Appends records to a directory of large append-only segment files instead of one file per record.
+///
+/// Segment `n` consists of a data file and `segment-n.idx`, a fixed-size entry with the offset and the length of each
+/// record. The data file is `segment-n.dat` with the records back to back, or, if compressed, `segment-n.blk` with
+/// blocks of records that are compressed on background threads, each with a header so that it can be decompressed on
+/// its own. Records are buffered and committed in groups: the data is written and synced first, and only then the index
+/// entries, so a crash never leaves an index entry that points past the durable data. On opening, bytes past the last
+/// index entry and torn index entries are truncated.
+class SegmentWriter : public RecordAppender
+   {
+   public:
+      /// Opens a segment store for appending, creating the directory if it does not exist.
+      /// \param directory The directory of the segment store.
+      /// \param config The configuration of the segment store.
+      /// \throw ArgumentException The compression is not available in this build.
+      /// \throw SystemException A segment file cannot be opened or repaired.
+      explicit SegmentWriter( std::filesystem::path directory, const SegmentStoreConfiguration &config = { } );
+
+      SegmentWriter( const SegmentWriter & ) = delete;
+      SegmentWriter &operator=( const SegmentWriter & ) = delete;
+
+      /// Commits the buffered records and closes the segment store.
+      ~SegmentWriter( ) override;
+
+      /// Appends a record, which is durable once it is committed. Safe to call from multiple threads. Waits if the
+      /// compression threads fall behind.
+      /// \param record The record.
+      /// \return The ID of the record.
+      /// \throw SystemException The segment files cannot be written.
+      DocId append( StringView record );
+
+      /// Appends records under a single lock, which is durable once they are committed. Safe to call from multiple
+      /// threads, but the records may be interleaved with the records of other threads.
+      /// \param records The records.
+      /// \throw SystemException The segment files cannot be written.
+      void appendBatch( std::span<const StringView> records ) override;
+
+      /// Compresses and writes the buffered records, and syncs them to disk.
+      /// \throw SystemException The segment files cannot be written.
+      void commit( ) override;
+
+      /// Gets the number of records appended, including the records not committed yet.
+      /// \return The number of records.
+      [[nodiscard]] DocId numRecords( ) const;
+
+      /// Gets the number of record bytes compressed so far.
+      /// \return The number of bytes before compression.
+      [[nodiscard]] uint64_t numUncompressedBytes( ) const noexcept
+         { return _numUncompressedBytes.load( std::memory_order_relaxed ); }
+
+      /// Gets the number of bytes that the records compressed so far were compressed to, including block headers.
+      /// \return The number of bytes after compression.
+      [[nodiscard]] uint64_t numCompressedBytes( ) const noexcept
+         { return _numCompressedBytes.load( std::memory_order_relaxed ); }
+
+      /// Gets the CPU time spent compressing, summed over the compression threads.
+      /// \return The CPU time in seconds.
+      [[nodiscard]] double compressionTime( ) const noexcept
+         { return static_cast<double>(_compressionNanoseconds.load( std::memory_order_relaxed )) / 1e9; }
+
+      /// Writes the compression ratio and the CPU time spent compressing.
+      friend std::ostream &operator<<( std::ostream &stream, const SegmentWriter &segmentWriter );
+
+   private:
+      struct IndexEntry
+         {
+         public:
+            uint64_t offset; ///< The offset of the record, or of its block if compressed, in the data file.
+            uint32_t length; ///< The length of the record.
+            uint32_t offsetInBlock; ///< The offset of the record in its decompressed block, or 0 if not compressed.
+         };
+
+      struct BlockHeader
+         {
+         public:
+            uint32_t compressedSize; ///< The size of the compressed block that follows the header.
+            uint32_t size; ///< The size of the decompressed block.
+            Compression compression; ///< The codec, which is `None` if the block did not compress.
+            uint8_t reserved[ 3 ]; ///< Zero, for alignment.
+         };
+
+      struct Block
+         {
+         public:
+            uint64_t sequenceNumber = 0;
+            String data;
+            String compressedData;
+            Vector<IndexEntry> entries; ///< The entries of the records, whose offset is set when the block is written.
+         };
+
+      friend class MappedPageReader;
+      friend class SegmentReader;
+
+      static std::filesystem::path dataPath( const std::filesystem::path &directory, int segment, bool isCompressed );
+
+      static std::filesystem::path indexPath( const std::filesystem::path &directory, int segment );
+
+      static bool isCompressed( const std::filesystem::path &directory, int segment );
+
+      static int countSegments( const std::filesystem::path &directory );
+
+      static void writeAll( int fileDescriptor, const char *data, size_t size );
+
+      DocId openSegment( int segment );
+
+      void closeSegment( ) noexcept;
+
+      DocId appendLocked( StringView record, UniqueLock<Mutex> &lock );
+
+      void appendToFileLocked( StringView record );
+
+      void sealBlock( UniqueLock<Mutex> &lock );
+
+      void compressBlocks( );
+
+      void writeBlockLocked( Block &block );
+
+      void commitLocked( );
+
+      void rethrowErrorLocked( ) const;
+
+      std::filesystem::path _directory;
+      SegmentStoreConfiguration _config;
+
+      // The records and blocks that are not written yet.
+      DocId _numRecords = 0;
+      UniquePtr<Block> _openBlock;
+      Queue<UniquePtr<Block>> _sealedBlocks;
+      uint64_t _numSealedBlocks = 0;
+      bool _isClosing = false;
+      mutable Mutex _mutex;
+      ConditionVariable _blockSealed, _blockTaken;
+
+      // The segment files and the writes that are not committed yet. Locked after `_mutex` if both are locked.
+      int _segment = -1;
+      int _dataFile = -1, _indexFile = -1;
+      uint64_t _segmentSize = 0; ///< The size of the data file including the buffered records.
+      String _buffer;
+      Vector<IndexEntry> _pendingEntries;
+      HashMap<uint64_t, UniquePtr<Block>> _compressedBlocks; ///< The compressed blocks that wait for earlier blocks.
+      uint64_t _numWrittenBlocks = 0;
+      std::exception_ptr _error; ///< The error of a compression thread, which is rethrown to the caller.
+      Mutex _fileMutex;
+      ConditionVariable _blockWritten;
+
+      Vector<Thread> _compressionThreads;
+      std::atomic<uint64_t> _numUncompressedBytes = 0, _numCompressedBytes = 0;
+      std::atomic<uint64_t> _compressionNanoseconds = 0;
+   };
+
+/// Reads the records of a segment store by ID or in order. The records committed after opening are not visible.
+class SegmentReader
+   {
+   public:
+      /// Opens a segment store for reading.
+      /// \param directory The directory of the segment store.
+      /// \throw SystemException A segment file cannot be opened.
+      explicit SegmentReader( const std::filesystem::path &directory );
+
+      SegmentReader( const SegmentReader & ) = delete;
+      SegmentReader &operator=( const SegmentReader & ) = delete;
+
+      ~SegmentReader( );
+
+      /// Gets the number of records.
+      /// \return The number of records.
+      [[nodiscard]] DocId numRecords( ) const noexcept
+         { return _numRecords; }
+
+      /// Reads a record. Safe to call from multiple threads.
+      /// \param docId The ID of the record.
+      /// \return The record.
+      /// \throw ArgumentException The record does not exist.
+      /// \throw SystemException The segment file cannot be read.
+      /// \throw FormatException The block of the record is corrupt.
+      [[nodiscard]] String read( DocId docId ) const;
+
+      /// Reads all the records in order, with large sequential reads.
+      /// \param callback The function called with the ID and a view of each record, which is valid during the call.
+      /// \throw SystemException A segment file cannot be read.
+      /// \throw FormatException A block is corrupt.
+      void scan( const std::function<void( DocId, StringView )> &callback ) const;
+
+   private:
+      struct Segment
+         {
+         public:
+            int dataFile = -1;
+            bool isCompressed = false;
+            DocId firstDocId = 0;
+            Vector<SegmentWriter::IndexEntry> entries;
+         };
+
+      static constexpr size_t _scanBufferSize = size_t( 4 ) << 20;
+
+      static void readAll( int fileDescriptor, char *data, size_t size, uint64_t offset );
+
+      static void readBlock( const Segment &segment, uint64_t offset, String &compressedBlock, String &block );
+
+      Vector<Segment> _segments;
+      DocId _numRecords = 0;
+   };
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/hash_table.h"
+#include "core/memory.h"
+#include "core/string.h"
+#include "core/vector.h"
+
+/// Identifies a term of a `TermDictionary` by its insertion order, starting at 0.
+using TermId = uint32_t;
+
+/// Interns terms into dense 32-bit IDs from many threads at once, so that stored pages can refer to their words by ID.
+///
+/// The terms are split into shards by hash, each with its own table and lock, and looking up a known term locks only
+/// its shard. Only a new term also takes the lock that assigns IDs. Terms are never removed, so their IDs are stable,
+/// and the ID of a term is mapped back to it without locking. If the dictionary has a file, the file lists the terms in
+/// ID order, each as its varint length followed by its bytes, and `persist` appends the terms added since the last
+/// call, so that the file is always a prefix of the dictionary.
+class TermDictionary
+   {
+   public:
+      /// Initializes an empty dictionary without a file.
+      TermDictionary( );
+
+      /// Loads a dictionary from its file, creating the file if it does not exist. A torn last term is truncated.
+      /// \param path The path of the file.
+      /// \param isReadOnly Whether to only read the file, e.g. while a crawler appends to it, in which case the file is
+      /// neither created nor repaired, the terms stop before a torn last term, and the dictionary is not persisted.
+      /// \throw SystemException The file cannot be opened or repaired.
+      explicit TermDictionary( std::filesystem::path path, bool isReadOnly = false );
+
+      TermDictionary( const TermDictionary & ) = delete;
+      TermDictionary &operator=( const TermDictionary & ) = delete;
+
+      /// Persists the dictionary and closes its file.
+      ~TermDictionary( );
+
+      /// Gets the ID of a term, adding the term if it is new. Safe to call from multiple threads.
+      /// \param term The term.
+      /// \return The ID of the term.
+      /// \throw InvalidOperationException The dictionary has 2^32 terms.
+      TermId intern( StringView term );
+
+      /// Finds the ID of a term. Safe to call from multiple threads.
+      /// \param term The term.
+      /// \return The ID of the term, or `nullopt` if the term is not in the dictionary.
+      [[nodiscard]] std::optional<TermId> find( StringView term ) const;
+
+      /// Maps an ID back to its term without locking. Safe to call from multiple threads.
+      /// \param termId The ID of a term.
+      /// \return The term, which is valid as long as the dictionary.
+      /// \throw FormatException The ID is not in the dictionary.
+      [[nodiscard]] StringView term( TermId termId ) const;
+
+      /// Gets the number of terms.
+      /// \return The number of terms.
+      [[nodiscard]] size_t size( ) const noexcept
+         { return _numTerms.load( std::memory_order_acquire ); }
+
+      /// Appends the terms added since the last call to the file, and syncs it to disk. Does nothing without a file.
+      /// \throw SystemException The file cannot be written.
+      void persist( );
+
+   private:
+      struct Shard
+         {
+         public:
+            HashMap<StringView, TermId> termIds; ///< Keyed by views into `termBlocks`, so lookups do not allocate.
+            Vector<UniquePtr<char[]>> termBlocks; ///< The bytes of the terms, in blocks that never move.
+            size_t blockSize = 0, blockUsedSize = 0; ///< The size and the used size of the last block.
+            mutable Mutex mutex;
+         };
+
+      static constexpr auto _numShards = 64;
+      static constexpr size_t _termBlockSize = size_t( 64 ) << 10;
+      static constexpr auto _chunkBits = 16;
+      static constexpr size_t _chunkSize = size_t( 1 ) << _chunkBits;
+      static constexpr size_t _maxNumChunks = ( size_t( 1 ) << 32 ) / _chunkSize;
+
+      Shard &shardOf( StringView term ) noexcept
+         { return _shards[ Hash<StringView>( )( term ) % _numShards ]; }
+
+      const Shard &shardOf( StringView term ) const noexcept
+         { return _shards[ Hash<StringView>( )( term ) % _numShards ]; }
+
+      static StringView storeLocked( Shard &shard, StringView term );
+
+      std::array<Shard, _numShards> _shards;
+
+      // The terms by ID, in chunks that never move, published by `_numTerms`.
+      UniquePtr<std::atomic<StringView *>[]> _chunks;
+      std::atomic<size_t> _numTerms = 0;
+      Mutex _termIdMutex; ///< Locked after the lock of a shard, to assign the next ID.
+
+      std::optional<std::filesystem::path> _path;
+      int _file = -1;
+      size_t _numPersistedTerms = 0;
+      uint64_t _persistedSize = 0;
+      Mutex _fileMutex;
+   };
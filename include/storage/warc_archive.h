@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/net.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "storage/record_appender.h"
+#include "storage/write_behind_queue.h"
+
+/// Represents configuration for a raw response archive.
+struct WarcArchiveConfiguration
+   {
+   public:
+      size_t maxFileSize = size_t( 1 ) << 30; ///< The size in bytes beyond which a new archive file is started.
+      int compressionLevel = 0; ///< The gzip compression level, or 0 for the default level.
+      WriteBehindConfiguration writeQueue{ .maxQueueSize = size_t( 16 ) << 20 }; ///< The queue of compressed records.
+   };
+
+/// Locates an archived response, sorted by URL in the index of the archive.
+struct WarcIndexEntry
+   {
+   public:
+      String url; ///< The URL that the response was requested from.
+      int file = 0; ///< The number of the archive file.
+      uint64_t offset = 0; ///< The offset of the gzip member of the record in the archive file.
+      uint64_t length = 0; ///< The length of the gzip member.
+
+      friend bool operator<( const WarcIndexEntry &lhs, const WarcIndexEntry &rhs ) noexcept
+         { return lhs.url < rhs.url; }
+   };
+
+/// Archives raw HTTP responses as WARC response records, so that pages can be parsed again without fetching them.
+///
+/// Each record is its own gzip member, so that the archive files are valid gzip files that standard WARC tools read,
+/// and a record can still be decompressed alone from its offset. Each run starts a new archive file
+/// `archive-n.warc.gz`. Each archive file has an index `archive-n.cdx` with a line `url file offset length` per record,
+/// sorted by URL, which is written when the archive file is full and rewritten on every flush until then, so that the
+/// writer only keeps the index entries of the open archive file.
+///
+/// Records are compressed by the threads that write them, and appended to the archive file through a write-behind
+/// queue, so that the writers do not wait for the disk. Each queued record is the URL, a space, and the gzip member.
+class WarcWriter : public RecordAppender
+   {
+   public:
+      /// Opens a raw response archive for appending, creating the directory if it does not exist.
+      /// \param directory The directory of the archive.
+      /// \param config The configuration of the archive.
+      /// \throw IOException The archive file or the index cannot be opened.
+      explicit WarcWriter( std::filesystem::path directory, const WarcArchiveConfiguration &config = { } );
+
+      WarcWriter( const WarcWriter & ) = delete;
+      WarcWriter &operator=( const WarcWriter & ) = delete;
+
+      /// Flushes the archive and writes the index of the open archive file.
+      ~WarcWriter( ) override;
+
+      /// Archives a response. Safe to call from multiple threads, and compresses before queueing the record.
+      /// \param requestUrl The URL that the response was requested from.
+      /// \param response The response.
+      /// \throw IOException An earlier record cannot be written.
+      void write( const Url &requestUrl, const HttpResponseMessage &response );
+
+      /// Waits until the queued records are written, flushes the archive file, and rewrites its index.
+      /// \throw IOException The archive file or the index cannot be written.
+      void flush( );
+
+      /// Gets the number of records archived in this run, including the queued records.
+      /// \return The number of records.
+      [[nodiscard]] size_t numRecords( ) const noexcept
+         { return _numRecords.load( std::memory_order_relaxed ); }
+
+   private:
+      friend class WarcReader;
+
+      static std::filesystem::path filePath( const std::filesystem::path &directory, int file );
+
+      static std::filesystem::path indexPath( const std::filesystem::path &directory, int file );
+
+      static String compressMember( StringView data, int level );
+
+      static String decompressMember( StringView member );
+
+      void appendBatch( std::span<const StringView> records ) override;
+
+      void commit( ) override;
+
+      void openFile( int file );
+
+      void writeIndexLocked( );
+
+      std::filesystem::path _directory;
+      WarcArchiveConfiguration _config;
+
+      int _file = -1;
+      std::ofstream _fileStream;
+      uint64_t _fileSize = 0;
+      Vector<WarcIndexEntry> _indexEntries; ///< The index entries of the open archive file.
+      std::atomic<size_t> _numRecords = 0;
+      Mutex _mutex;
+
+      WriteBehindQueue _writeQueue; ///< Declared last, so that its writer threads stop before the file closes.
+   };
+
+/// Reads the records of a raw response archive by URL or by index entry.
+class WarcReader
+   {
+   public:
+      /// Opens a raw response archive for reading, with the indexes of its archive files merged.
+      /// \param directory The directory of the archive.
+      /// \throw SystemException An archive file cannot be opened.
+      /// \throw FormatException An index is malformed.
+      explicit WarcReader( std::filesystem::path directory );
+
+      WarcReader( const WarcReader & ) = delete;
+      WarcReader &operator=( const WarcReader & ) = delete;
+
+      ~WarcReader( );
+
+      /// Gets the index entries, sorted by URL.
+      /// \return The index entries.
+      [[nodiscard]] std::span<const WarcIndexEntry> entries( ) const noexcept
+         { return _entries; }
+
+      /// Finds the index entry of the latest response from a URL.
+      /// \param url The URL.
+      /// \return The index entry, or `nullptr` if the URL is not archived.
+      [[nodiscard]] const WarcIndexEntry *find( const Url &url ) const;
+
+      /// Reads an archived response. Safe to call from multiple threads.
+      /// \param entry The index entry of the response.
+      /// \return The response.
+      /// \throw SystemException The archive file cannot be read.
+      /// \throw FormatException The record is malformed.
+      [[nodiscard]] HttpResponseMessage read( const WarcIndexEntry &entry ) const;
+
+   private:
+      std::filesystem::path _directory;
+      Vector<WarcIndexEntry> _entries;
+      Vector<int> _files;
+   };
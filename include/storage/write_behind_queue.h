@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+
+#include "core/concurrency.h"
+#include "core/exception.h"
+#include "core/queue.h"
+#include "core/string.h"
+#include "core/vector.h"
+#include "storage/record_appender.h"
+
+/// Represents configuration for a write-behind queue.
+struct WriteBehindConfiguration
+   {
+   public:
+      size_t maxQueueSize = size_t( 64 ) << 20; ///< The number of queued bytes beyond which producers wait.
+      size_t maxBatchSize = size_t( 4 ) << 20; ///< The number of bytes that a writer thread appends at once.
+      int numWriterThreads = 1; ///< The number of threads that append to the segment store.
+   };
+
+/// Queues records from many producer threads and appends them to a store, such as a segment store, on dedicated writer
+/// threads, so that producers never wait for the disk unless the queue is full. Each writer thread takes a batch of
+/// queued records at once and appends it with a single lock of the store, which buffers it into large sequential
+/// writes.
+class WriteBehindQueue
+   {
+   public:
+      /// Starts the writer threads of a write-behind queue.
+      /// \param recordAppender The store to append to, which must outlive the queue.
+      /// \param config The configuration of the queue.
+      explicit WriteBehindQueue( RecordAppender &recordAppender, const WriteBehindConfiguration &config = { } );
+
+      WriteBehindQueue( const WriteBehindQueue & ) = delete;
+      WriteBehindQueue &operator=( const WriteBehindQueue & ) = delete;
+
+      /// Flushes the queued records and stops the writer threads.
+      ~WriteBehindQueue( );
+
+      /// Queues a record, waiting while the queue is full. A record larger than the queue waits for an empty queue.
+      /// \param record The record.
+      /// \throw SystemException A writer thread failed to write an earlier record.
+      void push( String record );
+
+      /// Waits until the records queued so far are appended, and then commits the store.
+      /// \throw SystemException The records cannot be written.
+      void flush( );
+
+      /// Gets the number of bytes queued.
+      /// \return The number of bytes queued.
+      [[nodiscard]] size_t queueSize( ) const;
+
+      /// Gets the largest number of bytes queued at once so far.
+      /// \return The peak number of bytes queued.
+      [[nodiscard]] size_t peakQueueSize( ) const noexcept
+         { return _peakQueueSize.load( std::memory_order_relaxed ); }
+
+      /// Gets the number of pushes that waited for a full queue.
+      /// \return The number of pushes that waited.
+      [[nodiscard]] long numStalls( ) const noexcept
+         { return _numStalls.load( std::memory_order_relaxed ); }
+
+      /// Gets the mean time to append a batch, including any commits it triggered.
+      /// \return The mean write latency in milliseconds, or 0 if nothing was written.
+      [[nodiscard]] double meanWriteLatency( ) const noexcept;
+
+      /// Gets the longest time to append a batch.
+      /// \return The maximum write latency in milliseconds.
+      [[nodiscard]] double maxWriteLatency( ) const noexcept
+         { return static_cast<double>(_maxWriteNanoseconds.load( std::memory_order_relaxed )) / 1e6; }
+
+      /// Writes the queue depth, the stalls and the write latency.
+      friend std::ostream &operator<<( std::ostream &stream, const WriteBehindQueue &writeBehindQueue );
+
+   private:
+      void writeRecords( );
+
+      RecordAppender &_recordAppender;
+      WriteBehindConfiguration _config;
+
+      Queue<String> _records;
+      size_t _queueSize = 0;
+      uint64_t _numPushed = 0, _numTaken = 0;
+      Vector<uint64_t> _batchesInFlight; ///< The push order of the first record of each batch being written.
+      bool _isClosing = false;
+      std::exception_ptr _error; ///< The error of a writer thread, which is rethrown to producers.
+      mutable Mutex _mutex;
+      ConditionVariable _recordPushed, _recordsTaken, _recordsWritten;
+
+      Vector<Thread> _writerThreads;
+
+      std::atomic<size_t> _peakQueueSize = 0;
+      std::atomic<long> _numStalls = 0;
+      std::atomic<uint64_t> _numBatches = 0, _writeNanoseconds = 0, _maxWriteNanoseconds = 0;
+   };
@@ -0,0 +1,37 @@
+#include "core/net/host_table.h"
+
+HostId HostTable::intern( StringView host )
+   {
+   auto &shard = _shards[ Hash<StringView>( )( host ) % _numShards ];
+   UniqueLock lock( shard.mutex );
+   if ( const auto it = shard.ids.find( host ); it != shard.ids.cend( ) ) return it->second;
+
+   const auto id = _size.fetch_add( 1, std::memory_order_acq_rel );
+
+   // Allocates the chunk holding the ID on first use; chunks never move, so views of stored hosts stay valid. The
+   // chunks cover the whole 32-bit ID space.
+   auto &chunk = _chunks[ id / _chunkSize ];
+   auto *storage = chunk.load( std::memory_order_acquire );
+   if ( storage == nullptr )
+      {
+      UniqueLock chunksLock( _chunksMutex );
+      if ( ( storage = chunk.load( std::memory_order_acquire ) ) == nullptr )
+         {
+         storage = _ownedChunks.emplace_back( new String[_chunkSize] ).get( );
+         chunk.store( storage, std::memory_order_release );
+         }
+      }
+
+   auto &stored = storage[ id % _chunkSize ];
+   stored = host;
+   shard.ids.emplace( stored, id );
+   return id;
+   }
+
+std::optional<HostId> HostTable::find( StringView host ) const
+   {
+   const auto &shard = _shards[ Hash<StringView>( )( host ) % _numShards ];
+   UniqueLock lock( shard.mutex );
+   if ( const auto it = shard.ids.find( host ); it != shard.ids.cend( ) ) return it->second;
+   return std::nullopt;
+   }
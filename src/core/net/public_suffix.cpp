@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <numeric>
+
+#include "core/net/public_suffix.h"
+
+PublicSuffixList::PublicSuffixList( const Vector<StringView> &rules ) : _nodes( 1 )
+   {
+   // Reserves the label storage up front so that the views held by the edges are never invalidated.
+   _labels.reserve( std::accumulate( rules.cbegin( ), rules.cend( ), size_t{ 0 }, [ ]( size_t sum, StringView rule )
+      { return sum + rule.size( ); } ) );
+
+   for ( auto rule : rules )
+      {
+      const auto isException = rule.starts_with( '!' );
+      if ( isException ) rule.remove_prefix( 1 );
+      if ( rule.empty( ) ) continue;
+
+      // Inserts the labels from right to left.
+      auto node = _root;
+      for ( auto end = rule.size( ); ; )
+         {
+         const auto pos = rule.rfind( '.', end - 1 );
+         const auto begin = pos == StringView::npos ? 0 : pos + 1;
+         const auto label = rule.substr( begin, end - begin );
+
+         if ( const auto child = findChild( node, label ); child != -1 ) node = child;
+         else
+            {
+            const auto labelBegin = _labels.size( );
+            std::transform( label.cbegin( ), label.cend( ), std::back_inserter( _labels ), toLower );
+            _edges.emplace( Edge{ node, StringView( _labels ).substr( labelBegin ) }, _nodes.size( ) );
+            node = static_cast<int>(_nodes.size( ));
+            _nodes.emplace_back( );
+            }
+
+         if ( pos == StringView::npos || pos == 0 ) break;
+         end = pos;
+         }
+
+      if ( isException ) _nodes[ node ].isException = true;
+      else _nodes[ node ].isRule = true;
+      }
+   }
+
+const PublicSuffixList &PublicSuffixList::bundled( )
+   {
+   static const PublicSuffixList publicSuffixList( {
+#include "core/net/public_suffix_rules.inc"
+   } );
+   return publicSuffixList;
+   }
+
+StringView PublicSuffixList::publicSuffix( StringView host ) const noexcept
+   {
+   if ( host.ends_with( '.' ) ) host.remove_suffix( 1 );
+   return trailingLabels( host, countSuffixLabels( host ) );
+   }
+
+StringView PublicSuffixList::registrableDomain( StringView host ) const noexcept
+   {
+   if ( host.ends_with( '.' ) ) host.remove_suffix( 1 );
+   if ( host.empty( ) || isIPAddress( host ) ) return host;
+   return trailingLabels( host, countSuffixLabels( host ) + 1 );
+   }
+
+bool PublicSuffixList::Edge::operator==( const Edge &rhs ) const noexcept
+   {
+   return parent == rhs.parent && std::equal( label.cbegin( ), label.cend( ), rhs.label.cbegin( ), rhs.label.cend( ),
+                                              [ ]( char lhs, char rhs )
+                                                 { return toLower( lhs ) == toLower( rhs ); } );
+   }
+
+size_t PublicSuffixList::EdgeHash::operator()( const Edge &edge ) const noexcept
+   {
+   // FNV-1a over the lowercase label, seeded by the parent node.
+   size_t hashValue = 14695981039346656037ull ^ static_cast<size_t>(edge.parent);
+   for ( const auto c : edge.label )
+      hashValue = ( hashValue ^ static_cast<unsigned char>(toLower( c )) ) * 1099511628211ull;
+   return hashValue;
+   }
+
+StringView PublicSuffixList::trailingLabels( StringView host, int numLabels ) noexcept
+   {
+   if ( numLabels <= 0 ) return host.substr( host.size( ) );
+   auto pos = host.size( );
+   for ( auto i = 0; i < numLabels; ++i )
+      if ( pos == 0 || ( pos = host.rfind( '.', pos - 1 ) ) == StringView::npos ) return host;
+   return host.substr( pos + 1 );
+   }
+
+bool PublicSuffixList::isIPAddress( StringView host ) noexcept
+   {
+   if ( host.starts_with( '[' ) ) return true;
+   const auto pos = host.rfind( '.' );
+   const auto lastLabel = pos == StringView::npos ? host : host.substr( pos + 1 );
+   return !lastLabel.empty( ) && std::all_of( lastLabel.cbegin( ), lastLabel.cend( ), [ ]( char c )
+      { return std::isdigit( static_cast<unsigned char>(c) ); } );
+   }
+
+int PublicSuffixList::findChild( int parent, StringView label ) const noexcept
+   {
+   const auto it = _edges.find( Edge{ parent, label } );
+   return it != _edges.cend( ) ? it->second : -1;
+   }
+
+int PublicSuffixList::countSuffixLabels( StringView host ) const noexcept
+   {
+   // Walks the trie from the rightmost label and keeps the longest matching rule, "*" being the implicit default.
+   auto node = _root, numLabels = 0, numSuffixLabels = 1;
+   for ( auto end = host.size( ); end != 0; )
+      {
+      const auto pos = host.rfind( '.', end - 1 );
+      const auto begin = pos == StringView::npos ? 0 : pos + 1;
+      const auto label = host.substr( begin, end - begin );
+      ++numLabels;
+
+      if ( const auto child = findChild( node, label ); child != -1 )
+         {
+         if ( _nodes[ child ].isException ) return numLabels - 1;
+         if ( _nodes[ child ].isRule ) numSuffixLabels = numLabels;
+         node = child;
+         }
+      else if ( const auto wildcard = findChild( node, "*" ); wildcard != -1 )
+         {
+         if ( _nodes[ wildcard ].isRule ) numSuffixLabels = numLabels;
+         node = wildcard;
+         }
+      else break;
+
+      if ( pos == StringView::npos ) break;
+      end = pos;
+      }
+   return numSuffixLabels;
+   }
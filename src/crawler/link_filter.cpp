@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <fstream>
+
+#include "crawler/link_filter.h"
+
+const StringView LinkFilter::defaultRules = R"(# Filters out non-HTML contents by URL suffix.
+deny_extension gif jpeg jpg json mp3 mp4 ogg ogv pdf png rdf rss svg tiff ttf txt webm xml zip
+
+# Filters out non-English contents by tag information.
+allow_language en
+
+# Filters out non-English contents by URL prefix.
+deny_language_prefix aa ab ace af ak als am an ang ar arc arz as ast az azb ba bar bcl be be-tarask
+deny_language_prefix bg bh bn br bs ca ce ceb chr cs csb cy da de diq el eo es et eu fa fi fo fr frr
+deny_language_prefix fy ga gd gl gn gom gu ha hak he hi hr hsb ht hu hy hyw ia id ie io is it ja jv
+deny_language_prefix ka kk kl kn ko ks ku ky la lad li lij lo lt lv mg min mk ml mr ms mt my na nah
+deny_language_prefix nap nl nn no oc or pa pfl pl pms ps pt ro ru sa sah sd sh sk sl sq sr sv sw ta
+deny_language_prefix te tg th tr tt uk ur uz vec vi vo wa war yi zh zh-min-nan zh-yue
+)";
+
+LinkFilter LinkFilter::compile( StringView rules )
+   {
+   LinkFilter linkFilter;
+   Vector<String> extensions, hosts, domains, languagePrefixes;
+   auto hasAllowList = false;
+
+   std::istringstream rulesStream( String{ rules } );
+   for ( String line; std::getline( rulesStream, line ); )
+      {
+      if ( const auto pos = line.find( '#' ); pos != String::npos ) line.erase( pos );
+      std::istringstream lineStream( line );
+      String directive;
+      if ( !( lineStream >> directive ) ) continue;
+      Vector<String> values;
+      for ( String value; lineStream >> value; ) values.emplace_back( std::move( value ) );
+      if ( values.empty( ) ) throw FormatException( STRING( "The rule \"" << directive << "\" has no values." ) );
+
+      const auto rule = static_cast<int>(linkFilter._rules.size( ));
+      const auto addKeys = [ & ]( Vector<String> &keys, Vector<int> &keyRules )
+         {
+         for ( auto &value : values )
+            keys.emplace_back( std::move( value ) ), keyRules.emplace_back( rule );
+         };
+
+      RuleType type;
+      if ( directive == "deny_extension" )
+         type = RuleType::DenyExtension, addKeys( extensions, linkFilter._extensionRules );
+      else if ( directive == "allow_host" )
+         type = RuleType::AllowHost, addKeys( hosts, linkFilter._hostRules ), hasAllowList = true;
+      else if ( directive == "deny_host" )
+         type = RuleType::DenyHost, addKeys( hosts, linkFilter._hostRules );
+      else if ( directive == "allow_domain" )
+         type = RuleType::AllowDomain, addKeys( domains, linkFilter._domainRules ), hasAllowList = true;
+      else if ( directive == "deny_domain" )
+         type = RuleType::DenyDomain, addKeys( domains, linkFilter._domainRules );
+      else if ( directive == "deny_path" )
+         {
+         type = RuleType::DenyPath;
+         for ( auto &value : values ) linkFilter._pathGlobs.emplace_back( std::move( value ), rule );
+         }
+      else if ( directive == "allow_language" )
+         {
+         type = RuleType::AllowLanguage;
+         for ( auto &value : values )
+            {
+            for ( auto &c : value ) c = toLower( c );
+            linkFilter._allowedLanguages.emplace_back( std::move( value ) );
+            }
+         if ( linkFilter._allowLanguageRule == -1 ) linkFilter._allowLanguageRule = rule;
+         }
+      else if ( directive == "deny_language_prefix" )
+         type = RuleType::DenyLanguagePrefix, addKeys( languagePrefixes, linkFilter._languagePrefixRules );
+      else throw FormatException( STRING( "The rule directive \"" << directive << "\" is unrecognized." ) );
+
+      const auto beginPos = line.find_first_not_of( " \t" ), endPos = line.find_last_not_of( " \t\r" );
+      linkFilter._rules.emplace_back( Rule{ type, line.substr( beginPos, endPos - beginPos + 1 ) } );
+      }
+
+   // Rejects a host or domain that both an allow and a deny rule list, of which only the first would take effect.
+   const auto checkConflicts = [ & ]( const Vector<String> &keys, const Vector<int> &keyRules )
+      {
+      HashMap<String, RuleType> keyTypes;
+      for ( size_t i = 0; i < keys.size( ); ++i )
+         {
+         String key( keys[ i ].size( ), '\0' );
+         std::transform( keys[ i ].cbegin( ), keys[ i ].cend( ), key.begin( ), toLower );
+         const auto type = linkFilter._rules[ keyRules[ i ] ].type;
+         if ( const auto [ it, isNew ] = keyTypes.try_emplace( std::move( key ), type ); !isNew && it->second != type )
+            throw FormatException( STRING( "The rules both allow and deny \"" << keys[ i ] << "\"." ) );
+         }
+      };
+   checkConflicts( hosts, linkFilter._hostRules );
+   checkConflicts( domains, linkFilter._domainRules );
+
+   if ( hasAllowList )
+      {
+      linkFilter._notAllowedRule = static_cast<int>(linkFilter._rules.size( ));
+      linkFilter._rules.emplace_back( Rule{ RuleType::NotAllowed, "(host not in allow_host or allow_domain)" } );
+      }
+
+   linkFilter._numHits.reset( new std::atomic<long>[linkFilter._rules.size( )]{ } );
+   linkFilter._extensions = PerfectHashSet( extensions );
+   linkFilter._hosts = PerfectHashSet( hosts );
+   linkFilter._domains = PerfectHashSet( domains );
+   linkFilter._languagePrefixes = PerfectHashSet( languagePrefixes );
+   return linkFilter;
+   }
+
+LinkFilter LinkFilter::load( const std::filesystem::path &path )
+   {
+   std::ifstream file( path );
+   if ( !file.is_open( ) ) throw IOException( "The link filter file cannot be opened." );
+   return compile( String( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>( ) ) );
+   }
+
+bool LinkFilter::isAllowed( const Url &url, const TagInfo &tagInfo ) const
+   {
+   // A relative URL has no host, so only the rules on its path and tag apply to it.
+   const auto isAbsoluteUrl = url.isAbsoluteUrl( );
+   const StringView urlString = url.toString( );
+   const auto localPath = isAbsoluteUrl ? StringView( url.localPath( ) )
+                                        : urlString.substr( 0, urlString.find_first_of( "?#" ) );
+   const auto host = isAbsoluteUrl ? StringView( url.host( ) ) : StringView( );
+
+   // Filters out non-HTML contents by URL suffix.
+   if ( const auto pos = localPath.rfind( '.' ); pos != StringView::npos )
+      if ( const auto key = _extensions.find( localPath.substr( pos + 1 ) ); key != -1 )
+         return reject( _extensionRules[ key ] );
+
+   // Filters out contents in other languages by tag information.
+   if ( !_allowedLanguages.empty( ) )
+      {
+      auto language = tagInfo.valueOf( "hreflang" );
+      if ( !language.has_value( ) ) language = tagInfo.valueOf( "lang" );
+      if ( language.has_value( ) &&
+           std::none_of( _allowedLanguages.cbegin( ), _allowedLanguages.cend( ), [ & ]( const String &allowed )
+              { return language->find( allowed ) != String::npos; } ) )
+         return reject( _allowLanguageRule );
+      }
+
+   if ( isAbsoluteUrl )
+      {
+      // Filters out contents in other languages by URL prefix.
+      if ( const auto key = _languagePrefixes.find( host.substr( 0, host.find( '.' ) ) ); key != -1 )
+         return reject( _languagePrefixRules[ key ] );
+
+      // Matches the exact host, and then the host and its parent domains from the most specific one.
+      auto isAllowedHost = false;
+      if ( const auto key = _hosts.find( host ); key != -1 )
+         {
+         if ( _rules[ _hostRules[ key ] ].type == RuleType::DenyHost ) return reject( _hostRules[ key ] );
+         isAllowedHost = true;
+         }
+      for ( auto domain = host; !_domains.empty( ); )
+         {
+         if ( const auto key = _domains.find( domain ); key != -1 )
+            {
+            if ( _rules[ _domainRules[ key ] ].type == RuleType::DenyDomain ) return reject( _domainRules[ key ] );
+            isAllowedHost = true;
+            break;
+            }
+         const auto pos = domain.find( '.' );
+         if ( pos == StringView::npos ) break;
+         domain.remove_prefix( pos + 1 );
+         }
+      if ( _notAllowedRule != -1 && !isAllowedHost ) return reject( _notAllowedRule );
+      }
+
+   // Filters out local paths by patterns.
+   for ( const auto &[pattern, rule] : _pathGlobs )
+      if ( matchesGlob( localPath, pattern ) ) return reject( rule );
+
+   return true;
+   }
+
+long LinkFilter::numRejected( ) const noexcept
+   {
+   long numRejected = 0;
+   for ( auto i = 0; i < numRules( ); ++i ) numRejected += numHits( i );
+   return numRejected;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const LinkFilter &linkFilter )
+   {
+   for ( auto i = 0; i < linkFilter.numRules( ); ++i )
+      stream << std::setw( 10 ) << linkFilter.numHits( i ) << "  " << linkFilter._rules[ i ].text << '\n';
+   return stream;
+   }
+
+bool LinkFilter::reject( int rule ) const noexcept
+   {
+   _numHits[ rule ].fetch_add( 1, std::memory_order_relaxed );
+   return false;
+   }
+
+bool LinkFilter::matchesGlob( StringView string, StringView pattern ) noexcept
+   {
+   // Matches greedily and backtracks to the last star on a mismatch, which never needs more than one star position.
+   size_t stringPos = 0, patternPos = 0, starPos = StringView::npos, starMatchPos = 0;
+   while ( stringPos < string.size( ) )
+      {
+      if ( patternPos < pattern.size( ) &&
+           ( pattern[ patternPos ] == '?' || toLower( pattern[ patternPos ] ) == toLower( string[ stringPos ] ) ) )
+         ++stringPos, ++patternPos;
+      else if ( patternPos < pattern.size( ) && pattern[ patternPos ] == '*' )
+         starPos = patternPos++, starMatchPos = stringPos;
+      else if ( starPos != StringView::npos )
+         patternPos = starPos + 1, stringPos = ++starMatchPos;
+      else return false;
+      }
+   while ( patternPos < pattern.size( ) && pattern[ patternPos ] == '*' ) ++patternPos;
+   return patternPos == pattern.size( );
+   }
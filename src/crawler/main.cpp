@@ -1,160 +1,299 @@
-#include <getopt.h>
-#include <sys/resource.h>
-
-#include "core/file_system.h"
-#include "core/io.h"
-#include "crawler/crawler.h"
-#include "distributed/distributed.h"
-
-enum class OptionName
-   {
-      AssumeYes,
-      SeedFile,
-      NumThreads,
-      LogPath,
-      DataDir,
-      CheckpointPath,
-      StatsRefreshInterval,
-      ExpectedNumUrls,
-      CheckpointInterval,
-      ServerID,
-      HostNamePath
-   };
-
-bool isUserConfirmed( bool assumeYes );
-
-int main( int argc, char **argv )
-   {
-   static const option options[] = {
-         { "assume_yes",             no_argument,       nullptr, static_cast<int>(OptionName::AssumeYes) },
-         { "seed_file",              required_argument, nullptr, static_cast<int>(OptionName::SeedFile) },
-         { "num_threads",            required_argument, nullptr, static_cast<int>(OptionName::NumThreads) },
-         { "log_path",               required_argument, nullptr, static_cast<int>(OptionName::LogPath) },
-         { "data_dir",               required_argument, nullptr, static_cast<int>(OptionName::DataDir) },
-         { "checkpoint_path",        required_argument, nullptr, static_cast<int>(OptionName::CheckpointPath) },
-         { "stats_refresh_interval", required_argument, nullptr, static_cast<int>(OptionName::StatsRefreshInterval) },
-         { "expected_num_urls",      required_argument, nullptr, static_cast<int>(OptionName::ExpectedNumUrls) },
-         { "checkpoint_interval",    required_argument, nullptr, static_cast<int>(OptionName::CheckpointInterval) },
-         { "serverID",               required_argument, nullptr, static_cast<int>(OptionName::ServerID) },
-         { "hostname_path",          required_argument, nullptr, static_cast<int>(OptionName::HostNamePath) },
-         { nullptr,                  no_argument,       nullptr, 0 }
-   };
-
-   bool assumeYes = false;
-   String seedFile, hostnameFile;
-   CrawlerConfiguration config;
-   int numThreads = 1;
-   int serverID;
-
-   int optionVal;
-   while ( ( optionVal = getopt_long_only( argc, argv, "", options, nullptr ) ) != -1 )
-      {
-      switch ( static_cast<OptionName>(optionVal) )
-         {
-         case OptionName::AssumeYes:
-            assumeYes = true;
-            break;
-         case OptionName::SeedFile:
-            seedFile = optarg;
-            break;
-         case OptionName::NumThreads:
-            numThreads = std::stoi( optarg );
-            break;
-         case OptionName::LogPath:
-            config.logPath = optarg;
-            break;
-         case OptionName::DataDir:
-            config.dataDir = optarg;
-            break;
-         case OptionName::CheckpointPath:
-            config.checkpointPath = optarg;
-            break;
-         case OptionName::StatsRefreshInterval:
-            config.statsRefreshInterval = std::stoi( optarg );
-            break;
-         case OptionName::ExpectedNumUrls:
-            config.expectedNumUrls = std::stoi( optarg );
-            break;
-         case OptionName::CheckpointInterval:
-            config.checkpointInterval = std::stoi( optarg );
-            break;
-         case OptionName::ServerID:
-            serverID = std::stoi( optarg );
-            break;
-         case OptionName::HostNamePath:
-            hostnameFile = optarg;
-            break;
-         default:
-            throw ArgumentException( "The option is unrecognized." );
-         }
-      }
-
-   // Checks resource limits.
-   static constexpr auto recommendedFileDescriptorLimit = 65536;
-   rlimit limit{ };
-   if ( getrlimit( RLIMIT_NOFILE, &limit ) == -1 ) throw SystemException( );
-   if ( limit.rlim_cur < recommendedFileDescriptorLimit )
-      {
-      std::cout << "The resource limit for file descriptor number is too low (" << limit.rlim_cur << ").\n"
-                << "Do you want to increase the limit to " << recommendedFileDescriptorLimit << "? [Y/n]" << std::endl;
-      if ( isUserConfirmed( assumeYes ) )
-         {
-         limit.rlim_cur = recommendedFileDescriptorLimit;
-         if ( setrlimit( RLIMIT_NOFILE, &limit ) == -1 ) throw SystemException( );
-         std::cout << "The file descriptor limit is successfully updated to "
-                   << recommendedFileDescriptorLimit << '.' << std::endl;
-         }
-      }
-
-   // Checks if the data directory exists.
-   if ( !std::filesystem::exists( config.dataDir ) )
-      {
-      std::cout << "The data directory " << config.dataDir << " does not exists.\n"
-                << "Do you want to create the directory? [Y/n]" << std::endl;
-      if ( isUserConfirmed( assumeYes ) )
-         {
-         std::filesystem::create_directories( config.dataDir );
-         std::cout << "The data directory is created at " << config.dataDir << "." << std::endl;
-         }
-      }
-
-   UniquePtr<Crawler> crawler;
-
-   // Checks if the checkpoint file has already existed.
-   if ( std::filesystem::exists( config.checkpointPath ) )
-      {
-      std::cout << "A checkpoint file is found at " << config.checkpointPath << ".\n"
-                << "Do you want to load the checkpoint file? [Y/n]" << std::endl;
-      if ( isUserConfirmed( assumeYes ) )
-         crawler = makeUnique<Crawler>( config.checkpointPath.string( ), config );
-      }
-
-   if ( crawler == nullptr )
-      {
-      Vector<Url> seedList;
-      std::ifstream seedFileStream( seedFile );
-      if ( !seedFileStream.is_open( ) ) throw IOException( "The seed file cannot be opened." );
-      for ( String line; std::getline( seedFileStream, line ); )
-         seedList.emplace_back( line );
-      crawler = makeUnique<Crawler>( seedList, config );
-      }
-
-   Vector<String> hosts;
-   std::ifstream hostnames( hostnameFile );
-   for ( String line; std::getline( hostnames, line ); )
-      hosts.emplace_back( line );
-   hostnames.close( );
-   auto const distributed = makeUnique<Distributed>( hosts, *crawler, serverID );
-
-   crawler->beginCrawl( numThreads );
-   std::cout << "The crawler has begun crawling. Press any key to stop the crawler..." << std::endl;
-   std::cin.ignore( std::numeric_limits<std::streamsize>::max( ) ), std::cin.get( );
-   }
-
-bool isUserConfirmed( bool assumeYes )
-   {
-   char response;
-   if ( !assumeYes ) std::cin >> response;
-   else response = 'y';
-   return toLower( response ) == 'y';
-   }
+#include <csignal>
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include "core/file_system.h"
+#include "core/io.h"
+#include "crawler/crawler.h"
+#include "distributed/distributed.h"
+
+enum class OptionName
+   {
+      AssumeYes,
+      SeedFile,
+      NumThreads,
+      LogPath,
+      DataDir,
+      CheckpointPath,
+      StatsRefreshInterval,
+      ExpectedNumUrls,
+      CheckpointInterval,
+      ServerID,
+      HostNamePath,
+      PolitenessGrouping,
+      PartitionGrouping,
+      LinkFilterPath,
+      RedirectCatalogPath,
+      ParseMode,
+      StrictParsing,
+      NearDuplicateDistance,
+      ExpandNearDuplicateLinks,
+      MaxSegmentSize,
+      GroupCommitSize,
+      ChecksumPages,
+      TermDictionary,
+      PageCompression,
+      CompressionThreads,
+      PageQueueSize,
+      ArchiveDir,
+      LinkGraphDir,
+      PageStream
+   };
+
+bool isUserConfirmed( bool assumeYes );
+
+HostGrouping parseHostGrouping( StringView value );
+
+ParseMode parseParseMode( StringView value );
+
+Compression parseCompression( StringView value );
+
+DnsEndPoint parseEndPoint( StringView value );
+
+int main( int argc, char **argv )
+   {
+   static const option options[] = {
+         { "assume_yes",             no_argument,       nullptr, static_cast<int>(OptionName::AssumeYes) },
+         { "seed_file",              required_argument, nullptr, static_cast<int>(OptionName::SeedFile) },
+         { "num_threads",            required_argument, nullptr, static_cast<int>(OptionName::NumThreads) },
+         { "log_path",               required_argument, nullptr, static_cast<int>(OptionName::LogPath) },
+         { "data_dir",               required_argument, nullptr, static_cast<int>(OptionName::DataDir) },
+         { "checkpoint_path",        required_argument, nullptr, static_cast<int>(OptionName::CheckpointPath) },
+         { "stats_refresh_interval", required_argument, nullptr, static_cast<int>(OptionName::StatsRefreshInterval) },
+         { "expected_num_urls",      required_argument, nullptr, static_cast<int>(OptionName::ExpectedNumUrls) },
+         { "checkpoint_interval",    required_argument, nullptr, static_cast<int>(OptionName::CheckpointInterval) },
+         { "serverID",               required_argument, nullptr, static_cast<int>(OptionName::ServerID) },
+         { "hostname_path",          required_argument, nullptr, static_cast<int>(OptionName::HostNamePath) },
+         { "politeness_grouping",    required_argument, nullptr, static_cast<int>(OptionName::PolitenessGrouping) },
+         { "partition_grouping",     required_argument, nullptr, static_cast<int>(OptionName::PartitionGrouping) },
+         { "link_filter_path",       required_argument, nullptr, static_cast<int>(OptionName::LinkFilterPath) },
+         { "redirect_catalog_path",  required_argument, nullptr, static_cast<int>(OptionName::RedirectCatalogPath) },
+         { "parse_mode",             required_argument, nullptr, static_cast<int>(OptionName::ParseMode) },
+         { "strict_parsing",         no_argument,       nullptr, static_cast<int>(OptionName::StrictParsing) },
+         { "near_duplicate_distance", required_argument, nullptr,
+               static_cast<int>(OptionName::NearDuplicateDistance) },
+         { "expand_near_duplicate_links", no_argument, nullptr,
+               static_cast<int>(OptionName::ExpandNearDuplicateLinks) },
+         { "max_segment_size",       required_argument, nullptr, static_cast<int>(OptionName::MaxSegmentSize) },
+         { "group_commit_size",      required_argument, nullptr, static_cast<int>(OptionName::GroupCommitSize) },
+         { "checksum_pages",         no_argument,       nullptr, static_cast<int>(OptionName::ChecksumPages) },
+         { "term_dictionary",        required_argument, nullptr, static_cast<int>(OptionName::TermDictionary) },
+         { "page_compression",       required_argument, nullptr, static_cast<int>(OptionName::PageCompression) },
+         { "compression_threads",    required_argument, nullptr, static_cast<int>(OptionName::CompressionThreads) },
+         { "page_queue_size",        required_argument, nullptr, static_cast<int>(OptionName::PageQueueSize) },
+         { "archive_dir",            required_argument, nullptr, static_cast<int>(OptionName::ArchiveDir) },
+         { "link_graph_dir",         required_argument, nullptr, static_cast<int>(OptionName::LinkGraphDir) },
+         { "page_stream",            required_argument, nullptr, static_cast<int>(OptionName::PageStream) },
+         { nullptr,                  no_argument,       nullptr, 0 }
+   };
+
+   bool assumeYes = false;
+   String seedFile, hostnameFile;
+   CrawlerConfiguration config;
+   int numThreads = 1;
+   int serverID;
+
+   int optionVal;
+   while ( ( optionVal = getopt_long_only( argc, argv, "", options, nullptr ) ) != -1 )
+      {
+      switch ( static_cast<OptionName>(optionVal) )
+         {
+         case OptionName::AssumeYes:
+            assumeYes = true;
+            break;
+         case OptionName::SeedFile:
+            seedFile = optarg;
+            break;
+         case OptionName::NumThreads:
+            numThreads = std::stoi( optarg );
+            break;
+         case OptionName::LogPath:
+            config.logPath = optarg;
+            break;
+         case OptionName::DataDir:
+            config.dataDir = optarg;
+            break;
+         case OptionName::CheckpointPath:
+            config.checkpointPath = optarg;
+            break;
+         case OptionName::StatsRefreshInterval:
+            config.statsRefreshInterval = std::stoi( optarg );
+            break;
+         case OptionName::ExpectedNumUrls:
+            config.expectedNumUrls = std::stoi( optarg );
+            break;
+         case OptionName::CheckpointInterval:
+            config.checkpointInterval = std::stoi( optarg );
+            break;
+         case OptionName::ServerID:
+            serverID = std::stoi( optarg );
+            break;
+         case OptionName::HostNamePath:
+            hostnameFile = optarg;
+            break;
+         case OptionName::PolitenessGrouping:
+            config.politenessGrouping = parseHostGrouping( optarg );
+            break;
+         case OptionName::PartitionGrouping:
+            if ( StringView( optarg ) != "url" ) config.partitionGrouping = parseHostGrouping( optarg );
+            else config.partitionGrouping.reset( );
+            break;
+         case OptionName::LinkFilterPath:
+            config.linkFilterPath = optarg;
+            break;
+         case OptionName::RedirectCatalogPath:
+            config.redirectCatalogPath = optarg;
+            break;
+         case OptionName::ParseMode:
+            config.parseMode = parseParseMode( optarg );
+            break;
+         case OptionName::StrictParsing:
+            config.recoversMalformedPages = false;
+            break;
+         case OptionName::NearDuplicateDistance:
+            config.nearDuplicates.maxDistance = std::stoi( optarg );
+            break;
+         case OptionName::ExpandNearDuplicateLinks:
+            config.nearDuplicates.expandsLinks = true;
+            break;
+         case OptionName::MaxSegmentSize:
+            config.pageStore.maxSegmentSize = std::stoull( optarg );
+            break;
+         case OptionName::GroupCommitSize:
+            config.pageStore.groupCommitSize = std::stoull( optarg );
+            break;
+         case OptionName::ChecksumPages:
+            config.checksumsPages = true;
+            break;
+         case OptionName::TermDictionary:
+            config.termDictionaryPath = optarg;
+            break;
+         case OptionName::PageCompression:
+            config.pageStore.compression = parseCompression( optarg );
+            break;
+         case OptionName::CompressionThreads:
+            config.pageStore.numCompressionThreads = std::stoi( optarg );
+            break;
+         case OptionName::PageQueueSize:
+            config.pageQueue.maxQueueSize = std::stoull( optarg );
+            break;
+         case OptionName::ArchiveDir:
+            config.archiveDir = optarg;
+            break;
+         case OptionName::LinkGraphDir:
+            config.linkGraphDir = optarg;
+            break;
+         case OptionName::PageStream:
+            config.pageStream = parseEndPoint( optarg );
+            break;
+         default:
+            throw ArgumentException( "The option is unrecognized." );
+         }
+      }
+   // A consumer of the page stream has no dictionary to map the term IDs of the records back to words.
+   if ( config.termDictionaryPath.has_value( ) && config.pageStream.has_value( ) )
+      throw ArgumentException( "The term dictionary cannot be used with a page stream." );
+
+   // Checks resource limits.
+   static constexpr auto recommendedFileDescriptorLimit = 65536;
+   rlimit limit{ };
+   if ( getrlimit( RLIMIT_NOFILE, &limit ) == -1 ) throw SystemException( );
+   if ( limit.rlim_cur < recommendedFileDescriptorLimit )
+      {
+      std::cout << "The resource limit for file descriptor number is too low (" << limit.rlim_cur << ").\n"
+                << "Do you want to increase the limit to " << recommendedFileDescriptorLimit << "? [Y/n]" << std::endl;
+      if ( isUserConfirmed( assumeYes ) )
+         {
+         limit.rlim_cur = recommendedFileDescriptorLimit;
+         if ( setrlimit( RLIMIT_NOFILE, &limit ) == -1 ) throw SystemException( );
+         std::cout << "The file descriptor limit is successfully updated to "
+                   << recommendedFileDescriptorLimit << '.' << std::endl;
+         }
+      }
+
+   // Checks if the data directory exists.
+   if ( !std::filesystem::exists( config.dataDir ) )
+      {
+      std::cout << "The data directory " << config.dataDir << " does not exists.\n"
+                << "Do you want to create the directory? [Y/n]" << std::endl;
+      if ( isUserConfirmed( assumeYes ) )
+         {
+         std::filesystem::create_directories( config.dataDir );
+         std::cout << "The data directory is created at " << config.dataDir << "." << std::endl;
+         }
+      }
+
+   UniquePtr<Crawler> crawler;
+
+   // Checks if the checkpoint file has already existed.
+   if ( std::filesystem::exists( config.checkpointPath ) )
+      {
+      std::cout << "A checkpoint file is found at " << config.checkpointPath << ".\n"
+                << "Do you want to load the checkpoint file? [Y/n]" << std::endl;
+      if ( isUserConfirmed( assumeYes ) )
+         crawler = makeUnique<Crawler>( config.checkpointPath.string( ), config );
+      }
+
+   if ( crawler == nullptr )
+      {
+      Vector<Url> seedList;
+      std::ifstream seedFileStream( seedFile );
+      if ( !seedFileStream.is_open( ) ) throw IOException( "The seed file cannot be opened." );
+      for ( String line; std::getline( seedFileStream, line ); )
+         seedList.emplace_back( line );
+      crawler = makeUnique<Crawler>( seedList, config );
+      }
+
+   Vector<String> hosts;
+   std::ifstream hostnames( hostnameFile );
+   for ( String line; std::getline( hostnames, line ); )
+      hosts.emplace_back( line );
+   hostnames.close( );
+   auto const distributed = makeUnique<Distributed>( hosts, *crawler, serverID );
+
+   // Reloads the link filter rules on SIGHUP.
+   std::signal( SIGHUP, [ ]( int )
+      { Crawler::requestLinkFilterReload( ); } );
+
+   crawler->beginCrawl( numThreads );
+   std::cout << "The crawler has begun crawling. Press any key to stop the crawler..." << std::endl;
+   std::cin.ignore( std::numeric_limits<std::streamsize>::max( ) ), std::cin.get( );
+   }
+
+bool isUserConfirmed( bool assumeYes )
+   {
+   char response;
+   if ( !assumeYes ) std::cin >> response;
+   else response = 'y';
+   return toLower( response ) == 'y';
+   }
+
+HostGrouping parseHostGrouping( StringView value )
+   {
+   if ( value == "host" ) return HostGrouping::Host;
+   if ( value == "domain" ) return HostGrouping::RegistrableDomain;
+   throw ArgumentException( "The host grouping is unrecognized." );
+   }
+
+ParseMode parseParseMode( StringView value )
+   {
+   if ( value == "full" ) return ParseMode::Full;
+   if ( value == "links" ) return ParseMode::LinksOnly;
+   if ( value == "anchors" ) return ParseMode::LinksWithAnchorText;
+   throw ArgumentException( "The parse mode is unrecognized." );
+   }
+
+Compression parseCompression( StringView value )
+   {
+   if ( value == "none" ) return Compression::None;
+   if ( value == "zlib" ) return Compression::Zlib;
+   if ( value == "zstd" ) return Compression::Zstd;
+   throw ArgumentException( "The compression is unrecognized." );
+   }
+
+DnsEndPoint parseEndPoint( StringView value )
+   {
+   const auto pos = value.rfind( ':' );
+   if ( pos == StringView::npos ) throw ArgumentException( "The end point is not host:port." );
+   return { String( value.substr( 0, pos ) ), std::stoi( String( value.substr( pos + 1 ) ) ) };
+   }
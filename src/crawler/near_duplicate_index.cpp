@@ -0,0 +1,68 @@
+#include <algorithm>
+
+#include "crawler/near_duplicate_index.h"
+#include "html_parser/sim_hash.h"
+
+NearDuplicateIndex::NearDuplicateIndex( const NearDuplicateIndexConfiguration &config ) :
+      _config( config ), _numBands( std::clamp( config.maxDistance + 1, 1, _maxNumBands ) )
+   {
+   _config.maxDistance = _numBands - 1;
+   _config.maxNumBuckets = std::max( config.maxNumBuckets, 1 );
+
+   // Splits the 64 bits as evenly as possible, since the narrowest band decides how crowded the buckets get.
+   for ( auto i = 0, shift = 0; i < _numBands; ++i )
+      {
+      const auto numBits = 64 / _numBands + ( i < 64 % _numBands );
+      _bands[ i ].shift = shift;
+      _bands[ i ].mask = numBits == 64 ? ~0ull : ( 1ull << numBits ) - 1;
+      shift += numBits;
+      }
+   }
+
+bool NearDuplicateIndex::findOrInsert( uint64_t fingerprint )
+   {
+   _numChecked.fetch_add( 1, std::memory_order_relaxed );
+
+   // Looks up one band at a time, so that threads checking other bands are not blocked. Two near-duplicates checked
+   // at the same time may both be inserted, which only costs a missed skip.
+   for ( auto i = 0; i < _numBands; ++i )
+      {
+      auto &band = _bands[ i ];
+      UniqueLock lock( band.mutex );
+      const auto bucket = band.buckets.find( fingerprint >> band.shift & band.mask );
+      if ( bucket != band.buckets.cend( ) &&
+           std::any_of( bucket->second.cbegin( ), bucket->second.cend( ), [ & ]( uint64_t indexed )
+              { return SimHash::distance( fingerprint, indexed ) <= _config.maxDistance; } ) )
+         {
+         _numDuplicates.fetch_add( 1, std::memory_order_relaxed );
+         return true;
+         }
+      }
+
+   for ( auto i = 0; i < _numBands; ++i )
+      {
+      auto &band = _bands[ i ];
+      UniqueLock lock( band.mutex );
+      const auto value = fingerprint >> band.shift & band.mask;
+      const auto [ bucket, isNew ] = band.buckets.try_emplace( value );
+      if ( bucket->second.size( ) >= static_cast<size_t>(_config.maxBucketSize) )
+         bucket->second.erase( bucket->second.begin( ) );
+      bucket->second.emplace_back( fingerprint );
+
+      // Forgets the oldest buckets, which the new bucket is not among, so that the table stays bounded.
+      if ( !isNew ) continue;
+      band.insertionOrder.push( value );
+      while ( band.insertionOrder.size( ) > static_cast<size_t>(_config.maxNumBuckets) )
+         {
+         band.buckets.erase( band.insertionOrder.front( ) );
+         band.insertionOrder.pop( );
+         }
+      }
+   return false;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const NearDuplicateIndex &nearDuplicateIndex )
+   {
+   return stream << "Near-duplicates: " << nearDuplicateIndex.numDuplicates( ) << '/'
+                 << nearDuplicateIndex.numChecked( );
+   }
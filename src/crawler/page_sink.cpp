@@ -0,0 +1,227 @@
+#include <algorithm>
+
+#include "core/file_system.h"
+#include "crawler/page_sink.h"
+
+SocketPageSink::SocketPageSink( StringView host, int port, const PageStreamConfiguration &config ) :
+      _host( host ), _port( port ), _config( config ),
+      _socket( AddressFamily::InterNetwork, SocketType::Stream, ProtocolType::Tcp )
+   {
+   connect( );
+   _senderThread = Thread( [ this ]( )
+                              { sendRecords( ); } );
+   }
+
+SocketPageSink::~SocketPageSink( )
+   {
+   try
+      { flush( ); }
+   catch ( ... )
+      { }
+
+   bool isDrained;
+      {
+      UniqueLock lock( _mutex );
+      _isClosing = true;
+      isDrained = _numSent >= _numPushed;
+      _recordPushed.notifyAll( );
+
+      // Unblocks a sender that waits on a consumer which stopped reading or granting credits.
+      if ( !isDrained ) ::shutdown( _socket.handle( ), SHUT_RDWR );
+      }
+   _senderThread.join( );
+   if ( !isDrained || !_isConnected ) return;
+
+   // Ends the stream, and waits for the consumer to close its end, since closing with unread credits would reset the
+   // connection before the consumer reads the end of the stream.
+   try
+      {
+      ::shutdown( _socket.handle( ), SHUT_WR );
+      _socket.setReceiveTimeout( 5 );
+      std::byte credits[ 64 ];
+      while ( _socket.receive( credits, sizeof( credits ) ) > 0 );
+      }
+   catch ( ... )
+      { }
+   }
+
+void SocketPageSink::write( String record )
+   {
+   UniqueLock lock( _mutex );
+   _recordsSent.wait( lock, [ & ]( )
+      { return _queueSize == 0 || _queueSize + record.size( ) <= _config.maxQueueSize; } );
+
+   _queueSize += record.size( );
+   _records.push( std::move( record ) );
+   ++_numPushed;
+   _recordPushed.notifyOne( );
+   }
+
+void SocketPageSink::flush( )
+   {
+   UniqueLock lock( _mutex );
+   const auto numPushed = _numPushed;
+   if ( !_recordsSent.waitFor( lock, std::chrono::milliseconds( _config.flushTimeout ), [ & ]( )
+      { return _numSent >= numPushed; } ) )
+      throw SocketException( ETIMEDOUT );
+   }
+
+void SocketPageSink::writeStatistics( std::ostream &stream ) const
+   {
+   UniqueLock lock( _mutex );
+   stream << "Stream queue: " << fileSizeToString( _queueSize ) << "\tCredit stalls: " << numCreditStalls( )
+          << "\tReconnects: " << numReconnects( );
+   }
+
+void SocketPageSink::connect( )
+   {
+   Socket socket( AddressFamily::InterNetwork, SocketType::Stream, ProtocolType::Tcp );
+   socket.connect( _host, _port );
+
+   UniqueLock lock( _mutex );
+   _socket = std::move( socket );
+   _isConnected = true;
+   _numCredits = 0;
+   }
+
+void SocketPageSink::sendRecords( )
+   {
+   String frames;
+   auto reconnectDelay = _config.minReconnectDelay;
+   while ( true )
+      {
+      uint64_t numTaken = 0;
+      try
+         {
+         UniqueLock lock( _mutex );
+         _recordPushed.wait( lock, [ & ]( )
+            { return !_records.empty( ) || _isClosing; } );
+         if ( _records.empty( ) || ( _isClosing && !_isConnected ) ) return;
+         lock.unlock( );
+
+         if ( !_isConnected ) connect( );
+         if ( _numCredits == 0 )
+            {
+            ++_numCreditStalls;
+            receiveCredits( );
+            }
+
+         // Frames as many queued records as there are credits, up to the send size but at least one record.
+         lock.lock( );
+         frames.clear( );
+         while ( !_records.empty( ) && numTaken < _numCredits &&
+                 ( numTaken == 0 || frames.size( ) + sizeof( uint32_t ) + _records.front( ).size( ) <=
+                                    _config.maxSendSize ) )
+            {
+            const auto length = IPAddress::hostToNetworkOrder( static_cast<uint32_t>(_records.front( ).size( )) );
+            frames.append( reinterpret_cast<const char *>(&length), sizeof( length ) ).append( _records.front( ) );
+            _queueSize -= _records.front( ).size( );
+            _records.pop( );
+            ++numTaken;
+            }
+         _numCredits -= numTaken;
+         lock.unlock( );
+
+         for ( size_t numSent = 0; numSent < frames.size( ); )
+            numSent += _socket.send( reinterpret_cast<const std::byte *>(frames.data( ) + numSent),
+                                     static_cast<int>(frames.size( ) - numSent), SocketFlags::NoSignal );
+
+         lock.lock( );
+         _numSent += numTaken;
+         _recordsSent.notifyAll( );
+         reconnectDelay = _config.minReconnectDelay;
+         }
+      catch ( ... )
+         {
+         // Counts the records of the failed send as sent, so that flushes do not wait for them, and reconnects after a
+         // delay that doubles with each failure, unless the sink is closing.
+         UniqueLock lock( _mutex );
+         _isConnected = false;
+         _numSent += numTaken;
+         _recordsSent.notifyAll( );
+         ++_numReconnects;
+         _recordPushed.waitFor( lock, std::chrono::milliseconds( reconnectDelay ), [ & ]( )
+            { return _isClosing; } );
+         reconnectDelay = std::min( reconnectDelay * 2, _config.maxReconnectDelay );
+         }
+      }
+   }
+
+void SocketPageSink::receiveCredits( )
+   {
+   uint32_t numCredits = 0;
+   auto *data = reinterpret_cast<std::byte *>(&numCredits);
+   for ( size_t numReceived = 0; numReceived < sizeof( numCredits ); )
+      {
+      const auto result = _socket.receive( data + numReceived, static_cast<int>(sizeof( numCredits ) - numReceived) );
+      if ( result == 0 ) throw SocketException( ECONNRESET );
+      numReceived += result;
+      }
+   _numCredits += IPAddress::networkToHostOrder( numCredits );
+   }
+
+PageStreamReceiver::PageStreamReceiver( int port, int window ) :
+      _listener( AddressFamily::InterNetwork, SocketType::Stream, ProtocolType::Tcp ), _window( std::max( window, 2 ) )
+   {
+   _listener.setSocketOption( SocketOptionLevel::Socket, SocketOptionName::ReuseAddress, true );
+   _listener.bind( IPEndPoint( IPAddress::any, port ) );
+   _listener.listen( 1 );
+
+   SocketAddress socketAddress{ };
+   socklen_t addressLength = sizeof( sockaddr_in );
+   if ( getsockname( _listener.handle( ), &socketAddress, &addressLength ) == -1 ) throw SocketException( );
+   _port = IPEndPoint::create( socketAddress ).port;
+   }
+
+bool PageStreamReceiver::receive( String &record )
+   {
+   if ( _isEnded ) return false;
+   if ( !_socket.has_value( ) )
+      {
+      _socket.emplace( _listener.accept( ) );
+      grantCredits( _window );
+      }
+   // Grants credits in batches of half the window for the records consumed since the last grant.
+   else if ( _numReceivedSinceGrant >= _window / 2 )
+      {
+      grantCredits( _numReceivedSinceGrant );
+      _numReceivedSinceGrant = 0;
+      }
+
+   uint32_t length = 0;
+   if ( !receiveAll( reinterpret_cast<char *>(&length), sizeof( length ) ) )
+      {
+      _socket.reset( );
+      _isEnded = true;
+      return false;
+      }
+   record.resize( IPAddress::networkToHostOrder( length ) );
+   if ( !receiveAll( record.data( ), record.size( ) ) )
+      throw FormatException( "The page stream ended in the middle of a frame." );
+   ++_numReceivedSinceGrant;
+   return true;
+   }
+
+bool PageStreamReceiver::receiveAll( char *data, size_t size )
+   {
+   for ( size_t numReceived = 0; numReceived < size; )
+      {
+      const auto result = _socket->receive( reinterpret_cast<std::byte *>(data + numReceived),
+                                            static_cast<int>(std::min<size_t>( size - numReceived, INT32_MAX )) );
+      if ( result == 0 )
+         {
+         if ( numReceived == 0 ) return false;
+         throw FormatException( "The page stream ended in the middle of a frame." );
+         }
+      numReceived += result;
+      }
+   return true;
+   }
+
+void PageStreamReceiver::grantCredits( uint32_t numCredits )
+   {
+   const auto message = IPAddress::hostToNetworkOrder( numCredits );
+   for ( size_t numSent = 0; numSent < sizeof( message ); )
+      numSent += _socket->send( reinterpret_cast<const std::byte *>(&message) + numSent,
+                                static_cast<int>(sizeof( message ) - numSent), SocketFlags::NoSignal );
+   }
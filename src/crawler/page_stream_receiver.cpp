@@ -0,0 +1,35 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "crawler/page_sink.h"
+#include "storage/page_record.h"
+
+// Receives the pages that a crawler started with `--page_stream host:port` streams, printing the URL and the number of
+// words of each page, and reports the receive throughput when the crawler ends the stream.
+// Usage: page_stream_receiver_cli <port>
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <port>" << std::endl;
+      return 1;
+      }
+
+   PageStreamReceiver receiver( std::stoi( argv[ 1 ] ) );
+   String record;
+   PageRecordView page;
+   long numPages = 0;
+   std::chrono::steady_clock::time_point beginTime;
+   while ( receiver.receive( record ) )
+      {
+      if ( numPages++ == 0 ) beginTime = std::chrono::steady_clock::now( );
+      PageRecord::decode( record, page );
+      std::cout << page.url << '\t' << page.words.size( ) << '\n';
+      }
+
+   const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   std::cerr << "Received " << numPages << " pages [" << std::fixed << std::setprecision( 1 )
+             << ( numPages > 0 ? numPages / seconds : 0.0 ) << " pages/s]." << std::endl;
+   }
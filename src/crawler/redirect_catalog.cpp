@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <optional>
+
+#include "crawler/redirect_catalog.h"
+
+namespace
+   {
+   StringView trim( StringView string )
+      {
+      const auto begin = std::min( string.find_first_not_of( " \t" ), string.size( ) );
+      return string.substr( begin, string.find_last_not_of( " \t" ) + 1 - begin );
+      }
+
+   // Parses the required `max-age` directive in seconds, which a header without is invalid.
+   std::optional<uint64_t> parseMaxAge( StringView header )
+      {
+      std::optional<uint64_t> maxAge;
+      while ( !header.empty( ) )
+         {
+         const auto end = std::min( header.find( ';' ), header.size( ) );
+         const auto directive = header.substr( 0, end );
+         header.remove_prefix( std::min( end + 1, header.size( ) ) );
+
+         const auto equals = directive.find( '=' );
+         const auto name = trim( directive.substr( 0, equals ) );
+         if ( equals == StringView::npos || !std::equal( name.cbegin( ), name.cend( ), "max-age", "max-age" + 7,
+                                                          [ ]( char a, char b ) { return toLower( a ) == b; } ) )
+            continue;
+         auto value = trim( directive.substr( equals + 1 ) );
+         if ( value.size( ) >= 2 && value.front( ) == '"' && value.back( ) == '"' )
+            value = value.substr( 1, value.size( ) - 2 );
+
+         // Caps a huge age rather than ignoring it, since it still asks for HTTPS.
+         uint64_t seconds;
+         const auto [ next, error ] = std::from_chars( value.data( ), value.data( ) + value.size( ), seconds );
+         if ( next != value.data( ) + value.size( ) || value.empty( ) ||
+              ( error != std::errc( ) && error != std::errc::result_out_of_range ) )
+            return std::nullopt;
+         maxAge = error == std::errc( ) ? seconds : std::numeric_limits<uint64_t>::max( );
+         }
+      return maxAge;
+      }
+   }
+
+void RedirectCatalog::addRedirect( const Url &url, const Url &redirectedUrl )
+   {
+   if ( url == redirectedUrl ) return;
+
+   // An upgrade of the scheme alone applies to the whole host, so it is remembered once per host.
+   if ( url.scheme( ) == "http" && redirectedUrl.scheme( ) == "https" && url.host( ) == redirectedUrl.host( ) &&
+        url.pathAndQuery( ) == redirectedUrl.pathAndQuery( ) )
+      {
+      addHttpsOnlyHost( url );
+      return;
+      }
+
+   UniqueLock lock( _mutex );
+   if ( !_redirects.insert_or_assign( url, redirectedUrl ).second ) return;
+   _insertionOrder.push( url );
+   while ( _insertionOrder.size( ) > _capacity )
+      {
+      _redirects.erase( _insertionOrder.front( ) );
+      _insertionOrder.pop( );
+      }
+   }
+
+void RedirectCatalog::addHttpsOnlyHost( const Url &url )
+   {
+   const auto hostId = url.hostId( );
+   UniqueLock lock( _mutex );
+   if ( hostId >= _isHttpsOnly.size( ) ) _isHttpsOnly.resize( HostTable::global( ).size( ), false );
+   _isHttpsOnly[ hostId ] = true;
+   }
+
+void RedirectCatalog::addStrictTransportSecurity( const Url &url, StringView header )
+   {
+   const auto maxAge = parseMaxAge( header );
+   if ( !maxAge.has_value( ) ) return;
+   if ( maxAge.value( ) > 0 )
+      {
+      addHttpsOnlyHost( url );
+      return;
+      }
+
+   const auto hostId = url.hostId( );
+   UniqueLock lock( _mutex );
+   if ( hostId < _isHttpsOnly.size( ) ) _isHttpsOnly[ hostId ] = false;
+   }
+
+Url RedirectCatalog::rewrite( const Url &url ) const
+   {
+   _numLookups.fetch_add( 1, std::memory_order_relaxed );
+   auto rewrittenUrl = url;
+
+   bool upgradesToHttps;
+      {
+      SharedLock lock( _mutex );
+      for ( auto i = 0; i < _maxNumHops; ++i )
+         {
+         const auto it = _redirects.find( rewrittenUrl );
+         if ( it == _redirects.cend( ) || it->second == url ) break;
+         rewrittenUrl = it->second;
+         if ( i == 0 ) _numRedirectHits.fetch_add( 1, std::memory_order_relaxed );
+         }
+      upgradesToHttps = rewrittenUrl.scheme( ) == "http" && rewrittenUrl.port( ) == 80 && isHttpsOnly( rewrittenUrl );
+      }
+
+   if ( upgradesToHttps )
+      {
+      _numHttpsUpgrades.fetch_add( 1, std::memory_order_relaxed );
+      return Url( STRING( "https://" << rewrittenUrl.host( ) << rewrittenUrl.pathAndQuery( ) ) );
+      }
+   return rewrittenUrl;
+   }
+
+std::istream &operator>>( std::istream &stream, RedirectCatalog &redirectCatalog )
+   {
+   size_t numRedirects, numHttpsOnlyHosts;
+   stream >> numRedirects;
+   for ( size_t i = 0; i < numRedirects; ++i )
+      {
+      Url url, redirectedUrl;
+      stream >> url >> redirectedUrl;
+      if ( !stream ) throw FormatException( "The redirect catalog is malformed." );
+      redirectCatalog.addRedirect( url, redirectedUrl );
+      }
+   stream >> numHttpsOnlyHosts;
+   for ( size_t i = 0; i < numHttpsOnlyHosts; ++i )
+      {
+      String host;
+      stream >> host;
+      if ( !stream ) throw FormatException( "The redirect catalog is malformed." );
+      redirectCatalog.addHttpsOnlyHost( Url( STRING( "http://" << host << '/' ) ) );
+      }
+   return stream;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const RedirectCatalog &redirectCatalog )
+   {
+   SharedLock lock( redirectCatalog._mutex );
+
+   // Writes the redirects oldest first, so that loading them keeps the eviction order.
+   auto insertionOrder = redirectCatalog._insertionOrder;
+   stream << redirectCatalog._redirects.size( ) << '\n';
+   for ( ; !insertionOrder.empty( ); insertionOrder.pop( ) )
+      if ( const auto it = redirectCatalog._redirects.find( insertionOrder.front( ) );
+            it != redirectCatalog._redirects.cend( ) )
+         stream << it->first << ' ' << it->second << '\n';
+
+   const auto &isHttpsOnly = redirectCatalog._isHttpsOnly;
+   stream << std::count( isHttpsOnly.cbegin( ), isHttpsOnly.cend( ), true ) << '\n';
+   for ( HostId hostId = 0; hostId < isHttpsOnly.size( ); ++hostId )
+      if ( isHttpsOnly[ hostId ] ) stream << HostTable::global( ).hostOf( hostId ) << '\n';
+   return stream;
+   }
+
+void RedirectCatalog::writeStatistics( std::ostream &stream ) const
+   {
+   const auto numLookups = std::max( _numLookups.load( std::memory_order_relaxed ), 1l );
+   stream << "Redirect hits: " << 100 * _numRedirectHits.load( std::memory_order_relaxed ) / numLookups
+          << "%\tHTTPS upgrades: " << 100 * _numHttpsUpgrades.load( std::memory_order_relaxed ) / numLookups << '%';
+   }
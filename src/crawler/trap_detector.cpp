@@ -0,0 +1,169 @@
+#include <algorithm>
+
+#include "crawler/trap_detector.h"
+
+TrapDetector::TrapDetector( const TrapDetectorConfiguration &config ) :
+      _config( config ),
+      _seenUrls( config.expectedNumUrls, _filterFalsePositiveRate ),
+      _seenContents( config.expectedNumPages, _filterFalsePositiveRate )
+   {
+   _config.maxPathDepth = std::min( _config.maxPathDepth, _maxPathDepth );
+   _config.maxTrackedPatterns = std::max( _config.maxTrackedPatterns, 1 );
+   _config.pageWindow = std::max( _config.pageWindow, 2 * _config.minPagesChecked );
+   _config.probeInterval = std::max( _config.probeInterval, 1 );
+   _patternStates.resize( _config.maxTrackedPatterns );
+   }
+
+TrapSignal TrapDetector::inspect( const Url &url )
+   {
+   if ( const auto signal = inspectPath( url.localPath( ) ); signal != TrapSignal::None )
+      return flag( signal );
+
+   const auto urlHash = Hash<Url>( )( url );
+   const auto patternHash = getPatternHash( url );
+   // Finds the host rather than interning it, since only a host that pages were fetched from has counts.
+   const auto hostId = HostTable::global( ).find( url.host( ) );
+
+   UniqueLock lock( _mutex );
+   const auto isNewUrl = !_seenUrls.contains( urlHash );
+   if ( isNewUrl ) _seenUrls.insert( urlHash );
+
+   // Checks if the pages of the host are mostly duplicates.
+   if ( hostId.has_value( ) && hostId.value( ) < _hostStates.size( ) && isBlocked( _hostStates[ hostId.value( ) ] ) )
+      return flag( TrapSignal::HostGrowth );
+
+   // Counts the variants of the host and path pattern. A new URL of another pattern in the same slot wears down the
+   // count of the pattern in it, and takes over the slot once the count reaches 0, so that frequent patterns stay.
+   auto &patternState = _patternStates[ patternHash % _patternStates.size( ) ];
+   if ( patternState.patternHash != patternHash )
+      {
+      if ( !isNewUrl ) return TrapSignal::None;
+      if ( patternState.numUrls > 0 )
+         {
+         --patternState.numUrls;
+         return TrapSignal::None;
+         }
+      patternState = { .patternHash = patternHash, .numUrls = 0, .pageCounts = { } };
+      }
+   if ( isNewUrl ) ++patternState.numUrls;
+
+   // Checks if the pattern has exploded into many variants whose pages are mostly duplicates.
+   if ( patternState.numUrls > _config.maxVariantsPerPattern && isBlocked( patternState.pageCounts ) )
+      return flag( TrapSignal::ParameterExplosion );
+
+   return TrapSignal::None;
+   }
+
+void TrapDetector::recordContent( const Url &url, size_t contentHash )
+   { recordPage( url, contentHash, false ); }
+
+void TrapDetector::recordNearDuplicate( const Url &url )
+   { recordPage( url, 0, true ); }
+
+std::ostream &operator<<( std::ostream &stream, const TrapDetector &trapDetector )
+   {
+   return stream << "Traps: depth " << trapDetector.numFlagged( TrapSignal::PathDepth )
+                 << ", repeat " << trapDetector.numFlagged( TrapSignal::RepeatingSegments )
+                 << ", params " << trapDetector.numFlagged( TrapSignal::ParameterExplosion )
+                 << ", growth " << trapDetector.numFlagged( TrapSignal::HostGrowth );
+   }
+
+TrapSignal TrapDetector::inspectPath( StringView localPath ) const noexcept
+   {
+   std::array<StringView, _maxPathDepth> segments;
+   auto depth = 0;
+   for ( size_t beginPos = 0, endPos; beginPos < localPath.size( ); beginPos = endPos + 1 )
+      {
+      if ( ( endPos = localPath.find( '/', beginPos ) ) == StringView::npos ) endPos = localPath.size( );
+      const auto segment = localPath.substr( beginPos, endPos - beginPos );
+      if ( segment.empty( ) ) continue;
+
+      if ( depth == _config.maxPathDepth ) return TrapSignal::PathDepth;
+      if ( std::count( segments.cbegin( ), segments.cbegin( ) + depth, segment ) >= _config.maxSegmentOccurrences )
+         return TrapSignal::RepeatingSegments;
+      segments[ depth++ ] = segment;
+      }
+   return TrapSignal::None;
+   }
+
+size_t TrapDetector::getPatternHash( const Url &url )
+   {
+   // FNV-1a over the hash of the host, the local path with digit runs collapsed, and the query parameter names.
+   auto hashValue = 14695981039346656037ull ^ Hash<StringView>( )( url.host( ) );
+   const auto append = [ & ]( char c )
+      { hashValue = ( hashValue ^ static_cast<unsigned char>(c) ) * 1099511628211ull; };
+
+   auto isInDigits = false;
+   for ( const auto c : url.localPath( ) )
+      {
+      const auto isDigit = std::isdigit( static_cast<unsigned char>(c) ) != 0;
+      if ( !isDigit ) append( c );
+      else if ( !isInDigits ) append( '#' );
+      isInDigits = isDigit;
+      }
+
+   append( '?' );
+   auto isInValue = false;
+   for ( const auto c : url.query( ) )
+      {
+      if ( c == '&' ) isInValue = false;
+      else if ( c == '=' ) isInValue = true;
+      if ( !isInValue ) append( c );
+      }
+
+   return hashValue;
+   }
+
+void TrapDetector::recordPage( const Url &url, size_t contentHash, bool isNearDuplicate )
+   {
+   const auto hostId = url.hostId( );
+   const auto patternHash = getPatternHash( url );
+
+   UniqueLock lock( _mutex );
+   auto isDuplicate = isNearDuplicate;
+   if ( !isDuplicate )
+      {
+      const auto key = contentHash ^ ( static_cast<size_t>(hostId) * 0x9e3779b97f4a7c15ull );
+      isDuplicate = _seenContents.contains( key );
+      if ( !isDuplicate ) _seenContents.insert( key );
+      }
+
+   // Counts the page toward its host and pattern, and halves the counts at the end of each window, so that the ratio
+   // follows the recent pages.
+   const auto count = [ & ]( PageCounts &pageCounts )
+      {
+      ++pageCounts.numPages;
+      if ( isDuplicate ) ++pageCounts.numDuplicatePages;
+      if ( pageCounts.numPages >= _config.pageWindow )
+         {
+         pageCounts.numPages /= 2;
+         pageCounts.numDuplicatePages /= 2;
+         }
+      };
+   if ( hostId >= _hostStates.size( ) ) _hostStates.resize( HostTable::global( ).size( ) );
+   count( _hostStates[ hostId ] );
+   if ( auto &patternState = _patternStates[ patternHash % _patternStates.size( ) ];
+        patternState.patternHash == patternHash )
+      count( patternState.pageCounts );
+   }
+
+bool TrapDetector::isTrap( const PageCounts &pageCounts ) const noexcept
+   {
+   return pageCounts.numPages >= _config.minPagesChecked &&
+          pageCounts.numDuplicatePages > _config.maxDuplicateRatio * pageCounts.numPages;
+   }
+
+bool TrapDetector::isBlocked( PageCounts &pageCounts ) const noexcept
+   {
+   if ( !isTrap( pageCounts ) ) return false;
+   // Lets a probe through now and then, whose page can show that the trap yields new content again.
+   if ( ++pageCounts.numBlockedUrls < _config.probeInterval ) return true;
+   pageCounts.numBlockedUrls = 0;
+   return false;
+   }
+
+TrapSignal TrapDetector::flag( TrapSignal signal ) noexcept
+   {
+   _numFlagged[ static_cast<int>(signal) ].fetch_add( 1, std::memory_order_relaxed );
+   return signal;
+   }
@@ -1,430 +1,466 @@
-#include <algorithm>
-
-#include "html_parser/html_parser.h"
-
-TagInfo TagInfo::parse( StringView tagString )
-   {
-   if ( tagString.size( ) < 2 )
-      throw FormatException( "The tag is malformed." );
-
-   TagInfo tagInfo;
-   auto begin = tagString.cbegin( ), end = tagString.cend( );
-   if ( *( begin + 1 ) != '/' && *( end - 2 ) != '/' )
-      {
-      tagInfo.type = TagType::Opening;
-      begin++, end--;
-      }
-   else if ( *( begin + 1 ) == '/' && *( end - 2 ) != '/' )
-      {
-      tagInfo.type = TagType::Closing;
-      begin += 2, end--;
-      }
-   else if ( *( begin + 1 ) != '/' && *( end - 2 ) == '/' )
-      {
-      tagInfo.type = TagType::SelfClosing;
-      begin++, end -= 2;
-      }
-   else throw FormatException( "The tag is malformed." );
-
-   const auto nameEnd = std::find_if( begin, end, [ ]( char c )
-      { return std::isspace( c ); } );
-   tagInfo.name = String( begin, nameEnd );
-   for ( auto &c : tagInfo.name ) c = toLower( c );
-   tagInfo._params = String( nameEnd, end );
-
-   return tagInfo;
-   }
-
-std::optional<String> TagInfo::valueOf( StringView param ) const
-   {
-   auto beginPos = _params.find( param );
-   if ( beginPos == StringView::npos ) return std::nullopt;
-   if ( ( beginPos += param.size( ) + 1 ) >= _params.size( ) ) return std::nullopt;
-   if ( _params.at( beginPos ) == '\'' || _params.at( beginPos ) == '"' ) ++beginPos;
-   const auto endPos = _params.find_first_of( "'\"", beginPos );
-   return _params.substr( beginPos, endPos - beginPos );
-   }
-
-String TagInfo::getClosingTagString( ) const
-   {
-   if ( type != TagType::Opening )
-      throw InvalidOperationException( "The tag is not an opening tag." );
-   return STRING( "</" << name << ">" );
-   }
-
-std::istream &operator>>( std::istream &stream, LinkInfo &linkInfo )
-   {
-   int numAnchorWords;
-   stream >> linkInfo.url >> numAnchorWords;
-   linkInfo.anchorWords.reserve( numAnchorWords );
-   for ( auto i = 0; i < numAnchorWords; ++i )
-      {
-      String word;
-      stream >> word;
-      linkInfo.anchorWords.emplace_back( std::move( word ) );
-      }
-   return stream;
-   }
-
-std::ostream &operator<<( std::ostream &stream, const LinkInfo &linkInfo )
-   {
-   stream << linkInfo.url << '\n'
-          << linkInfo.anchorWords.size( ) << ' ';
-   for ( const auto &word: linkInfo.anchorWords ) stream << word << ' ';
-   return stream;
-   }
-
-std::istream &operator>>( std::istream &stream, HtmlInfo &htmlInfo )
-   {
-   int numWords;
-   stream >> numWords;
-   htmlInfo.words.reserve( numWords );
-   for ( auto i = 0; i < numWords; ++i )
-      {
-      String word;
-      stream >> word;
-      htmlInfo.words.emplace_back( std::move( word ) );
-      }
-
-   int numTitleWords;
-   stream >> numTitleWords;
-   htmlInfo.titleWords.reserve( numTitleWords );
-   for ( auto i = 0; i < numTitleWords; ++i )
-      {
-      String word;
-      stream >> word;
-      htmlInfo.titleWords.emplace_back( std::move( word ) );
-      }
-
-   int numLinks;
-   stream >> numLinks;
-   for ( auto i = 0; i < numTitleWords; ++i )
-      {
-      LinkInfo linkInfo;
-      stream >> linkInfo;
-      htmlInfo.links.emplace_back( std::move( linkInfo ) );
-      }
-
-   bool hasBase;
-   stream >> hasBase;
-   if ( hasBase )
-      {
-      Url base;
-      stream >> base;
-      htmlInfo.base = base;
-      }
-
-   return stream;
-   }
-
-std::ostream &operator<<( std::ostream &stream, const HtmlInfo &htmlInfo )
-   {
-   stream << htmlInfo.words.size( ) << ' ';
-   for ( const auto &word: htmlInfo.words ) stream << word << ' ';
-   stream << '\n' << htmlInfo.titleWords.size( ) << ' ';
-   for ( const auto &word: htmlInfo.titleWords ) stream << word << ' ';
-   stream << '\n' << htmlInfo.links.size( ) << '\n';
-   for ( const auto &linkInfo: htmlInfo.links ) stream << linkInfo << '\n';
-   stream << std::boolalpha << htmlInfo.base.has_value( );
-   if ( htmlInfo.base.has_value( ) ) stream << ' ' << htmlInfo.base.value( );
-   return stream;
-   }
-
-HtmlInfo HtmlParser::parse( StringView htmlString ) const
-   {
-   HtmlInfo htmlInfo;
-   LinkInfo *currentLinkInfo = nullptr;
-
-   for ( auto beginPos = 0, endPos = beginPos; beginPos != StringView::npos; beginPos = endPos )
-      {
-      // Focuses the view on the text before a tag.
-      endPos = htmlString.find( '<', beginPos );
-
-      // Tokenizes the text before a tag.
-      auto words = tokenize( htmlString.substr( beginPos, endPos - beginPos ) );
-      if ( currentLinkInfo != nullptr )
-         std::copy( words.cbegin( ), words.cend( ), std::back_inserter( currentLinkInfo->anchorWords ) );
-      std::move( words.begin( ), words.end( ), std::back_inserter( htmlInfo.words ) );
-
-      // Focuses the view on a tag.
-      if ( ( beginPos = endPos ) == StringView::npos ) break;
-      endPos = htmlString.find( '>', beginPos );
-      if ( endPos++ == StringView::npos )
-         throw FormatException( "A closing angle bracket is missing." );
-
-      // Parses the tag.
-      const auto tagInfo = TagInfo::parse( htmlString.substr( beginPos, endPos - beginPos ) );
-      const auto tagAction = _actionMap.contains( tagInfo.name ) ? _actionMap.at( tagInfo.name ) : TagAction::Discard;
-      if ( tagInfo.type == TagType::Opening )
-         switch ( tagAction )
-            {
-            case TagAction::Anchor: // Parses the link in the anchor tag.
-               if ( auto urlString = tagInfo.valueOf( "href" );
-                     urlString.has_value( ) && preprocessUrlString( urlString.value( ) ) )
-                  {
-                  try
-                     {
-                     Url url( urlString.value( ) );
-                     if ( linkFilter( url, tagInfo ) )
-                        {
-                        htmlInfo.links.emplace_back( std::move( url ) );
-                        currentLinkInfo = &htmlInfo.links.back( );
-                        }
-                     }
-                  catch ( ... )
-                     { }
-                  }
-               break;
-            case TagAction::Base: // Parses the base URL.
-               if ( auto urlString = tagInfo.valueOf( "href" );
-                     urlString.has_value( ) && preprocessUrlString( urlString.value( ) ) &&
-                     !htmlInfo.base.has_value( ) )
-                  {
-                  try
-                     { htmlInfo.base.emplace( urlString.value( ) ); }
-                  catch ( ... )
-                     { }
-                  }
-               break;
-            case TagAction::Discard: // Discards the tag.
-               break;
-            case TagAction::DiscardElement: // Advances the view past the element.
-               {
-               const auto closingTagString = tagInfo.getClosingTagString( );
-               beginPos = endPos;
-               if ( ( endPos = htmlString.find( closingTagString, beginPos ) ) == StringView::npos )
-                  throw FormatException( "A closing tag is missing" );
-               endPos += closingTagString.size( );
-               break;
-               }
-            case TagAction::Embed: // Parses the link in the embed tag.
-               if ( auto urlString = tagInfo.valueOf( "src" );
-                     urlString.has_value( ) && preprocessUrlString( urlString.value( ) ) )
-                  {
-                  try
-                     {
-                     Url url( urlString.value( ) );
-                     if ( linkFilter( url, tagInfo ) )
-                        htmlInfo.links.emplace_back( std::move( url ) );
-                     }
-                  catch ( ... )
-                     { }
-                  }
-               break;
-            case TagAction::Title: // Tokenizes the text in the title element and advances the view past it.
-               {
-               const auto closingTagString = tagInfo.getClosingTagString( );
-               beginPos = endPos;
-               if ( ( endPos = htmlString.find( closingTagString, beginPos ) ) == StringView::npos )
-                  throw FormatException( "A closing tag is missing" );
-
-               words = tokenize( htmlString.substr( beginPos, endPos - beginPos ) );
-               std::move( words.begin( ), words.end( ), std::back_inserter( htmlInfo.titleWords ) );
-
-               endPos += closingTagString.size( );
-               break;
-               }
-            }
-      else if ( tagInfo.type == TagType::Closing )
-         {
-         if ( tagAction == TagAction::Anchor ) // Stops adding anchor words to the current link.
-            currentLinkInfo = nullptr;
-         }
-      else if ( tagInfo.type == TagType::SelfClosing )
-         {
-         if ( tagAction == TagAction::Base ) // Parses the base URL.
-            {
-            if ( auto urlString = tagInfo.valueOf( "href" );
-                  urlString.has_value( ) && preprocessUrlString( urlString.value( ) ) &&
-                  !htmlInfo.base.has_value( ) )
-               try
-                  { htmlInfo.base.emplace( urlString.value( ) ); }
-               catch ( ... )
-                  { }
-            }
-         }
-      }
-
-   return htmlInfo;
-   }
-
-Vector<String> HtmlParser::tokenize( StringView string )
-   {
-   Vector<String> tokens;
-   std::istringstream stream( String{ string } );
-   String token;
-   while ( stream >> token )
-      if ( preprocessToken( token ) )
-         tokens.emplace_back( std::move( token ) );
-   return tokens;
-   }
-
-bool HtmlParser::preprocessToken( String &token )
-   {
-   const auto begin = std::find_if( token.cbegin( ), token.cend( ), [ ]( char c )
-      { return std::isalnum( c ); } );
-   if ( begin == token.cend( ) ) return false;
-   const auto end = std::find_if( token.crbegin( ), token.crend( ), [ ]( char c )
-      { return std::isalnum( c ); } ).base( );
-   token = String( begin, end );
-   for ( auto &c : token ) c = toLower( c );
-   return true;
-   }
-
-bool HtmlParser::preprocessUrlString( String &urlString )
-   {
-   if ( std::any_of( urlString.cbegin( ), urlString.cend( ), [ ]( char c )
-      { return std::isspace( c ); } ) )
-      return false;
-
-   if ( const auto pos = urlString.find( '#' ); pos != String::npos )
-      {
-      if ( pos == 0 ) return false;
-      urlString = urlString.substr( 0, pos );
-      }
-   return true;
-   }
-
-const HashMap<StringView, HtmlParser::TagAction> HtmlParser::_actionMap = {
-      { "!--",        TagAction::Discard },
-      { "!doctype",   TagAction::Discard },
-      { "a",          TagAction::Anchor },
-      { "abbr",       TagAction::Discard },
-      { "acronym",    TagAction::Discard },
-      { "address",    TagAction::Discard },
-      { "applet",     TagAction::Discard },
-      { "area",       TagAction::Discard },
-      { "article",    TagAction::Discard },
-      { "aside",      TagAction::Discard },
-      { "audio",      TagAction::Discard },
-      { "b",          TagAction::Discard },
-      { "base",       TagAction::Base },
-      { "basefont",   TagAction::Discard },
-      { "bdi",        TagAction::Discard },
-      { "bdo",        TagAction::Discard },
-      { "bgsound",    TagAction::Discard },
-      { "big",        TagAction::Discard },
-      { "blink",      TagAction::Discard },
-      { "blockquote", TagAction::Discard },
-      { "body",       TagAction::Discard },
-      { "br",         TagAction::Discard },
-      { "button",     TagAction::Discard },
-      { "canvas",     TagAction::Discard },
-      { "caption",    TagAction::Discard },
-      { "center",     TagAction::Discard },
-      { "cite",       TagAction::Discard },
-      { "code",       TagAction::Discard },
-      { "col",        TagAction::Discard },
-      { "colgroup",   TagAction::Discard },
-      { "content",    TagAction::Discard },
-      { "data",       TagAction::Discard },
-      { "datalist",   TagAction::Discard },
-      { "dd",         TagAction::Discard },
-      { "del",        TagAction::Discard },
-      { "details",    TagAction::Discard },
-      { "dfn",        TagAction::Discard },
-      { "dialog",     TagAction::Discard },
-      { "dir",        TagAction::Discard },
-      { "div",        TagAction::Discard },
-      { "dl",         TagAction::Discard },
-      { "dt",         TagAction::Discard },
-      { "em",         TagAction::Discard },
-      { "embed",      TagAction::Embed },
-      { "fieldset",   TagAction::Discard },
-      { "figcaption", TagAction::Discard },
-      { "figure",     TagAction::Discard },
-      { "font",       TagAction::Discard },
-      { "footer",     TagAction::Discard },
-      { "form",       TagAction::Discard },
-      { "frame",      TagAction::Discard },
-      { "frameset",   TagAction::Discard },
-      { "h1",         TagAction::Discard },
-      { "h2",         TagAction::Discard },
-      { "h3",         TagAction::Discard },
-      { "h4",         TagAction::Discard },
-      { "h5",         TagAction::Discard },
-      { "h6",         TagAction::Discard },
-      { "head",       TagAction::Discard },
-      { "header",     TagAction::Discard },
-      { "hgroup",     TagAction::Discard },
-      { "hr",         TagAction::Discard },
-      { "html",       TagAction::Discard },
-      { "i",          TagAction::Discard },
-      { "iframe",     TagAction::Discard },
-      { "img",        TagAction::Discard },
-      { "input",      TagAction::Discard },
-      { "ins",        TagAction::Discard },
-      { "isindex",    TagAction::Discard },
-      { "kbd",        TagAction::Discard },
-      { "keygen",     TagAction::Discard },
-      { "label",      TagAction::Discard },
-      { "legend",     TagAction::Discard },
-      { "li",         TagAction::Discard },
-      { "link",       TagAction::Discard },
-      { "listing",    TagAction::Discard },
-      { "main",       TagAction::Discard },
-      { "map",        TagAction::Discard },
-      { "mark",       TagAction::Discard },
-      { "marquee",    TagAction::Discard },
-      { "menu",       TagAction::Discard },
-      { "menuitem",   TagAction::Discard },
-      { "meta",       TagAction::Discard },
-      { "meter",      TagAction::Discard },
-      { "nav",        TagAction::Discard },
-      { "nobr",       TagAction::Discard },
-      { "noframes",   TagAction::Discard },
-      { "noscript",   TagAction::Discard },
-      { "object",     TagAction::Discard },
-      { "ol",         TagAction::Discard },
-      { "optgroup",   TagAction::Discard },
-      { "option",     TagAction::Discard },
-      { "output",     TagAction::Discard },
-      { "p",          TagAction::Discard },
-      { "param",      TagAction::Discard },
-      { "picture",    TagAction::Discard },
-      { "plaintext",  TagAction::Discard },
-      { "pre",        TagAction::Discard },
-      { "progress",   TagAction::Discard },
-      { "q",          TagAction::Discard },
-      { "rp",         TagAction::Discard },
-      { "rt",         TagAction::Discard },
-      { "rtc",        TagAction::Discard },
-      { "ruby",       TagAction::Discard },
-      { "s",          TagAction::Discard },
-      { "samp",       TagAction::Discard },
-      { "script",     TagAction::DiscardElement },
-      { "section",    TagAction::Discard },
-      { "select",     TagAction::Discard },
-      { "shadow",     TagAction::Discard },
-      { "slot",       TagAction::Discard },
-      { "small",      TagAction::Discard },
-      { "source",     TagAction::Discard },
-      { "spacer",     TagAction::Discard },
-      { "span",       TagAction::Discard },
-      { "strike",     TagAction::Discard },
-      { "strong",     TagAction::Discard },
-      { "style",      TagAction::DiscardElement },
-      { "sub",        TagAction::Discard },
-      { "summary",    TagAction::Discard },
-      { "sup",        TagAction::Discard },
-      { "svg",        TagAction::DiscardElement },
-      { "table",      TagAction::Discard },
-      { "tbody",      TagAction::Discard },
-      { "td",         TagAction::Discard },
-      { "template",   TagAction::Discard },
-      { "textarea",   TagAction::Discard },
-      { "tfoot",      TagAction::Discard },
-      { "th",         TagAction::Discard },
-      { "thead",      TagAction::Discard },
-      { "time",       TagAction::Discard },
-      { "title",      TagAction::Title },
-      { "tr",         TagAction::Discard },
-      { "track",      TagAction::Discard },
-      { "tt",         TagAction::Discard },
-      { "u",          TagAction::Discard },
-      { "ul",         TagAction::Discard },
-      { "var",        TagAction::Discard },
-      { "video",      TagAction::Discard },
-      { "wbr",        TagAction::Discard },
-      { "xmp",        TagAction::Discard },
-};
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "html_parser/html_parser.h"
+
+TagInfo TagInfo::parse( StringView tagString )
+   {
+   if ( tagString.size( ) < 2 )
+      throw FormatException( "The tag is malformed." );
+
+   TagInfo tagInfo;
+   auto begin = tagString.cbegin( ), end = tagString.cend( );
+   if ( *( begin + 1 ) != '/' && *( end - 2 ) != '/' )
+      {
+      tagInfo.type = TagType::Opening;
+      begin++, end--;
+      }
+   else if ( *( begin + 1 ) == '/' && *( end - 2 ) != '/' )
+      {
+      tagInfo.type = TagType::Closing;
+      begin += 2, end--;
+      }
+   else if ( *( begin + 1 ) != '/' && *( end - 2 ) == '/' )
+      {
+      tagInfo.type = TagType::SelfClosing;
+      begin++, end -= 2;
+      }
+   else throw FormatException( "The tag is malformed." );
+
+   // Indexes the name and the attributes, where names end at whitespace, `/`, or `=`, and values are quoted or end at
+   // whitespace.
+   const auto isSpace = [ ]( char c )
+      { return std::isspace( static_cast<unsigned char>(c) ) != 0; };
+   const auto nameEnd = std::find_if( begin, end, [ & ]( char c )
+      { return isSpace( c ) || c == '/'; } );
+   tagInfo.name = String( begin, nameEnd );
+   for ( auto &c : tagInfo.name ) c = toLower( c );
+
+   for ( auto it = nameEnd; tagInfo._numAttributes < maxNumAttributes; )
+      {
+      while ( it != end && ( isSpace( *it ) || *it == '/' ) ) ++it;
+      if ( it == end ) break;
+      const auto attributeBegin = it;
+      while ( it != end && !isSpace( *it ) && *it != '/' && *it != '=' ) ++it;
+      if ( it == attributeBegin ) // Skips a stray `=`, which does not begin an attribute name.
+         {
+         ++it;
+         continue;
+         }
+      auto &attribute = tagInfo._attributes[ tagInfo._numAttributes++ ];
+      attribute = { StringView( attributeBegin, it ), { } };
+
+      const auto equals = std::find_if_not( it, end, isSpace );
+      if ( equals == end || *equals != '=' ) continue;
+      it = std::find_if_not( equals + 1, end, isSpace );
+      if ( it == end ) break;
+      if ( *it == '"' || *it == '\'' )
+         {
+         const auto quote = *it++;
+         const auto valueEnd = std::find( it, end, quote );
+         attribute.value = StringView( it, valueEnd );
+         it = valueEnd + ( valueEnd != end );
+         }
+      else
+         {
+         const auto valueEnd = std::find_if( it, end, isSpace );
+         attribute.value = StringView( it, valueEnd );
+         it = valueEnd;
+         }
+      }
+
+   return tagInfo;
+   }
+
+std::optional<StringView> TagInfo::valueOf( StringView attributeName ) const noexcept
+   {
+   for ( const auto &attribute : attributes( ) )
+      if ( attribute.name.size( ) == attributeName.size( ) &&
+           std::equal( attributeName.cbegin( ), attributeName.cend( ), attribute.name.cbegin( ),
+                       [ ]( char lhs, char rhs )
+                          { return lhs == toLower( rhs ); } ) )
+         return attribute.value;
+   return std::nullopt;
+   }
+
+String TagInfo::getClosingTagString( ) const
+   {
+   if ( type != TagType::Opening )
+      throw InvalidOperationException( "The tag is not an opening tag." );
+   return STRING( "</" << name << ">" );
+   }
+
+RobotsDirectives RobotsDirectives::parse( StringView directives ) noexcept
+   {
+   const auto isNone = HtmlParser::hasToken( directives, "none" );
+   return { .isNoIndex = isNone || HtmlParser::hasToken( directives, "noindex" ),
+            .isNoFollow = isNone || HtmlParser::hasToken( directives, "nofollow" ) };
+   }
+
+RobotsDirectives RobotsDirectives::parseHeaders( StringView headers, StringView userAgent ) noexcept
+   {
+   static constexpr std::array<StringView, 4> valueDirectives = {
+         "unavailable_after", "max-snippet", "max-image-preview", "max-video-preview" };
+   const auto equalsIgnoringCase = [ ]( StringView lhs, StringView rhs )
+      {
+      return lhs.size( ) == rhs.size( ) && std::equal( lhs.cbegin( ), lhs.cend( ), rhs.cbegin( ), [ ]( char l, char r )
+         { return toLower( l ) == toLower( r ); } );
+      };
+   userAgent = userAgent.substr( 0, userAgent.find_first_of( "/ " ) );
+
+   RobotsDirectives robots;
+   for ( size_t beginPos = 0, endPos; beginPos < headers.size( ); beginPos = endPos + 1 )
+      {
+      endPos = std::min( headers.find( '\n', beginPos ), headers.size( ) );
+      auto directives = headers.substr( beginPos, endPos - beginPos );
+
+      // A first token that ends with a colon names a user agent, unless it is a directive with a value, e.g.
+      // `unavailable_after: 25 Jun 2010`.
+      const auto nameBeginPos = std::min( directives.find_first_not_of( " \t" ), directives.size( ) );
+      const auto colonPos = directives.find( ':' );
+      if ( colonPos != StringView::npos )
+         {
+         const auto name = directives.substr( nameBeginPos, colonPos - nameBeginPos );
+         if ( name.find_first_of( ", \t" ) == StringView::npos &&
+              std::none_of( valueDirectives.cbegin( ), valueDirectives.cend( ), [ & ]( StringView valueDirective )
+                 { return equalsIgnoringCase( name, valueDirective ); } ) )
+            {
+            if ( !equalsIgnoringCase( name, userAgent ) ) continue;
+            directives = directives.substr( colonPos + 1 );
+            }
+         }
+      robots |= parse( directives );
+      }
+   return robots;
+   }
+
+std::istream &operator>>( std::istream &stream, LinkInfo &linkInfo )
+   {
+   int numAnchorWords;
+   stream >> linkInfo.url >> numAnchorWords;
+   linkInfo.anchorWords.reserve( numAnchorWords );
+   for ( auto i = 0; i < numAnchorWords; ++i )
+      {
+      String word;
+      stream >> word;
+      linkInfo.anchorWords.emplace_back( std::move( word ) );
+      }
+   return stream;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const LinkInfo &linkInfo )
+   {
+   stream << linkInfo.url << '\n'
+          << linkInfo.anchorWords.size( ) << ' ';
+   for ( const auto &word: linkInfo.anchorWords ) stream << word << ' ';
+   return stream;
+   }
+
+std::istream &operator>>( std::istream &stream, HtmlInfo &htmlInfo )
+   {
+   int numWords;
+   stream >> numWords;
+   htmlInfo.words.reserve( numWords );
+   for ( auto i = 0; i < numWords; ++i )
+      {
+      String word;
+      stream >> word;
+      htmlInfo.words.emplace_back( std::move( word ) );
+      }
+
+   int numTitleWords;
+   stream >> numTitleWords;
+   htmlInfo.titleWords.reserve( numTitleWords );
+   for ( auto i = 0; i < numTitleWords; ++i )
+      {
+      String word;
+      stream >> word;
+      htmlInfo.titleWords.emplace_back( std::move( word ) );
+      }
+
+   int numLinks;
+   stream >> numLinks;
+   htmlInfo.links.reserve( numLinks );
+   for ( auto i = 0; i < numLinks; ++i )
+      {
+      LinkInfo linkInfo;
+      stream >> linkInfo;
+      htmlInfo.links.emplace_back( std::move( linkInfo ) );
+      }
+
+   bool hasBase;
+   stream >> std::boolalpha >> hasBase;
+   if ( hasBase )
+      {
+      Url base;
+      stream >> base;
+      htmlInfo.base = base;
+      }
+
+   return stream;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const HtmlInfo &htmlInfo )
+   {
+   stream << htmlInfo.words.size( ) << ' ';
+   for ( const auto &word: htmlInfo.words ) stream << word << ' ';
+   stream << '\n' << htmlInfo.titleWords.size( ) << ' ';
+   for ( const auto &word: htmlInfo.titleWords ) stream << word << ' ';
+   stream << '\n' << htmlInfo.links.size( ) << '\n';
+   for ( const auto &linkInfo: htmlInfo.links ) stream << linkInfo << '\n';
+   stream << std::boolalpha << htmlInfo.base.has_value( );
+   if ( htmlInfo.base.has_value( ) ) stream << ' ' << htmlInfo.base.value( );
+   return stream;
+   }
+
+HtmlInfo HtmlInfoView::toHtmlInfo( ) const
+   {
+   HtmlInfo htmlInfo;
+   htmlInfo.words.assign( words.cbegin( ), words.cend( ) );
+   htmlInfo.titleWords.assign( titleWords.cbegin( ), titleWords.cend( ) );
+   htmlInfo.links.reserve( links.size( ) );
+   for ( const auto &linkInfo : links )
+      {
+      const auto anchorWords = anchorWordsOf( linkInfo );
+      auto &copiedLinkInfo = htmlInfo.links.emplace_back( linkInfo.url );
+      copiedLinkInfo.anchorWords.assign( anchorWords.begin( ), anchorWords.end( ) );
+      copiedLinkInfo.isNoFollow = linkInfo.isNoFollow;
+      }
+   htmlInfo.base = base;
+   htmlInfo.canonical = canonical;
+   htmlInfo.robots = robots;
+   htmlInfo.numErrors = numErrors;
+   htmlInfo.simHash = simHash;
+   return htmlInfo;
+   }
+
+void HtmlInfoView::clear( ) noexcept
+   {
+   words.clear( );
+   titleWords.clear( );
+   links.clear( );
+   base.reset( );
+   canonical.reset( );
+   robots = { };
+   numErrors = 0;
+   simHash = 0;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const HtmlInfoView &htmlInfo )
+   {
+   stream << htmlInfo.words.size( ) << ' ';
+   for ( const auto word: htmlInfo.words ) stream << word << ' ';
+   stream << '\n' << htmlInfo.titleWords.size( ) << ' ';
+   for ( const auto word: htmlInfo.titleWords ) stream << word << ' ';
+   stream << '\n' << htmlInfo.links.size( ) << '\n';
+   for ( const auto &linkInfo: htmlInfo.links )
+      {
+      stream << linkInfo.url << '\n' << linkInfo.numAnchorWords << ' ';
+      for ( const auto word: htmlInfo.anchorWordsOf( linkInfo ) ) stream << word << ' ';
+      stream << '\n';
+      }
+   stream << std::boolalpha << htmlInfo.base.has_value( );
+   if ( htmlInfo.base.has_value( ) ) stream << ' ' << htmlInfo.base.value( );
+   return stream;
+   }
+
+HtmlInfo HtmlParser::parse( StringView htmlString, ParseMode mode ) const
+   {
+   PageArena arena;
+   return parse( htmlString, arena, mode ).toHtmlInfo( );
+   }
+
+/// Collects the parsed information as owned strings, for chunks that do not outlive the call.
+struct HtmlParser::OwningSink
+   {
+   public:
+      HtmlInfo &htmlInfo;
+      int &currentLink;
+      SimHash &simHash;
+      const std::function<bool( const Url &, const TagInfo & )> &linkFilter;
+
+      [[nodiscard]] bool filterLink( const Url &url, const TagInfo &tagInfo ) const
+         { return linkFilter( url, tagInfo ); }
+
+      void addWord( StringView word )
+         {
+         htmlInfo.words.emplace_back( word );
+         simHash.add( word );
+         if ( currentLink != -1 ) htmlInfo.links[ currentLink ].anchorWords.emplace_back( word );
+         }
+
+      void addTitleWord( StringView word )
+         { htmlInfo.titleWords.emplace_back( word ); }
+
+      void addLink( Url url, bool isAnchor, bool isNoFollow )
+         {
+         if ( isAnchor ) currentLink = static_cast<int>(htmlInfo.links.size( ));
+         htmlInfo.links.emplace_back( std::move( url ) ).isNoFollow = isNoFollow;
+         }
+
+      void closeAnchor( )
+         { currentLink = -1; }
+
+      [[nodiscard]] bool isInAnchor( ) const
+         { return currentLink != -1; }
+
+      [[nodiscard]] bool hasBase( ) const
+         { return htmlInfo.base.has_value( ); }
+
+      void setBase( Url url )
+         { htmlInfo.base.emplace( std::move( url ) ); }
+
+      [[nodiscard]] bool hasCanonical( ) const
+         { return htmlInfo.canonical.has_value( ); }
+
+      void setCanonical( Url url )
+         { htmlInfo.canonical.emplace( std::move( url ) ); }
+
+      void addRobots( const RobotsDirectives &robots )
+         { htmlInfo.robots |= robots; }
+
+      void addError( )
+         { ++htmlInfo.numErrors; }
+   };
+
+const HtmlInfoView &HtmlParser::parse( StringView htmlString, PageArena &arena, ParseMode mode ) const
+   {
+   ViewSink sink{ arena._htmlInfo, linkFilter, -1, { } };
+   return parseInto( htmlString, arena, mode, sink );
+   }
+
+void HtmlStreamParser::feed( StringView chunk )
+   {
+   // Lowercases only the new bytes, since the unparsed tail of the previous chunks is already lowercase.
+   const auto numUnparsedBytes = _buffer.size( );
+   _buffer.append( chunk );
+   _lowercaseBuffer.resize( _buffer.size( ) );
+   HtmlTokenizer::copyToLower( chunk, _lowercaseBuffer.data( ) + numUnparsedBytes );
+
+   HtmlParser::OwningSink sink{ _htmlInfo, _currentLink, _simHash, _htmlParser.linkFilter };
+   const auto numParsedBytes =
+         _htmlParser.parseChunk<ParseMode::Full>( _buffer, _lowercaseBuffer, false, _state, sink );
+   _buffer.erase( 0, numParsedBytes );
+   _lowercaseBuffer.erase( 0, numParsedBytes );
+   }
+
+HtmlInfo HtmlStreamParser::finish( )
+   {
+   auto htmlInfo = std::move( _htmlInfo );
+   auto state = std::move( _state );
+   auto currentLink = std::exchange( _currentLink, -1 );
+   auto simHash = _simHash;
+   _htmlInfo = { }, _state = { }, _simHash.clear( );
+
+   HtmlParser::OwningSink sink{ htmlInfo, currentLink, simHash, _htmlParser.linkFilter };
+   try
+      { _htmlParser.parseChunk<ParseMode::Full>( _buffer, _lowercaseBuffer, true, state, sink ); }
+   catch ( ... )
+      {
+      _buffer.clear( ), _lowercaseBuffer.clear( );
+      throw;
+      }
+   _buffer.clear( ), _lowercaseBuffer.clear( );
+   htmlInfo.simHash = simHash.fingerprint( );
+   return htmlInfo;
+   }
+
+size_t HtmlParser::findIgnoreCase( StringView string, StringView lowercasePattern, size_t pos ) noexcept
+   {
+   for ( pos = string.find( lowercasePattern.front( ), pos ); pos != StringView::npos;
+         pos = string.find( lowercasePattern.front( ), pos + 1 ) )
+      if ( string.size( ) - pos >= lowercasePattern.size( ) &&
+           std::equal( lowercasePattern.cbegin( ), lowercasePattern.cend( ), string.cbegin( ) + pos,
+                       [ ]( char lhs, char rhs )
+                          { return lhs == toLower( rhs ); } ) )
+         return pos;
+   return StringView::npos;
+   }
+
+bool HtmlParser::preprocessUrlString( StringView &urlString ) noexcept
+   {
+   if ( std::any_of( urlString.cbegin( ), urlString.cend( ), [ ]( char c )
+      { return std::isspace( static_cast<unsigned char>(c) ); } ) )
+      return false;
+
+   if ( const auto pos = urlString.find( '#' ); pos != StringView::npos )
+      {
+      if ( pos == 0 ) return false;
+      urlString = urlString.substr( 0, pos );
+      }
+   return true;
+   }
+
+HtmlParser::TagAction HtmlParser::getTagAction( StringView tagString ) noexcept
+   {
+   // Focuses the view on the tag name.
+   const size_t beginPos = tagString.size( ) > 1 && tagString[ 1 ] == '/' ? 2 : 1;
+   auto endPos = beginPos;
+   while ( endPos < tagString.size( ) && !std::isspace( static_cast<unsigned char>(tagString[ endPos ]) ) &&
+           tagString[ endPos ] != '/' && tagString[ endPos ] != '>' )
+      ++endPos;
+   const auto name = tagString.substr( beginPos, endPos - beginPos );
+
+   // Matches the names with actions by length and then by bytes; every other tag is discarded. Setting the case bit
+   // lowercases letters, and cannot turn another byte into a lowercase letter.
+   const auto matches = [ name ]( StringView lowercaseName )
+      {
+      for ( size_t i = 0; i < lowercaseName.size( ); ++i )
+         if ( ( name[ i ] | 0x20 ) != lowercaseName[ i ] ) return false;
+      return true;
+      };
+   switch ( name.size( ) )
+      {
+      case 1:
+         return matches( "a" ) ? TagAction::Anchor : TagAction::Discard;
+      case 3:
+         return matches( "svg" ) ? TagAction::DiscardElement : TagAction::Discard;
+      case 4:
+         switch ( name[ 0 ] | 0x20 )
+            {
+            case 'b':
+               return matches( "base" ) ? TagAction::Base : TagAction::Discard;
+            case 'l':
+               return matches( "link" ) ? TagAction::Link : TagAction::Discard;
+            case 'm':
+               return matches( "meta" ) ? TagAction::Meta : TagAction::Discard;
+            default:
+               return TagAction::Discard;
+            }
+      case 5:
+         switch ( name[ 0 ] | 0x20 )
+            {
+            case 'e':
+               return matches( "embed" ) ? TagAction::Embed : TagAction::Discard;
+            case 's':
+               return matches( "style" ) ? TagAction::DiscardElement : TagAction::Discard;
+            case 't':
+               return matches( "title" ) ? TagAction::Title : TagAction::Discard;
+            default:
+               return TagAction::Discard;
+            }
+      case 6:
+         return matches( "script" ) ? TagAction::DiscardElement : TagAction::Discard;
+      default:
+         return TagAction::Discard;
+      }
+   }
+
+bool HtmlParser::hasToken( StringView tokens, StringView lowercaseToken ) noexcept
+   {
+   // Splits at whitespace and commas, e.g. `rel="nofollow noopener"` and `content="noindex, nofollow"`.
+   const auto isSeparator = [ ]( char c )
+      { return c == ',' || std::isspace( static_cast<unsigned char>(c) ); };
+   for ( size_t beginPos = 0, endPos; beginPos < tokens.size( ); beginPos = endPos + 1 )
+      {
+      endPos = beginPos;
+      while ( endPos < tokens.size( ) && !isSeparator( tokens[ endPos ] ) ) ++endPos;
+      if ( endPos - beginPos == lowercaseToken.size( ) &&
+           std::equal( lowercaseToken.cbegin( ), lowercaseToken.cend( ), tokens.cbegin( ) + beginPos,
+                       [ ]( char lhs, char rhs )
+                          { return lhs == toLower( rhs ); } ) )
+         return true;
+      }
+   return false;
+   }
@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <fcntl.h>
+#include <fstream>
+#include <queue>
+#include <unistd.h>
+
+#include "indexer/inverted_index.h"
+
+namespace
+   {
+   void appendVarint( String &data, uint64_t value )
+      {
+      for ( ; value >= 0x80; value >>= 7 ) data += static_cast<char>(value | 0x80);
+      data += static_cast<char>(value);
+      }
+
+   uint64_t readVarint( const char *&data, const char *end )
+      {
+      uint64_t value = 0;
+      for ( auto shift = 0; shift < 64; shift += 7 )
+         {
+         if ( data == end ) throw FormatException( "The index is truncated." );
+         const auto byte = static_cast<uint8_t>(*data++);
+         value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+         if ( !( byte & 0x80 ) ) return value;
+         }
+      throw FormatException( "The index has an overlong varint." );
+      }
+
+   // Reads a varint from a stream, or returns `false` if the stream ends before it starts.
+   bool readVarint( std::istream &stream, uint64_t &value )
+      {
+      value = 0;
+      for ( auto shift = 0; shift < 64; shift += 7 )
+         {
+         const auto byte = stream.get( );
+         if ( byte == std::istream::traits_type::eof( ) )
+            {
+            if ( shift == 0 ) return false;
+            throw FormatException( "The run is truncated." );
+            }
+         value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+         if ( !( byte & 0x80 ) ) return true;
+         }
+      throw FormatException( "The run has an overlong varint." );
+      }
+
+   uint64_t readFixed( const char *data ) noexcept
+      {
+      uint64_t value = 0;
+      for ( auto i = 0; i < 8; ++i ) value |= static_cast<uint64_t>(static_cast<uint8_t>(data[ i ])) << i * 8;
+      return value;
+      }
+
+   void appendFixed( String &data, uint64_t value )
+      {
+      for ( auto i = 0; i < 8; ++i ) data += static_cast<char>(value >> i * 8);
+      }
+
+   String readFile( const std::filesystem::path &path )
+      {
+      std::ifstream file( path, std::ios::binary );
+      if ( !file.is_open( ) ) throw IOException( STRING( "The file " << path << " cannot be opened." ) );
+      String data( std::istreambuf_iterator<char>( file ), { } );
+      if ( file.bad( ) ) throw IOException( STRING( "The file " << path << " cannot be read." ) );
+      return data;
+      }
+
+   void writeFile( const std::filesystem::path &path, StringView data )
+      {
+      std::ofstream file( path, std::ios::binary | std::ios::trunc );
+      file.write( data.data( ), static_cast<std::streamsize>(data.size( )) );
+      file.flush( );
+      if ( !file ) throw IOException( STRING( "The file " << path << " cannot be written." ) );
+      }
+
+   // Syncs a file, or the entries of a directory, to disk.
+   void syncPath( const std::filesystem::path &path )
+      {
+      const auto file = ::open( path.c_str( ), O_RDONLY );
+      if ( file == -1 ) throw SystemException( );
+      const auto result = ::fsync( file );
+      const auto error = errno;
+      ::close( file );
+      if ( result == -1 ) throw SystemException( error );
+      }
+
+   // Reads the posting lists of a run one term at a time, in the order of the terms.
+   class RunReader
+      {
+      public:
+         explicit RunReader( const std::filesystem::path &path ) : _stream( path, std::ios::binary )
+            {
+            if ( !_stream.is_open( ) ) throw IOException( STRING( "The run " << path << " cannot be opened." ) );
+            }
+
+         // Reads the next posting list, or returns `false` at the end of the run.
+         bool next( )
+            {
+            uint64_t termSize, dataSize;
+            if ( !readVarint( _stream, termSize ) ) return false;
+            term.resize( termSize );
+            _stream.read( term.data( ), static_cast<std::streamsize>(termSize) );
+            if ( !readVarint( _stream, numDocs ) || !readVarint( _stream, lastDocId ) ||
+                 !readVarint( _stream, dataSize ) )
+               throw FormatException( "The run is truncated." );
+            data.resize( dataSize );
+            _stream.read( data.data( ), static_cast<std::streamsize>(dataSize) );
+            if ( !_stream ) throw FormatException( "The run is truncated." );
+            return true;
+            }
+
+         String term, data;
+         uint64_t numDocs = 0;
+         DocId lastDocId = 0;
+
+      private:
+         std::ifstream _stream;
+      };
+   }
+
+IndexWriter::IndexWriter( std::filesystem::path directory, const IndexWriterConfiguration &config,
+                          const TermDictionary *termDictionary ) :
+      _directory( std::move( directory ) ), _config( config ), _termDictionary( termDictionary )
+   {
+   std::filesystem::create_directories( _directory );
+   // Deletes the runs and the partial segment files of a writer that stopped before committing.
+   for ( const auto &entry : std::filesystem::directory_iterator( _directory ) )
+      if ( entry.path( ).extension( ) == ".tmp" ) std::filesystem::remove( entry.path( ) );
+
+   while ( std::filesystem::exists( termsPath( _directory, _numSegments ) ) ) ++_numSegments;
+   if ( _numSegments > 0 )
+      {
+      std::ifstream termsFile( termsPath( _directory, _numSegments - 1 ), std::ios::binary );
+      char header[ _headerSize ];
+      if ( !termsFile.read( header, _headerSize ) ) throw FormatException( "The segment header is truncated." );
+      _firstDocId = _nextDocId = readFixed( header + 8 );
+      }
+   }
+
+IndexWriter::~IndexWriter( )
+   {
+   try
+      { commit( ); }
+   catch ( ... )
+      { }
+   }
+
+void IndexWriter::add( DocId docId, std::span<const StringView> words, std::span<const StringView> titleWords )
+   {
+   if ( docId < _nextDocId )
+      throw ArgumentException( "The documents must be added in ascending order of their IDs." );
+
+   _wordIds.clear( );
+   for ( const auto word : words ) _wordIds.push_back( _terms.intern( word ) );
+   _titleWordIds.clear( );
+   for ( const auto word : titleWords ) _titleWordIds.push_back( _terms.intern( word ) );
+   addTermIds( docId, _wordIds, _titleWordIds );
+   }
+
+void IndexWriter::add( DocId docId, std::span<const TermId> wordIds, std::span<const TermId> titleWordIds )
+   {
+   if ( _termDictionary == nullptr ) throw InvalidOperationException( "The index writer has no term dictionary." );
+   if ( docId < _nextDocId )
+      throw ArgumentException( "The documents must be added in ascending order of their IDs." );
+
+   // Maps the IDs of the dictionary to the IDs of the writer, interning each term once.
+   const auto mapTermIds = [ & ]( std::span<const TermId> termIds, Vector<TermId> &mappedTermIds )
+      {
+      mappedTermIds.clear( );
+      for ( const auto termId : termIds )
+         {
+         if ( termId >= _termIds.size( ) )
+            {
+            if ( termId >= _termDictionary->size( ) )
+               throw ArgumentException( "The term ID is not in the term dictionary." );
+            _termIds.resize( _termDictionary->size( ), _noTermId );
+            }
+         if ( _termIds[ termId ] == _noTermId ) _termIds[ termId ] = _terms.intern( _termDictionary->term( termId ) );
+         mappedTermIds.push_back( _termIds[ termId ] );
+         }
+      };
+   mapTermIds( wordIds, _wordIds );
+   mapTermIds( titleWordIds, _titleWordIds );
+   addTermIds( docId, _wordIds, _titleWordIds );
+   }
+
+void IndexWriter::addTermIds( DocId docId, std::span<const TermId> wordIds, std::span<const TermId> titleWordIds )
+   {
+   // Groups the occurrences by term and field, with the positions of each group in ascending order.
+   _occurrences.clear( );
+   for ( size_t i = 0; i < wordIds.size( ); ++i )
+      _occurrences.push_back( { wordIds[ i ], 0, static_cast<uint32_t>(i) } );
+   for ( size_t i = 0; i < titleWordIds.size( ); ++i )
+      _occurrences.push_back( { titleWordIds[ i ], 1, static_cast<uint32_t>(i) } );
+   std::sort( _occurrences.begin( ), _occurrences.end( ) );
+
+   for ( auto it = _occurrences.cbegin( ); it != _occurrences.cend( ); )
+      {
+      const auto termId = it->termId;
+      auto [ postingList, isNew ] = _postingLists.try_emplace( termId );
+      auto &[ data, numDocs, lastDocId ] = postingList->second;
+      const auto oldSize = data.size( );
+      appendVarint( data, docId - lastDocId );
+      for ( auto field = 0; field < 2; ++field )
+         {
+         const auto fieldEnd = std::find_if( it, _occurrences.cend( ), [ & ]( const Occurrence &occurrence )
+            { return occurrence.termId != termId || occurrence.field != field; } );
+         appendVarint( data, fieldEnd - it );
+         uint32_t previousPosition = 0;
+         for ( ; it != fieldEnd; ++it )
+            {
+            appendVarint( data, it->position - previousPosition );
+            previousPosition = it->position;
+            }
+         }
+      ++numDocs;
+      lastDocId = docId;
+      _memorySize += data.size( ) - oldSize + ( isNew ? _termOverhead : 0 );
+      }
+   _nextDocId = docId + 1;
+
+   if ( _memorySize >= _config.maxMemorySize ) flushRun( );
+   }
+
+void IndexWriter::commit( )
+   {
+   if ( _nextDocId == _firstDocId ) return;
+   if ( !_postingLists.empty( ) ) flushRun( );
+
+   // Merges the runs term by term, and concatenates the posting lists of a term in run order, which is document order.
+   Vector<UniquePtr<RunReader>> runs;
+   using Head = std::pair<StringView, int>;
+   std::priority_queue<Head, Vector<Head>, std::greater<>> heads;
+   for ( auto run = 0; run < _numRuns; ++run )
+      {
+      runs.emplace_back( makeUnique<RunReader>( runPath( _directory, run ) ) );
+      if ( runs.back( )->next( ) ) heads.emplace( runs.back( )->term, run );
+      }
+
+   String terms, postings;
+   appendFixed( terms, _firstDocId );
+   appendFixed( terms, _nextDocId );
+   std::ofstream postingsFile( postingsPath( _directory, _numSegments ).concat( ".tmp" ),
+                               std::ios::binary | std::ios::trunc );
+   String term;
+   while ( !heads.empty( ) )
+      {
+      term = heads.top( ).first;
+      uint64_t numDocs = 0;
+      DocId lastDocId = 0;
+      postings.clear( );
+      while ( !heads.empty( ) && heads.top( ).first == term )
+         {
+         const auto runIndex = heads.top( ).second;
+         auto &run = *runs[ runIndex ];
+         heads.pop( );
+         // Turns the first document ID of the run, which is a gap from 0, into a gap from the previous run.
+         const auto *current = run.data.data( ), *end = current + run.data.size( );
+         const auto firstDocId = readVarint( current, end );
+         appendVarint( postings, firstDocId - lastDocId );
+         postings.append( current, end );
+         numDocs += run.numDocs;
+         lastDocId = run.lastDocId;
+         if ( run.next( ) ) heads.emplace( run.term, runIndex );
+         }
+      appendVarint( terms, term.size( ) );
+      terms.append( term );
+      appendVarint( terms, numDocs );
+      appendVarint( terms, postings.size( ) );
+      postingsFile.write( postings.data( ), static_cast<std::streamsize>(postings.size( )) );
+      }
+   postingsFile.flush( );
+   if ( !postingsFile ) throw IOException( "The segment postings cannot be written." );
+   postingsFile.close( );
+   writeFile( termsPath( _directory, _numSegments ).concat( ".tmp" ), terms );
+
+   // Syncs the files before renaming them, so that a crash cannot leave a renamed segment with lost data, and then the
+   // directory, so that the renames themselves are durable.
+   syncPath( postingsPath( _directory, _numSegments ).concat( ".tmp" ) );
+   syncPath( termsPath( _directory, _numSegments ).concat( ".tmp" ) );
+   std::filesystem::rename( postingsPath( _directory, _numSegments ).concat( ".tmp" ),
+                            postingsPath( _directory, _numSegments ) );
+   std::filesystem::rename( termsPath( _directory, _numSegments ).concat( ".tmp" ),
+                            termsPath( _directory, _numSegments ) );
+   syncPath( _directory );
+   runs.clear( );
+   for ( auto run = 0; run < _numRuns; ++run ) std::filesystem::remove( runPath( _directory, run ) );
+   ++_numSegments;
+   _numRuns = 0;
+   _firstDocId = _nextDocId;
+   }
+
+void IndexWriter::flushRun( )
+   {
+   Vector<std::pair<StringView, const PostingList *>> postingLists;
+   postingLists.reserve( _postingLists.size( ) );
+   for ( const auto &[ termId, postingList ] : _postingLists )
+      postingLists.emplace_back( _terms.term( termId ), &postingList );
+   std::sort( postingLists.begin( ), postingLists.end( ), [ ]( const auto &lhs, const auto &rhs )
+      { return lhs.first < rhs.first; } );
+
+   std::ofstream runFile( runPath( _directory, _numRuns ), std::ios::binary | std::ios::trunc );
+   String header;
+   for ( const auto &[ term, postingList ] : postingLists )
+      {
+      const auto &postings = *postingList;
+      header.clear( );
+      appendVarint( header, term.size( ) );
+      header.append( term );
+      appendVarint( header, postings.numDocs );
+      appendVarint( header, postings.lastDocId );
+      appendVarint( header, postings.data.size( ) );
+      runFile.write( header.data( ), static_cast<std::streamsize>(header.size( )) );
+      runFile.write( postings.data.data( ), static_cast<std::streamsize>(postings.data.size( )) );
+      }
+   runFile.flush( );
+   if ( !runFile ) throw IOException( "The run cannot be written." );
+
+   ++_numRuns;
+   _postingLists.clear( );
+   _memorySize = 0;
+   }
+
+std::filesystem::path IndexWriter::runPath( const std::filesystem::path &directory, int run )
+   { return directory / STRING( "run-" << run << ".tmp" ); }
+
+std::filesystem::path IndexWriter::termsPath( const std::filesystem::path &directory, int segment )
+   { return directory / STRING( "segment-" << segment << ".terms" ); }
+
+std::filesystem::path IndexWriter::postingsPath( const std::filesystem::path &directory, int segment )
+   { return directory / STRING( "segment-" << segment << ".postings" ); }
+
+IndexReader::IndexReader( const std::filesystem::path &directory )
+   {
+   auto numSegments = 0;
+   while ( std::filesystem::exists( IndexWriter::termsPath( directory, numSegments ) ) ) ++numSegments;
+   // Reserves the segments, so that the views of their terms never move.
+   _segments.reserve( numSegments );
+   for ( auto i = 0; i < numSegments; ++i )
+      {
+      auto &segment = _segments.emplace_back( );
+      segment.terms = readFile( IndexWriter::termsPath( directory, i ) );
+      segment.postings = readFile( IndexWriter::postingsPath( directory, i ) );
+      if ( segment.terms.size( ) < IndexWriter::_headerSize )
+         throw FormatException( "The segment header is truncated." );
+      segment.firstDocId = readFixed( segment.terms.data( ) );
+      segment.endDocId = readFixed( segment.terms.data( ) + 8 );
+
+      const auto *current = segment.terms.data( ) + IndexWriter::_headerSize;
+      const auto *end = segment.terms.data( ) + segment.terms.size( );
+      uint64_t offset = 0;
+      while ( current != end )
+         {
+         const auto termSize = readVarint( current, end );
+         if ( termSize > static_cast<uint64_t>(end - current) ) throw FormatException( "The index is truncated." );
+         const StringView term( current, termSize );
+         current += termSize;
+         const auto numDocs = readVarint( current, end );
+         const auto size = readVarint( current, end );
+         segment.termEntries.push_back( { term, numDocs, offset, size } );
+         offset += size;
+         }
+      if ( offset != segment.postings.size( ) )
+         throw FormatException( "The segment terms do not match its postings." );
+      }
+   }
+
+uint64_t IndexReader::numPostings( ) const noexcept
+   {
+   uint64_t numPostings = 0;
+   for ( const auto &segment : _segments )
+      for ( const auto &termEntry : segment.termEntries ) numPostings += termEntry.numDocs;
+   return numPostings;
+   }
+
+uint64_t IndexReader::numBytes( ) const noexcept
+   {
+   uint64_t numBytes = 0;
+   for ( const auto &segment : _segments ) numBytes += segment.postings.size( );
+   return numBytes;
+   }
+
+void IndexReader::postings( StringView term, Vector<Posting> &postings ) const
+   {
+   postings.clear( );
+   for ( const auto &segment : _segments )
+      {
+      const auto termEntry = std::lower_bound( segment.termEntries.cbegin( ), segment.termEntries.cend( ), term,
+                                               [ ]( const TermEntry &entry, StringView value )
+                                                  { return entry.term < value; } );
+      if ( termEntry == segment.termEntries.cend( ) || termEntry->term != term ) continue;
+
+      const auto *current = segment.postings.data( ) + termEntry->offset;
+      const auto *end = current + termEntry->size;
+      DocId docId = 0;
+      for ( uint64_t i = 0; i < termEntry->numDocs; ++i )
+         {
+         auto &posting = postings.emplace_back( );
+         docId += readVarint( current, end );
+         posting.docId = docId;
+         for ( auto *positions : { &posting.bodyPositions, &posting.titlePositions } )
+            {
+            const auto numPositions = readVarint( current, end );
+            // Each gap takes at least a byte, so that a corrupt number cannot over-allocate.
+            if ( numPositions > static_cast<uint64_t>(end - current) )
+               throw FormatException( "The index is truncated." );
+            uint64_t position = 0;
+            for ( uint64_t j = 0; j < numPositions; ++j )
+               positions->push_back( static_cast<uint32_t>(position += readVarint( current, end )) );
+            }
+         }
+      if ( current != end ) throw FormatException( "The posting list has trailing bytes." );
+      }
+   }
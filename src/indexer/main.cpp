@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "indexer/inverted_index.h"
+#include "storage/mapped_page_reader.h"
+
+// Indexes the pages of crawl output that the index does not have yet, as a new segment, and reports the indexing
+// throughput and the size of the postings. The crawl output is a segment store, or a directory of the text files of
+// parsed pages, whose documents are numbered in file name order. The term dictionary is needed if the crawler stored
+// the words as term IDs.
+// Usage: indexer_cli <index_dir> <crawl_output_dir> [memory_mb] [term_dictionary]
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 3 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <index_dir> <crawl_output_dir> [memory_mb] [term_dictionary]"
+                << std::endl;
+      return 1;
+      }
+   IndexWriterConfiguration config;
+   if ( argc > 3 ) config.maxMemorySize = std::stoull( argv[ 3 ] ) << 20;
+   const std::filesystem::path outputDirectory( argv[ 2 ] );
+
+   // Loads the dictionary after mapping the store, so that it has the terms of every mapped record.
+   MappedPageReader reader( outputDirectory );
+   const auto termDictionary = argc > 4 ? makeUnique<TermDictionary>( argv[ 4 ], true ) : nullptr;
+   reader.setTermDictionary( termDictionary.get( ) );
+   IndexWriter indexWriter( argv[ 1 ], config, termDictionary.get( ) );
+   const auto firstDocId = indexWriter.nextDocId( );
+   const auto beginTime = std::chrono::steady_clock::now( );
+   if ( reader.numDocuments( ) > 0 )
+      {
+      MappedPageReader::Partition partition( reader, std::min( firstDocId, reader.numDocuments( ) ),
+                                             reader.numDocuments( ) );
+      for ( auto it = partition.begin( ); it != partition.end( ); ++it )
+         {
+         // Adds the term IDs of a record that stores them, which skips hashing its words.
+         if ( !it->wordIds.empty( ) || !it->titleWordIds.empty( ) )
+            indexWriter.add( it.docId( ), it->wordIds, it->titleWordIds );
+         else indexWriter.add( it.docId( ), it->words, it->titleWords );
+         }
+      }
+   else
+      {
+      Vector<std::filesystem::path> textPaths;
+      for ( const auto &entry : std::filesystem::directory_iterator( outputDirectory ) )
+         if ( entry.is_regular_file( ) && entry.path( ).extension( ) == ".txt" )
+            textPaths.emplace_back( entry.path( ) );
+      std::sort( textPaths.begin( ), textPaths.end( ) );
+
+      Vector<StringView> words, titleWords;
+      for ( auto docId = firstDocId; docId < textPaths.size( ); ++docId )
+         {
+         std::ifstream textFile( textPaths[ docId ] );
+         String url;
+         HtmlInfo htmlInfo;
+         std::getline( textFile, url );
+         textFile >> htmlInfo;
+         if ( textFile.fail( ) )
+            {
+            std::cerr << "Skipped the malformed file " << textPaths[ docId ] << '.' << std::endl;
+            continue;
+            }
+         words.assign( htmlInfo.words.cbegin( ), htmlInfo.words.cend( ) );
+         titleWords.assign( htmlInfo.titleWords.cbegin( ), htmlInfo.titleWords.cend( ) );
+         indexWriter.add( docId, words, titleWords );
+         }
+      }
+   const auto numRuns = indexWriter.numRuns( );
+   indexWriter.commit( );
+
+   const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   const auto numDocuments = indexWriter.nextDocId( ) - firstDocId;
+   const IndexReader indexReader( argv[ 1 ] );
+   std::cout << "Indexed " << numDocuments << " pages in " << std::fixed << std::setprecision( 2 ) << seconds << " s ["
+             << std::setprecision( 0 ) << numDocuments / seconds << " docs/s] with " << numRuns
+             << " runs spilled. The index has " << indexReader.numSegments( ) << " segments and "
+             << indexReader.numPostings( ) << " postings [" << std::setprecision( 2 )
+             << static_cast<double>(indexReader.numBytes( )) / std::max<uint64_t>( indexReader.numPostings( ), 1 )
+             << " bytes/posting]." << std::endl;
+   }
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <zlib.h>
+
+#if defined( HAS_ZSTD )
+#include <zstd.h>
+#endif
+
+#include "storage/block_codec.h"
+
+bool BlockCodec::isAvailable( Compression compression ) noexcept
+   {
+   switch ( compression )
+      {
+      case Compression::None:
+      case Compression::Zlib:
+         return true;
+      case Compression::Zstd:
+#if defined( HAS_ZSTD )
+         return true;
+#else
+         return false;
+#endif
+      }
+   return false;
+   }
+
+void BlockCodec::compress( Compression compression, int level, StringView block, String &compressedBlock )
+   {
+   switch ( compression )
+      {
+      case Compression::None:
+         compressedBlock.assign( block );
+         return;
+      case Compression::Zlib:
+         {
+         auto compressedSize = compressBound( block.size( ) );
+         compressedBlock.resize( compressedSize );
+         if ( compress2( reinterpret_cast<Bytef *>(compressedBlock.data( )), &compressedSize,
+                         reinterpret_cast<const Bytef *>(block.data( )), block.size( ),
+                         level != 0 ? level : Z_DEFAULT_COMPRESSION ) != Z_OK )
+            throw ArgumentException( "The zlib compression level is invalid." );
+         compressedBlock.resize( compressedSize );
+         return;
+         }
+      case Compression::Zstd:
+#if defined( HAS_ZSTD )
+         {
+         compressedBlock.resize( ZSTD_compressBound( block.size( ) ) );
+         const auto compressedSize = ZSTD_compress( compressedBlock.data( ), compressedBlock.size( ), block.data( ),
+                                                    block.size( ), level != 0 ? level : ZSTD_CLEVEL_DEFAULT );
+         if ( ZSTD_isError( compressedSize ) ) throw ArgumentException( ZSTD_getErrorName( compressedSize ) );
+         compressedBlock.resize( compressedSize );
+         return;
+         }
+#else
+         break;
+#endif
+      }
+   throw ArgumentException( "The compression is not available in this build." );
+   }
+
+void BlockCodec::decompress( Compression compression, StringView compressedBlock, std::span<char> block )
+   {
+   switch ( compression )
+      {
+      case Compression::None:
+         if ( compressedBlock.size( ) != block.size( ) ) throw FormatException( "The block size does not match." );
+         std::copy( compressedBlock.cbegin( ), compressedBlock.cend( ), block.begin( ) );
+         return;
+      case Compression::Zlib:
+         {
+         uLongf size = block.size( );
+         if ( uncompress( reinterpret_cast<Bytef *>(block.data( )), &size,
+                          reinterpret_cast<const Bytef *>(compressedBlock.data( )), compressedBlock.size( ) ) != Z_OK ||
+              size != block.size( ) )
+            throw FormatException( "The zlib block is corrupt." );
+         return;
+         }
+      case Compression::Zstd:
+#if defined( HAS_ZSTD )
+         {
+         const auto size = ZSTD_decompress( block.data( ), block.size( ), compressedBlock.data( ),
+                                            compressedBlock.size( ) );
+         if ( ZSTD_isError( size ) || size != block.size( ) ) throw FormatException( "The zstd block is corrupt." );
+         return;
+         }
+#else
+         break;
+#endif
+      }
+   throw ArgumentException( "The compression is not available in this build." );
+   }
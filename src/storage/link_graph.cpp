@@ -0,0 +1,356 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+
+#include "storage/link_graph.h"
+
+namespace
+   {
+   void appendVarint( String &data, uint64_t value )
+      {
+      for ( ; value >= 0x80; value >>= 7 ) data += static_cast<char>(value | 0x80);
+      data += static_cast<char>(value);
+      }
+
+   // Reads a varint, or returns `nullopt` if the data ends before it does.
+   std::optional<uint64_t> readVarint( const char *&data, const char *end ) noexcept
+      {
+      uint64_t value = 0;
+      for ( auto shift = 0; data != end && shift < 64; shift += 7 )
+         {
+         const auto byte = static_cast<uint8_t>(*data++);
+         value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+         if ( !( byte & 0x80 ) ) return value;
+         }
+      return std::nullopt;
+      }
+
+   // Appends sorted IDs as their number followed by the gap of each from the previous one.
+   void appendAdjacencyList( String &data, std::span<const uint32_t> ids )
+      {
+      appendVarint( data, ids.size( ) );
+      uint32_t previousId = 0;
+      for ( const auto id : ids )
+         {
+         appendVarint( data, id - previousId );
+         previousId = id;
+         }
+      }
+
+   String readFile( const std::filesystem::path &path )
+      {
+      std::ifstream file( path, std::ios::binary );
+      if ( !file.is_open( ) ) throw IOException( STRING( "The file " << path << " cannot be opened." ) );
+      String data( std::istreambuf_iterator<char>( file ), { } );
+      if ( file.bad( ) ) throw IOException( STRING( "The file " << path << " cannot be read." ) );
+      return data;
+      }
+
+   // Runs tasks on several threads, each taking the next task until none are left, and rethrows the first error.
+   void runTasks( size_t numTasks, int numThreads, const std::function<void( size_t )> &task )
+      {
+      std::atomic<size_t> nextTask = 0;
+      Vector<std::exception_ptr> errors( std::max( numThreads, 1 ) );
+      Vector<Thread> threads;
+      for ( size_t i = 0; i < errors.size( ); ++i )
+         threads.emplace_back( [ &, i ]( )
+            {
+            try
+               {
+               for ( auto taskIndex = nextTask++; taskIndex < numTasks; taskIndex = nextTask++ )
+                  task( taskIndex );
+               }
+            catch ( ... )
+               {
+               errors[ i ] = std::current_exception( );
+               nextTask = numTasks;
+               }
+            } );
+      for ( auto &thread : threads )
+         thread.join( );
+      for ( const auto &error : errors )
+         if ( error != nullptr ) std::rethrow_exception( error );
+      }
+
+   // The files of one run of a shard, as read by a merge.
+   struct ShardRun
+      {
+      public:
+         std::filesystem::path urlsPath, linksPath;
+         Vector<uint64_t> fingerprints; ///< The fingerprints by ID within the run.
+         Vector<StringView> urls; ///< The URLs by ID within the run, which refer to `urlsData`.
+         String urlsData;
+         Vector<std::pair<UrlId, String>> adjacencyLists; ///< The adjacency lists in merged IDs, in file order.
+      };
+
+   void readUrls( ShardRun &run )
+      {
+      run.urlsData = readFile( run.urlsPath );
+      const auto *current = run.urlsData.data( ), *end = current + run.urlsData.size( );
+      while ( end - current >= 8 )
+         {
+         uint64_t fingerprint = 0;
+         for ( auto i = 0; i < 8; ++i )
+            fingerprint |= static_cast<uint64_t>(static_cast<uint8_t>(*current++)) << i * 8;
+         const auto size = readVarint( current, end );
+         if ( !size.has_value( ) || size.value( ) > static_cast<uint64_t>(end - current) ) break;
+         run.fingerprints.push_back( fingerprint );
+         run.urls.emplace_back( current, size.value( ) );
+         current += size.value( );
+         }
+      }
+
+   void readLinks( ShardRun &run, std::span<const uint64_t> fingerprints )
+      {
+      Vector<UrlId> urlIds;
+      urlIds.reserve( run.fingerprints.size( ) );
+      for ( const auto fingerprint : run.fingerprints )
+         urlIds.push_back( static_cast<UrlId>(std::lower_bound( fingerprints.begin( ), fingerprints.end( ),
+                                                                fingerprint ) - fingerprints.begin( )) );
+
+      const auto data = readFile( run.linksPath );
+      const auto *current = data.data( ), *end = current + data.size( );
+      Vector<UrlId> links;
+      while ( current != end )
+         {
+         const auto sourceId = readVarint( current, end );
+         const auto numLinks = readVarint( current, end );
+         if ( !numLinks.has_value( ) ) return;
+         links.clear( );
+         uint64_t id = 0;
+         for ( uint64_t i = 0; i < numLinks.value( ); ++i )
+            {
+            const auto gap = readVarint( current, end );
+            if ( !gap.has_value( ) ) return;
+            // Drops the links to URLs whose records are torn.
+            id += gap.value( );
+            if ( id < urlIds.size( ) ) links.push_back( urlIds[ id ] );
+            }
+         if ( sourceId.value( ) >= urlIds.size( ) ) continue;
+
+         std::sort( links.begin( ), links.end( ) );
+         links.erase( std::unique( links.begin( ), links.end( ) ), links.end( ) );
+         auto &adjacencyList = run.adjacencyLists.emplace_back( urlIds[ sourceId.value( ) ], String( ) ).second;
+         appendAdjacencyList( adjacencyList, links );
+         }
+      }
+   }
+
+LinkGraphWriter::LinkGraphWriter( std::filesystem::path directory ) : _directory( std::move( directory ) )
+   {
+   std::filesystem::create_directories( _directory );
+   auto run = 0;
+   while ( std::filesystem::exists( urlsPath( _directory, run ) ) ) ++run;
+   _urlsStream.open( urlsPath( _directory, run ), std::ios::binary | std::ios::app );
+   _linksStream.open( linksPath( _directory, run ), std::ios::binary | std::ios::app );
+   if ( !_urlsStream.is_open( ) || !_linksStream.is_open( ) )
+      throw IOException( "The link graph files cannot be opened." );
+   }
+
+LinkGraphWriter::~LinkGraphWriter( )
+   {
+   try
+      { flush( ); }
+   catch ( ... )
+      { }
+   }
+
+void LinkGraphWriter::write( const Url &url, std::span<const Url> links )
+   {
+   const auto urlFingerprint = fingerprint( url.toString( ) );
+   Vector<uint64_t> linkFingerprints;
+   linkFingerprints.reserve( links.size( ) );
+   for ( const auto &link : links ) linkFingerprints.push_back( fingerprint( link.toString( ) ) );
+
+   UniqueLock lock( _mutex );
+   // Adds the URLs seen for the first time in this run to the URL list.
+   String urlsRecord;
+   const auto urlIdOf = [ & ]( uint64_t fingerprint, StringView url )
+      {
+      const auto [ it, isNew ] = _urlIds.try_emplace( fingerprint, static_cast<uint32_t>(_urlIds.size( )) );
+      if ( isNew )
+         {
+         for ( auto i = 0; i < 8; ++i ) urlsRecord += static_cast<char>(fingerprint >> i * 8);
+         appendVarint( urlsRecord, url.size( ) );
+         urlsRecord.append( url );
+         }
+      return it->second;
+      };
+   const auto urlId = urlIdOf( urlFingerprint, url.toString( ) );
+   Vector<uint32_t> linkIds;
+   linkIds.reserve( links.size( ) );
+   for ( size_t i = 0; i < links.size( ); ++i )
+      linkIds.push_back( urlIdOf( linkFingerprints[ i ], links[ i ].toString( ) ) );
+   std::sort( linkIds.begin( ), linkIds.end( ) );
+   linkIds.erase( std::unique( linkIds.begin( ), linkIds.end( ) ), linkIds.end( ) );
+
+   String linksRecord;
+   appendVarint( linksRecord, urlId );
+   appendAdjacencyList( linksRecord, linkIds );
+   // The two streams flush independently, so a crash can leave adjacency lists that refer to URLs missing from the URL
+   // list, or URLs without their adjacency lists. Merging drops the links to IDs that the URL list does not have.
+   _urlsStream.write( urlsRecord.data( ), static_cast<std::streamsize>(urlsRecord.size( )) );
+   _linksStream.write( linksRecord.data( ), static_cast<std::streamsize>(linksRecord.size( )) );
+   if ( !_urlsStream || !_linksStream ) throw IOException( "The link graph files cannot be written." );
+   ++_numPages;
+   }
+
+void LinkGraphWriter::flush( )
+   {
+   UniqueLock lock( _mutex );
+   _urlsStream.flush( );
+   _linksStream.flush( );
+   if ( !_urlsStream || !_linksStream ) throw IOException( "The link graph files cannot be written." );
+   }
+
+size_t LinkGraphWriter::numPages( ) const
+   {
+   UniqueLock lock( _mutex );
+   return _numPages;
+   }
+
+uint64_t LinkGraphWriter::fingerprint( StringView url ) noexcept
+   {
+   // FNV-1a, and then the SplitMix64 finalizer, so that fingerprints spread evenly for sorting and ranking by them.
+   auto hashValue = 14695981039346656037ull;
+   for ( const auto c : url ) hashValue = ( hashValue ^ static_cast<unsigned char>(c) ) * 1099511628211ull;
+   hashValue = ( hashValue ^ ( hashValue >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+   hashValue = ( hashValue ^ ( hashValue >> 27 ) ) * 0x94d049bb133111ebull;
+   return hashValue ^ ( hashValue >> 31 );
+   }
+
+std::filesystem::path LinkGraphWriter::urlsPath( const std::filesystem::path &directory, int run )
+   { return directory / STRING( "urls-" << run << ".dat" ); }
+
+std::filesystem::path LinkGraphWriter::linksPath( const std::filesystem::path &directory, int run )
+   { return directory / STRING( "links-" << run << ".dat" ); }
+
+LinkGraph::LinkGraph( const std::filesystem::path &directory )
+   {
+   const auto nodes = readFile( nodesPath( directory ) );
+   _urls = readFile( urlsPath( directory ) );
+   _links = readFile( linksPath( directory ) );
+   if ( nodes.empty( ) || nodes.size( ) % sizeof( Node ) != 0 )
+      throw FormatException( "The link graph index is malformed." );
+   _nodes.resize( nodes.size( ) / sizeof( Node ) );
+   std::copy_n( nodes.data( ), nodes.size( ), reinterpret_cast<char *>(_nodes.data( )) );
+
+   // Checks the offsets once, so that looking up a URL or its links cannot read out of bounds.
+   for ( size_t i = 0; i + 1 < _nodes.size( ); ++i )
+      if ( _nodes[ i ].urlOffset > _nodes[ i + 1 ].urlOffset || _nodes[ i ].linksOffset > _nodes[ i + 1 ].linksOffset )
+         throw FormatException( "The link graph index is malformed." );
+   if ( _nodes.front( ).urlOffset != 0 || _nodes.front( ).linksOffset != 0 ||
+        _nodes.back( ).urlOffset != _urls.size( ) || _nodes.back( ).linksOffset != _links.size( ) )
+      throw FormatException( "The link graph index does not match its files." );
+   }
+
+void LinkGraph::merge( std::span<const std::filesystem::path> shardDirectories,
+                       const std::filesystem::path &directory, int numThreads )
+   {
+   Vector<ShardRun> runs;
+   for ( const auto &shardDirectory : shardDirectories )
+      {
+      if ( !std::filesystem::is_directory( shardDirectory ) )
+         throw IOException( STRING( "The link graph shard " << shardDirectory << " does not exist." ) );
+      for ( auto run = 0; std::filesystem::exists( LinkGraphWriter::urlsPath( shardDirectory, run ) ); ++run )
+         {
+         auto &shardRun = runs.emplace_back( );
+         shardRun.urlsPath = LinkGraphWriter::urlsPath( shardDirectory, run );
+         shardRun.linksPath = LinkGraphWriter::linksPath( shardDirectory, run );
+         }
+      }
+
+   // Numbers the distinct URLs of all runs in the order of their fingerprints.
+   runTasks( runs.size( ), numThreads, [ & ]( size_t i ) { readUrls( runs[ i ] ); } );
+   Vector<std::pair<uint64_t, StringView>> urls;
+   for ( const auto &run : runs )
+      for ( size_t i = 0; i < run.urls.size( ); ++i ) urls.emplace_back( run.fingerprints[ i ], run.urls[ i ] );
+   std::stable_sort( urls.begin( ), urls.end( ), [ ]( const auto &lhs, const auto &rhs )
+      { return lhs.first < rhs.first; } );
+   urls.erase( std::unique( urls.begin( ), urls.end( ), [ ]( const auto &lhs, const auto &rhs )
+      { return lhs.first == rhs.first; } ), urls.end( ) );
+   if ( urls.size( ) > UINT32_MAX ) throw InvalidOperationException( "The link graph has too many URLs." );
+   Vector<uint64_t> fingerprints;
+   fingerprints.reserve( urls.size( ) );
+   for ( const auto &[ fingerprint, url ] : urls ) fingerprints.push_back( fingerprint );
+
+   // Renumbers the adjacency lists of all runs, and keeps the last list of each page.
+   runTasks( runs.size( ), numThreads, [ & ]( size_t i ) { readLinks( runs[ i ], fingerprints ); } );
+   Vector<const String *> adjacencyLists( urls.size( ), nullptr );
+   for ( const auto &run : runs )
+      for ( const auto &[ urlId, adjacencyList ] : run.adjacencyLists ) adjacencyLists[ urlId ] = &adjacencyList;
+
+   std::filesystem::create_directories( directory );
+   std::ofstream nodesStream( nodesPath( directory ), std::ios::binary | std::ios::trunc );
+   std::ofstream urlsStream( urlsPath( directory ), std::ios::binary | std::ios::trunc );
+   std::ofstream linksStream( linksPath( directory ), std::ios::binary | std::ios::trunc );
+   if ( !nodesStream.is_open( ) || !urlsStream.is_open( ) || !linksStream.is_open( ) )
+      throw IOException( "The link graph files cannot be opened." );
+   const String emptyAdjacencyList( 1, '\0' );
+   Node node{ 0, 0, 0 };
+   for ( size_t i = 0; i < urls.size( ); ++i )
+      {
+      const auto &adjacencyList = adjacencyLists[ i ] != nullptr ? *adjacencyLists[ i ] : emptyAdjacencyList;
+      node.fingerprint = urls[ i ].first;
+      nodesStream.write( reinterpret_cast<const char *>(&node), sizeof( node ) );
+      urlsStream.write( urls[ i ].second.data( ), static_cast<std::streamsize>(urls[ i ].second.size( )) );
+      linksStream.write( adjacencyList.data( ), static_cast<std::streamsize>(adjacencyList.size( )) );
+      node.urlOffset += urls[ i ].second.size( );
+      node.linksOffset += adjacencyList.size( );
+      }
+   node.fingerprint = 0;
+   nodesStream.write( reinterpret_cast<const char *>(&node), sizeof( node ) );
+   nodesStream.flush( );
+   urlsStream.flush( );
+   linksStream.flush( );
+   if ( !nodesStream || !urlsStream || !linksStream ) throw IOException( "The link graph files cannot be written." );
+   }
+
+StringView LinkGraph::url( UrlId urlId ) const noexcept
+   {
+   const auto &node = _nodes[ urlId ];
+   return StringView( _urls ).substr( node.urlOffset, _nodes[ urlId + 1 ].urlOffset - node.urlOffset );
+   }
+
+std::optional<UrlId> LinkGraph::find( StringView url ) const noexcept
+   {
+   const auto fingerprint = LinkGraphWriter::fingerprint( url );
+   const auto it = std::lower_bound( _nodes.cbegin( ), _nodes.cend( ) - 1, fingerprint,
+                                     [ ]( const Node &node, uint64_t value ) { return node.fingerprint < value; } );
+   if ( it == _nodes.cend( ) - 1 || it->fingerprint != fingerprint ) return std::nullopt;
+   const auto urlId = static_cast<UrlId>(it - _nodes.cbegin( ));
+   if ( this->url( urlId ) != url ) return std::nullopt;
+   return urlId;
+   }
+
+void LinkGraph::links( UrlId urlId, Vector<UrlId> &links ) const
+   {
+   links.clear( );
+   const auto *current = _links.data( ) + _nodes[ urlId ].linksOffset;
+   const auto *end = _links.data( ) + _nodes[ urlId + 1 ].linksOffset;
+   const auto numLinks = readVarint( current, end );
+   // Each gap takes at least a byte, so that a corrupt number cannot over-allocate.
+   if ( !numLinks.has_value( ) || numLinks.value( ) > static_cast<uint64_t>(end - current) )
+      throw FormatException( "The adjacency list is truncated." );
+   links.reserve( numLinks.value( ) );
+   uint64_t id = 0;
+   for ( uint64_t i = 0; i < numLinks.value( ); ++i )
+      {
+      const auto gap = readVarint( current, end );
+      if ( !gap.has_value( ) ) throw FormatException( "The adjacency list is truncated." );
+      id += gap.value( );
+      if ( id >= numUrls( ) ) throw FormatException( "The adjacency list links to an unknown URL." );
+      links.push_back( static_cast<UrlId>(id) );
+      }
+   if ( current != end ) throw FormatException( "The adjacency list has trailing bytes." );
+   }
+
+std::filesystem::path LinkGraph::nodesPath( const std::filesystem::path &directory )
+   { return directory / "nodes.idx"; }
+
+std::filesystem::path LinkGraph::urlsPath( const std::filesystem::path &directory )
+   { return directory / "urls.dat"; }
+
+std::filesystem::path LinkGraph::linksPath( const std::filesystem::path &directory )
+   { return directory / "links.dat"; }
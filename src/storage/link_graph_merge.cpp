@@ -0,0 +1,37 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "storage/link_graph.h"
+
+// Merges the link graph shards that crawler nodes started with `--link_graph_dir` wrote into one graph with dense URL
+// IDs, reading the shards on several threads, and reports the size of the graph.
+// Usage: link_graph_merge_cli <output_dir> <num_threads> <shard_dir>...
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 4 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <output_dir> <num_threads> <shard_dir>..." << std::endl;
+      return 1;
+      }
+   const Vector<std::filesystem::path> shardDirectories( argv + 3, argv + argc );
+
+   const auto beginTime = std::chrono::steady_clock::now( );
+   LinkGraph::merge( shardDirectories, argv[ 1 ], std::max( std::stoi( argv[ 2 ] ), 1 ) );
+   const LinkGraph linkGraph( argv[ 1 ] );
+   uint64_t numLinks = 0;
+   Vector<UrlId> links;
+   for ( size_t i = 0; i < linkGraph.numUrls( ); ++i )
+      {
+      linkGraph.links( static_cast<UrlId>(i), links );
+      numLinks += links.size( );
+      }
+
+   const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   const auto numBytes = std::filesystem::file_size( std::filesystem::path( argv[ 1 ] ) / "links.dat" );
+   std::cout << "Merged " << shardDirectories.size( ) << " shards into " << linkGraph.numUrls( ) << " URLs and "
+             << numLinks << " links in " << std::fixed << std::setprecision( 2 ) << seconds << " s ["
+             << std::setprecision( 2 ) << ( numLinks > 0 ? static_cast<double>(numBytes) / numLinks : 0.0 )
+             << " bytes/link]." << std::endl;
+   }
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <exception>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "storage/mapped_page_reader.h"
+
+MappedPageReader::MappedPageReader( const std::filesystem::path &directory, const TermDictionary *termDictionary ) :
+      _termDictionary( termDictionary )
+   {
+   const auto numSegments = SegmentWriter::countSegments( directory );
+   _segments.resize( numSegments );
+   for ( auto i = 0; i < numSegments; ++i )
+      {
+      auto &segment = _segments[ i ];
+      segment.firstDocId = _numDocuments;
+      segment.isCompressed = SegmentWriter::isCompressed( directory, i );
+      segment.data = map( SegmentWriter::dataPath( directory, i, segment.isCompressed ), segment.dataSize );
+      const auto *index = map( SegmentWriter::indexPath( directory, i ), segment.indexSize );
+      // Ignores a torn index entry, which the writer truncates when it reopens the segment.
+      segment.entries = { reinterpret_cast<const SegmentWriter::IndexEntry *>(index),
+                          segment.indexSize / sizeof( SegmentWriter::IndexEntry ) };
+      _numDocuments += segment.entries.size( );
+
+      // Each partition reads its range of a data file front to back.
+      if ( segment.data != nullptr ) ::madvise( const_cast<char *>(segment.data), segment.dataSize, MADV_SEQUENTIAL );
+      }
+   }
+
+MappedPageReader::~MappedPageReader( )
+   {
+   for ( const auto &segment : _segments )
+      {
+      if ( segment.data != nullptr ) ::munmap( const_cast<char *>(segment.data), segment.dataSize );
+      if ( segment.indexSize > 0 )
+         ::munmap( const_cast<SegmentWriter::IndexEntry *>(segment.entries.data( )), segment.indexSize );
+      }
+   }
+
+uint64_t MappedPageReader::numBytes( ) const noexcept
+   {
+   uint64_t numBytes = 0;
+   for ( const auto &segment : _segments ) numBytes += segment.dataSize;
+   return numBytes;
+   }
+
+Vector<MappedPageReader::Partition> MappedPageReader::partition( int numPartitions ) const
+   {
+   numPartitions = std::max( numPartitions, 1 );
+   Vector<Partition> partitions;
+   partitions.reserve( numPartitions );
+   for ( auto i = 0; i < numPartitions; ++i )
+      partitions.emplace_back( *this, _numDocuments * i / numPartitions, _numDocuments * ( i + 1 ) / numPartitions );
+   return partitions;
+   }
+
+void MappedPageReader::forEach( int numThreads,
+                                const std::function<void( DocId, const PageRecordView & )> &callback ) const
+   {
+   auto partitions = partition( numThreads );
+   Vector<std::exception_ptr> errors( partitions.size( ) );
+   Vector<Thread> threads;
+   for ( size_t i = 0; i < partitions.size( ); ++i )
+      threads.emplace_back( [ &, i ]( )
+         {
+         try
+            {
+            for ( auto it = partitions[ i ].begin( ); it != partitions[ i ].end( ); ++it )
+               callback( it.docId( ), *it );
+            }
+         catch ( ... )
+            { errors[ i ] = std::current_exception( ); }
+         } );
+   for ( auto &thread : threads )
+      thread.join( );
+   for ( const auto &error : errors )
+      if ( error != nullptr ) std::rethrow_exception( error );
+   }
+
+const char *MappedPageReader::map( const std::filesystem::path &path, size_t &size )
+   {
+   const auto file = ::open( path.c_str( ), O_RDONLY );
+   if ( file == -1 ) throw SystemException( );
+   size = std::filesystem::file_size( path );
+   // An empty file cannot be mapped, and has nothing to read.
+   auto *data = size > 0 ? ::mmap( nullptr, size, PROT_READ, MAP_SHARED, file, 0 ) : nullptr;
+   ::close( file );
+   if ( data == MAP_FAILED ) throw SystemException( );
+   return static_cast<const char *>(data);
+   }
+
+const PageRecordView &MappedPageReader::Partition::decode( DocId docId )
+   {
+   if ( docId == _viewDocId ) return _view;
+
+   const auto &segments = _reader->_segments;
+   const auto segment = std::prev( std::upper_bound( segments.cbegin( ), segments.cend( ), docId,
+                                                     [ ]( DocId docId, const Segment &segment )
+                                                        { return docId < segment.firstDocId; } ) );
+   const auto &entry = segment->entries[ docId - segment->firstDocId ];
+   StringView record;
+   if ( segment->isCompressed )
+      {
+      // Decompresses each block once for all of its records, which are consecutive.
+      if ( &*segment != _blockSegment || entry.offset != _blockOffset )
+         {
+         SegmentWriter::BlockHeader header{ };
+         if ( entry.offset + sizeof( header ) > segment->dataSize )
+            throw FormatException( "The block is past the end of its segment." );
+         std::copy_n( segment->data + entry.offset, sizeof( header ), reinterpret_cast<char *>(&header) );
+         if ( entry.offset + sizeof( header ) + header.compressedSize > segment->dataSize )
+            throw FormatException( "The block is past the end of its segment." );
+         _blockSegment = nullptr;
+         _block.resize( header.size );
+         BlockCodec::decompress( header.compression,
+                                 StringView( segment->data + entry.offset + sizeof( header ), header.compressedSize ),
+                                 _block );
+         _blockSegment = &*segment, _blockOffset = entry.offset;
+         }
+      if ( entry.offsetInBlock + entry.length > _block.size( ) )
+         throw FormatException( "The record is past the end of its block." );
+      record = StringView( _block ).substr( entry.offsetInBlock, entry.length );
+      }
+   else
+      {
+      if ( entry.offset + entry.length > segment->dataSize )
+         throw FormatException( "The record is past the end of its segment." );
+      record = StringView( segment->data + entry.offset, entry.length );
+      }
+
+   _viewDocId = UINT64_MAX;
+   PageRecord::decode( record, _view, _reader->_termDictionary );
+   _viewDocId = docId;
+   return _view;
+   }
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "storage/page_record.h"
+#include "storage/segment_store.h"
+
+// Converts the text files of parsed pages, i.e. the request URL on the first line followed by the text format of
+// `HtmlInfo`, into binary page records in a segment store, in file name order.
+// Usage: page_converter_cli <text_dir> <store_dir> [--checksum]
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 3 || ( argc > 3 && StringView( argv[ 3 ] ) != "--checksum" ) )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <text_dir> <store_dir> [--checksum]" << std::endl;
+      return 1;
+      }
+   const auto hasChecksum = argc > 3;
+
+   Vector<std::filesystem::path> textPaths;
+   for ( const auto &entry : std::filesystem::directory_iterator( argv[ 1 ] ) )
+      if ( entry.is_regular_file( ) && entry.path( ).extension( ) == ".txt" ) textPaths.emplace_back( entry.path( ) );
+   std::sort( textPaths.begin( ), textPaths.end( ) );
+
+   SegmentWriter pageStore( argv[ 2 ] );
+   String record;
+   size_t textSize = 0, recordSize = 0;
+   for ( const auto &textPath : textPaths )
+      {
+      std::ifstream textFile( textPath );
+      if ( !textFile.is_open( ) ) throw IOException( "The HTML info file cannot be opened." );
+      String url;
+      HtmlInfo htmlInfo;
+      std::getline( textFile, url );
+      textFile >> htmlInfo;
+      if ( textFile.fail( ) )
+         {
+         std::cerr << "Skipped the malformed file " << textPath << '.' << std::endl;
+         continue;
+         }
+
+      record.clear( );
+      PageRecord::encode( url, htmlInfo, record, hasChecksum );
+      pageStore.append( record );
+      textSize += std::filesystem::file_size( textPath ), recordSize += record.size( );
+      }
+   pageStore.commit( );
+
+   std::cout << "Converted " << pageStore.numRecords( ) << " pages from " << textSize << " to " << recordSize
+             << " bytes." << std::endl;
+   }
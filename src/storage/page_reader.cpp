@@ -0,0 +1,39 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "storage/mapped_page_reader.h"
+
+// Reads every page of a segment store on several threads through memory maps, counting their words and links, and
+// reports the read throughput. The term dictionary is needed if the crawler stored the words as term IDs.
+// Usage: page_reader_cli <store_dir> [num_threads] [term_dictionary]
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <store_dir> [num_threads] [term_dictionary]" << std::endl;
+      return 1;
+      }
+   const auto numThreads = argc > 2 ? std::max( std::stoi( argv[ 2 ] ), 1 )
+                                    : std::max( static_cast<int>(std::thread::hardware_concurrency( )), 1 );
+
+   const auto beginTime = std::chrono::steady_clock::now( );
+   // Loads the dictionary after mapping the store, so that it has the terms of every mapped record.
+   MappedPageReader reader( argv[ 1 ] );
+   const auto termDictionary = argc > 3 ? makeUnique<TermDictionary>( argv[ 3 ], true ) : nullptr;
+   reader.setTermDictionary( termDictionary.get( ) );
+   std::atomic<uint64_t> numWords = 0, numLinks = 0;
+   reader.forEach( numThreads, [ & ]( DocId, const PageRecordView &page )
+      {
+      numWords.fetch_add( page.words.size( ) + page.titleWords.size( ), std::memory_order_relaxed );
+      numLinks.fetch_add( page.links.size( ), std::memory_order_relaxed );
+      } );
+
+   const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   std::cout << "Read " << reader.numDocuments( ) << " pages with " << numWords << " words and " << numLinks
+             << " links on " << numThreads << " threads in " << std::fixed << std::setprecision( 2 ) << seconds
+             << " s [" << std::setprecision( 0 ) << reader.numDocuments( ) / seconds << " pages/s, "
+             << std::setprecision( 1 ) << reader.numBytes( ) / seconds / ( 1 << 20 ) << " MB/s]." << std::endl;
+   }
@@ -0,0 +1,228 @@
+#include <array>
+#include <type_traits>
+
+#include "storage/page_record.h"
+
+HtmlInfo PageRecordView::toHtmlInfo( ) const
+   {
+   HtmlInfo htmlInfo;
+   htmlInfo.words.assign( words.cbegin( ), words.cend( ) );
+   htmlInfo.titleWords.assign( titleWords.cbegin( ), titleWords.cend( ) );
+   htmlInfo.links.reserve( links.size( ) );
+   for ( const auto &linkInfo : links )
+      {
+      const auto linkAnchorWords = anchorWordsOf( linkInfo );
+      auto &copiedLinkInfo = htmlInfo.links.emplace_back( linkInfo.url );
+      copiedLinkInfo.anchorWords.assign( linkAnchorWords.begin( ), linkAnchorWords.end( ) );
+      copiedLinkInfo.isNoFollow = linkInfo.isNoFollow;
+      }
+   if ( base.has_value( ) ) htmlInfo.base = Url( base.value( ) );
+   if ( canonical.has_value( ) ) htmlInfo.canonical = Url( canonical.value( ) );
+   htmlInfo.robots = robots;
+   htmlInfo.simHash = simHash;
+   return htmlInfo;
+   }
+
+void PageRecord::encode( StringView url, const HtmlInfo &htmlInfo, String &record, bool hasChecksum,
+                         TermDictionary *termDictionary )
+   { encode<HtmlInfo>( url, htmlInfo, record, hasChecksum, termDictionary ); }
+
+void PageRecord::encode( StringView url, const HtmlInfoView &htmlInfo, String &record, bool hasChecksum,
+                         TermDictionary *termDictionary )
+   { encode<HtmlInfoView>( url, htmlInfo, record, hasChecksum, termDictionary ); }
+
+template<typename Info>
+void PageRecord::encode( StringView url, const Info &htmlInfo, String &record, bool hasChecksum,
+                         TermDictionary *termDictionary )
+   {
+   uint8_t flags = 0;
+   if ( hasChecksum ) flags |= HasChecksum;
+   if ( termDictionary != nullptr ) flags |= HasTermIds;
+   if ( htmlInfo.base.has_value( ) ) flags |= HasBase;
+   if ( htmlInfo.canonical.has_value( ) ) flags |= HasCanonical;
+   if ( htmlInfo.robots.isNoIndex ) flags |= IsNoIndex;
+   if ( htmlInfo.robots.isNoFollow ) flags |= IsNoFollow;
+   record += static_cast<char>(version);
+   record += static_cast<char>(flags);
+
+   const auto appendWord = [ & ]( StringView word )
+      {
+      if ( termDictionary != nullptr ) appendVarint( record, termDictionary->intern( word ) );
+      else appendString( record, word );
+      };
+
+   const auto payloadPos = record.size( );
+   appendString( record, url );
+   for ( auto i = 0; i < 8; ++i ) record += static_cast<char>(htmlInfo.simHash >> i * 8);
+   appendVarint( record, htmlInfo.words.size( ) );
+   for ( const auto &word : htmlInfo.words ) appendWord( word );
+   appendVarint( record, htmlInfo.titleWords.size( ) );
+   for ( const auto &word : htmlInfo.titleWords ) appendWord( word );
+   appendVarint( record, htmlInfo.links.size( ) );
+   for ( const auto &linkInfo : htmlInfo.links )
+      {
+      appendString( record, linkInfo.url.toString( ) );
+      const auto &anchorWords = [ & ]( ) -> decltype( auto )
+         {
+         if constexpr ( std::is_same_v<Info, HtmlInfo> ) return ( linkInfo.anchorWords );
+         else return htmlInfo.anchorWordsOf( linkInfo );
+         }( );
+      appendVarint( record, anchorWords.size( ) << 1 | static_cast<uint64_t>(linkInfo.isNoFollow) );
+      for ( const auto &word : anchorWords ) appendWord( word );
+      }
+   if ( htmlInfo.base.has_value( ) ) appendString( record, htmlInfo.base.value( ).toString( ) );
+   if ( htmlInfo.canonical.has_value( ) ) appendString( record, htmlInfo.canonical.value( ).toString( ) );
+
+   // Inserts the length of the payload, now that it is known, between the flags and the payload.
+   const auto payloadSize = record.size( ) - payloadPos;
+   String length;
+   appendVarint( length, payloadSize );
+   record.insert( payloadPos, length );
+   if ( hasChecksum )
+      {
+      const auto checksum = crc32( StringView( record ).substr( payloadPos + length.size( ), payloadSize ) );
+      for ( auto i = 0; i < 4; ++i ) record += static_cast<char>(checksum >> i * 8);
+      }
+   }
+
+size_t PageRecord::decode( StringView data, PageRecordView &view, const TermDictionary *termDictionary )
+   {
+   const auto *begin = data.data( ), *end = begin + data.size( );
+   if ( data.size( ) < 2 ) throw FormatException( "The page record is truncated." );
+   if ( static_cast<uint8_t>(data[ 0 ]) != version )
+      throw FormatException( STRING( "The page record version " << static_cast<int>(data[ 0 ]) << " is unknown." ) );
+   const auto flags = static_cast<uint8_t>(data[ 1 ]);
+   const auto hasTermIds = ( flags & HasTermIds ) != 0;
+   if ( hasTermIds && termDictionary == nullptr )
+      throw FormatException( "The page record stores term IDs, but there is no term dictionary." );
+
+   const auto *current = begin + 2;
+   const auto payloadSize = readVarint( current, end );
+   const auto checksumSize = flags & HasChecksum ? 4 : 0;
+   if ( payloadSize + checksumSize > static_cast<uint64_t>(end - current) )
+      throw FormatException( "The page record is truncated." );
+   const auto *payloadEnd = current + payloadSize;
+   if ( flags & HasChecksum )
+      {
+      uint32_t checksum = 0;
+      for ( auto i = 0; i < 4; ++i ) checksum |= static_cast<uint32_t>(static_cast<uint8_t>(payloadEnd[ i ])) << i * 8;
+      if ( checksum != crc32( StringView( current, payloadSize ) ) )
+         throw FormatException( "The page record does not match its checksum." );
+      }
+
+   // Reads a word as a string, or as a term ID that is mapped back to its term.
+   const auto readWord = [ & ]( Vector<StringView> &words, Vector<TermId> &wordIds )
+      {
+      if ( !hasTermIds )
+         {
+         words.emplace_back( readString( current, payloadEnd ) );
+         return;
+         }
+      const auto termId = readVarint( current, payloadEnd );
+      if ( termId > UINT32_MAX ) throw FormatException( "The page record has an invalid term ID." );
+      words.emplace_back( termDictionary->term( wordIds.emplace_back( static_cast<TermId>(termId) ) ) );
+      };
+
+   // Reads a list of words, where each word takes at least a byte, so that a corrupt size cannot over-allocate.
+   const auto readWords = [ & ]( Vector<StringView> &words, Vector<TermId> &wordIds )
+      {
+      words.clear( );
+      wordIds.clear( );
+      const auto size = readVarint( current, payloadEnd );
+      if ( size > static_cast<uint64_t>(payloadEnd - current) )
+         throw FormatException( "The page record is truncated." );
+      for ( uint64_t i = 0; i < size; ++i ) readWord( words, wordIds );
+      };
+
+   view.url = readString( current, payloadEnd );
+   if ( payloadEnd - current < 8 ) throw FormatException( "The page record is truncated." );
+   view.simHash = 0;
+   for ( auto i = 0; i < 8; ++i ) view.simHash |= static_cast<uint64_t>(static_cast<uint8_t>(*current++)) << i * 8;
+   readWords( view.words, view.wordIds );
+   readWords( view.titleWords, view.titleWordIds );
+
+   view.links.clear( );
+   view.anchorWords.clear( );
+   view.anchorWordIds.clear( );
+   const auto numLinks = readVarint( current, payloadEnd );
+   if ( numLinks > static_cast<uint64_t>(payloadEnd - current) )
+      throw FormatException( "The page record is truncated." );
+   view.links.reserve( numLinks );
+   for ( uint64_t i = 0; i < numLinks; ++i )
+      {
+      auto &linkInfo = view.links.emplace_back( );
+      linkInfo.url = readString( current, payloadEnd );
+      const auto numAnchorWordsAndFlag = readVarint( current, payloadEnd );
+      linkInfo.isNoFollow = numAnchorWordsAndFlag & 1;
+      linkInfo.firstAnchorWord = static_cast<int>(view.anchorWords.size( ));
+      linkInfo.numAnchorWords = static_cast<int>(numAnchorWordsAndFlag >> 1);
+      if ( numAnchorWordsAndFlag >> 1 > static_cast<uint64_t>(payloadEnd - current) )
+         throw FormatException( "The page record is truncated." );
+      for ( auto j = 0; j < linkInfo.numAnchorWords; ++j ) readWord( view.anchorWords, view.anchorWordIds );
+      }
+
+   view.base.reset( );
+   if ( flags & HasBase ) view.base = readString( current, payloadEnd );
+   view.canonical.reset( );
+   if ( flags & HasCanonical ) view.canonical = readString( current, payloadEnd );
+   view.robots = { .isNoIndex = ( flags & IsNoIndex ) != 0, .isNoFollow = ( flags & IsNoFollow ) != 0 };
+   if ( current != payloadEnd ) throw FormatException( "The page record has trailing bytes." );
+
+   return payloadEnd + checksumSize - begin;
+   }
+
+void PageRecord::appendVarint( String &record, uint64_t value )
+   {
+   char bytes[ _maxVarintSize ];
+   auto size = 0;
+   for ( ; value >= 0x80; value >>= 7 ) bytes[ size++ ] = static_cast<char>(value | 0x80);
+   bytes[ size++ ] = static_cast<char>(value);
+   record.append( bytes, size );
+   }
+
+void PageRecord::appendString( String &record, StringView string )
+   {
+   appendVarint( record, string.size( ) );
+   record.append( string );
+   }
+
+uint64_t PageRecord::readVarint( const char *&data, const char *end )
+   {
+   uint64_t value = 0;
+   for ( auto shift = 0; shift < _maxVarintSize * 7; shift += 7 )
+      {
+      if ( data == end ) throw FormatException( "The page record is truncated." );
+      const auto byte = static_cast<uint8_t>(*data++);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ( !( byte & 0x80 ) ) return value;
+      }
+   throw FormatException( "The page record has an overlong varint." );
+   }
+
+StringView PageRecord::readString( const char *&data, const char *end )
+   {
+   const auto size = readVarint( data, end );
+   if ( size > static_cast<uint64_t>(end - data) ) throw FormatException( "The page record is truncated." );
+   const StringView string( data, size );
+   data += size;
+   return string;
+   }
+
+uint32_t PageRecord::crc32( StringView data ) noexcept
+   {
+   // The reflected CRC-32 of zlib and gzip, a byte at a time.
+   static const auto table = [ ]( )
+      {
+      std::array<uint32_t, 256> table{ };
+      for ( uint32_t i = 0; i < 256; ++i )
+         {
+         auto value = i;
+         for ( auto bit = 0; bit < 8; ++bit ) value = value & 1 ? 0xedb88320u ^ value >> 1 : value >> 1;
+         table[ i ] = value;
+         }
+      return table;
+      }( );
+   auto checksum = 0xffffffffu;
+   for ( const auto c : data ) checksum = table[ ( checksum ^ static_cast<uint8_t>(c) ) & 0xff ] ^ checksum >> 8;
+   return ~checksum;
+   }
@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "storage/segment_store.h"
+
+SegmentWriter::SegmentWriter( std::filesystem::path directory, const SegmentStoreConfiguration &config ) :
+      _directory( std::move( directory ) ), _config( config )
+   {
+   if ( !BlockCodec::isAvailable( _config.compression ) )
+      throw ArgumentException( "The compression is not available in this build." );
+   std::filesystem::create_directories( _directory );
+
+   // Counts the records of the full segments, and then reopens the last segment to continue appending to it, unless
+   // the configuration has changed between compressed and uncompressed since it was written.
+   const auto numSegments = countSegments( _directory );
+   const auto isCompressing = _config.compression != Compression::None;
+   const auto isLastReopened = numSegments > 0 && isCompressed( _directory, numSegments - 1 ) == isCompressing;
+   const auto numFullSegments = isLastReopened ? numSegments - 1 : numSegments;
+   for ( auto segment = 0; segment < numFullSegments; ++segment )
+      _numRecords += std::filesystem::file_size( indexPath( _directory, segment ) ) / sizeof( IndexEntry );
+   _numRecords += openSegment( numFullSegments );
+
+   if ( isCompressing )
+      {
+      _openBlock = makeUnique<Block>( );
+      for ( auto i = 0; i < std::max( _config.numCompressionThreads, 1 ); ++i )
+         _compressionThreads.emplace_back( [ this ]( )
+            { compressBlocks( ); } );
+      }
+   }
+
+SegmentWriter::~SegmentWriter( )
+   {
+   try
+      { commit( ); }
+   catch ( ... )
+      { }
+
+      {
+      UniqueLock lock( _mutex );
+      _isClosing = true;
+      _blockSealed.notifyAll( );
+      }
+   for ( auto &thread : _compressionThreads )
+      thread.join( );
+   closeSegment( );
+   }
+
+DocId SegmentWriter::append( StringView record )
+   {
+   UniqueLock lock( _mutex );
+   return appendLocked( record, lock );
+   }
+
+void SegmentWriter::appendBatch( std::span<const StringView> records )
+   {
+   UniqueLock lock( _mutex );
+   for ( const auto record : records ) appendLocked( record, lock );
+   }
+
+void SegmentWriter::commit( )
+   {
+   if ( _config.compression == Compression::None )
+      {
+      UniqueLock fileLock( _fileMutex );
+      commitLocked( );
+      return;
+      }
+
+   UniqueLock lock( _mutex );
+   sealBlock( lock );
+   const auto numSealedBlocks = _numSealedBlocks;
+   lock.unlock( );
+
+   UniqueLock fileLock( _fileMutex );
+   _blockWritten.wait( fileLock, [ & ]( )
+      { return _numWrittenBlocks >= numSealedBlocks; } );
+   rethrowErrorLocked( );
+   commitLocked( );
+   }
+
+DocId SegmentWriter::numRecords( ) const
+   {
+   UniqueLock lock( _mutex );
+   return _numRecords;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const SegmentWriter &segmentWriter )
+   {
+   const auto numCompressedBytes = segmentWriter.numCompressedBytes( );
+   const auto ratio = numCompressedBytes > 0 ?
+                      static_cast<double>(segmentWriter.numUncompressedBytes( )) / numCompressedBytes : 1.0;
+   return stream << STRING( "Compression: " << std::fixed << std::setprecision( 2 ) << ratio << "x "
+                                            << segmentWriter.compressionTime( ) << " s" );
+   }
+
+std::filesystem::path SegmentWriter::dataPath( const std::filesystem::path &directory, int segment, bool isCompressed )
+   {
+   return directory / STRING( "segment-" << std::setw( 6 ) << std::setfill( '0' ) << segment
+                                         << ( isCompressed ? ".blk" : ".dat" ) );
+   }
+
+std::filesystem::path SegmentWriter::indexPath( const std::filesystem::path &directory, int segment )
+   { return directory / STRING( "segment-" << std::setw( 6 ) << std::setfill( '0' ) << segment << ".idx" ); }
+
+bool SegmentWriter::isCompressed( const std::filesystem::path &directory, int segment )
+   { return std::filesystem::exists( dataPath( directory, segment, true ) ); }
+
+int SegmentWriter::countSegments( const std::filesystem::path &directory )
+   {
+   auto numSegments = 0;
+   while ( std::filesystem::exists( dataPath( directory, numSegments, false ) ) ||
+           std::filesystem::exists( dataPath( directory, numSegments, true ) ) )
+      ++numSegments;
+   return numSegments;
+   }
+
+void SegmentWriter::writeAll( int fileDescriptor, const char *data, size_t size )
+   {
+   while ( size > 0 )
+      {
+      const auto numWritten = ::write( fileDescriptor, data, size );
+      if ( numWritten == -1 )
+         {
+         if ( errno == EINTR ) continue;
+         throw SystemException( );
+         }
+      data += numWritten, size -= numWritten;
+      }
+   }
+
+DocId SegmentWriter::openSegment( int segment )
+   {
+   const auto isCompressing = _config.compression != Compression::None;
+   _segment = segment;
+   _dataFile = ::open( dataPath( _directory, segment, isCompressing ).c_str( ), O_RDWR | O_CREAT, 0644 );
+   if ( _dataFile == -1 ) throw SystemException( );
+   _indexFile = ::open( indexPath( _directory, segment ).c_str( ), O_RDWR | O_CREAT, 0644 );
+   if ( _indexFile == -1 ) throw SystemException( );
+
+   // Drops a torn index entry, and then the data past the last index entry, which was never committed.
+   struct stat indexStat{ };
+   if ( ::fstat( _indexFile, &indexStat ) == -1 ) throw SystemException( );
+   const auto numEntries = static_cast<uint64_t>(indexStat.st_size) / sizeof( IndexEntry );
+   _segmentSize = 0;
+   if ( numEntries > 0 )
+      {
+      IndexEntry lastEntry{ };
+      if ( ::pread( _indexFile, &lastEntry, sizeof( lastEntry ), ( numEntries - 1 ) * sizeof( IndexEntry ) ) !=
+           sizeof( lastEntry ) )
+         throw SystemException( );
+      _segmentSize = lastEntry.offset + lastEntry.length;
+      if ( isCompressing )
+         {
+         BlockHeader header{ };
+         if ( ::pread( _dataFile, &header, sizeof( header ), static_cast<off_t>(lastEntry.offset) ) !=
+              sizeof( header ) )
+            throw SystemException( );
+         _segmentSize = lastEntry.offset + sizeof( header ) + header.compressedSize;
+         }
+      }
+   if ( ::ftruncate( _indexFile, numEntries * sizeof( IndexEntry ) ) == -1 ||
+        ::ftruncate( _dataFile, _segmentSize ) == -1 ||
+        ::lseek( _indexFile, 0, SEEK_END ) == -1 || ::lseek( _dataFile, 0, SEEK_END ) == -1 )
+      throw SystemException( );
+   return numEntries;
+   }
+
+void SegmentWriter::closeSegment( ) noexcept
+   {
+   if ( _dataFile != -1 ) ::close( _dataFile );
+   if ( _indexFile != -1 ) ::close( _indexFile );
+   _dataFile = _indexFile = -1;
+   }
+
+DocId SegmentWriter::appendLocked( StringView record, UniqueLock<Mutex> &lock )
+   {
+   if ( record.size( ) > UINT32_MAX )
+      throw ArgumentException( "The record is too large." );
+
+   const auto docId = _numRecords++;
+   if ( _config.compression == Compression::None )
+      {
+      UniqueLock fileLock( _fileMutex );
+      appendToFileLocked( record );
+      return docId;
+      }
+
+   _openBlock->entries.emplace_back(
+         IndexEntry{ 0, static_cast<uint32_t>(record.size( )), static_cast<uint32_t>(_openBlock->data.size( )) } );
+   _openBlock->data.append( record );
+   if ( _openBlock->data.size( ) >= _config.blockSize ) sealBlock( lock );
+   return docId;
+   }
+
+void SegmentWriter::appendToFileLocked( StringView record )
+   {
+   if ( _segmentSize > 0 && _segmentSize + record.size( ) > _config.maxSegmentSize )
+      {
+      commitLocked( );
+      closeSegment( );
+      openSegment( _segment + 1 );
+      }
+
+   _pendingEntries.emplace_back( IndexEntry{ _segmentSize, static_cast<uint32_t>(record.size( )), 0 } );
+   _buffer.append( record );
+   _segmentSize += record.size( );
+   if ( _buffer.size( ) >= _config.groupCommitSize ) commitLocked( );
+   }
+
+void SegmentWriter::sealBlock( UniqueLock<Mutex> &lock )
+   {
+   if ( _openBlock->entries.empty( ) ) return;
+   auto block = std::exchange( _openBlock, makeUnique<Block>( ) );
+   block->sequenceNumber = _numSealedBlocks++;
+
+   // Waits for the compression threads to catch up, so that the blocks in memory stay bounded.
+   _blockTaken.wait( lock, [ & ]( )
+      { return _sealedBlocks.size( ) < 2 * _compressionThreads.size( ); } );
+   _sealedBlocks.push( std::move( block ) );
+   _blockSealed.notifyOne( );
+
+   UniqueLock fileLock( _fileMutex );
+   rethrowErrorLocked( );
+   }
+
+void SegmentWriter::compressBlocks( )
+   {
+   const auto getCpuTime = [ ]( )
+      {
+      timespec time{ };
+      ::clock_gettime( CLOCK_THREAD_CPUTIME_ID, &time );
+      return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+      };
+
+   while ( true )
+      {
+      UniqueLock lock( _mutex );
+      _blockSealed.wait( lock, [ & ]( )
+         { return !_sealedBlocks.empty( ) || _isClosing; } );
+      if ( _sealedBlocks.empty( ) ) return;
+      auto block = std::move( _sealedBlocks.front( ) );
+      _sealedBlocks.pop( );
+      _blockTaken.notifyAll( );
+      lock.unlock( );
+
+      std::exception_ptr error;
+      const auto beginTime = getCpuTime( );
+      try
+         { BlockCodec::compress( _config.compression, _config.compressionLevel, block->data, block->compressedData ); }
+      catch ( ... )
+         { error = std::current_exception( ); }
+      _compressionNanoseconds += getCpuTime( ) - beginTime;
+
+      // Writes the blocks in order, so that the records keep the order of their IDs. After an error, the blocks are
+      // dropped, but still counted so that `commit` does not wait for them.
+      UniqueLock fileLock( _fileMutex );
+      if ( error != nullptr && _error == nullptr ) _error = error;
+      _compressedBlocks.emplace( block->sequenceNumber, std::move( block ) );
+      for ( auto next = _compressedBlocks.find( _numWrittenBlocks ); next != _compressedBlocks.end( );
+            next = _compressedBlocks.find( ++_numWrittenBlocks ) )
+         {
+         try
+            { if ( _error == nullptr ) writeBlockLocked( *next->second ); }
+         catch ( ... )
+            { _error = std::current_exception( ); }
+         _compressedBlocks.erase( next );
+         }
+      _blockWritten.notifyAll( );
+      }
+   }
+
+void SegmentWriter::writeBlockLocked( Block &block )
+   {
+   // Stores a block that does not compress as is.
+   auto compression = _config.compression;
+   StringView compressedData = block.compressedData;
+   if ( compressedData.size( ) >= block.data.size( ) ) compression = Compression::None, compressedData = block.data;
+   const BlockHeader header{ static_cast<uint32_t>(compressedData.size( )), static_cast<uint32_t>(block.data.size( )),
+                             compression, { } };
+   const auto blockSize = sizeof( header ) + compressedData.size( );
+
+   if ( _segmentSize > 0 && _segmentSize + blockSize > _config.maxSegmentSize )
+      {
+      commitLocked( );
+      closeSegment( );
+      openSegment( _segment + 1 );
+      }
+
+   for ( auto &entry : block.entries )
+      {
+      entry.offset = _segmentSize;
+      _pendingEntries.emplace_back( entry );
+      }
+   _buffer.append( reinterpret_cast<const char *>(&header), sizeof( header ) );
+   _buffer.append( compressedData );
+   _segmentSize += blockSize;
+   _numUncompressedBytes += block.data.size( );
+   _numCompressedBytes += blockSize;
+   if ( _buffer.size( ) >= _config.groupCommitSize ) commitLocked( );
+   }
+
+void SegmentWriter::commitLocked( )
+   {
+   if ( _pendingEntries.empty( ) ) return;
+   if ( _config.beforeCommit ) _config.beforeCommit( );
+
+   // Truncates both files back to the last commit on failure, so that a retry writes the buffer at the offsets of its
+   // index entries instead of after the bytes that made it to the file.
+   const auto dataSize = static_cast<off_t>(_segmentSize - _buffer.size( ));
+   const auto indexSize = ::lseek( _indexFile, 0, SEEK_END );
+   if ( indexSize == -1 ) throw SystemException( );
+   try
+      {
+      writeAll( _dataFile, _buffer.data( ), _buffer.size( ) );
+      if ( ::fdatasync( _dataFile ) == -1 ) throw SystemException( );
+      writeAll( _indexFile, reinterpret_cast<const char *>(_pendingEntries.data( )),
+                _pendingEntries.size( ) * sizeof( IndexEntry ) );
+      if ( ::fdatasync( _indexFile ) == -1 ) throw SystemException( );
+      }
+   catch ( ... )
+      {
+      if ( ::ftruncate( _dataFile, dataSize ) == 0 ) ::lseek( _dataFile, 0, SEEK_END );
+      if ( ::ftruncate( _indexFile, indexSize ) == 0 ) ::lseek( _indexFile, 0, SEEK_END );
+      throw;
+      }
+
+   _buffer.clear( );
+   _pendingEntries.clear( );
+   }
+
+void SegmentWriter::rethrowErrorLocked( ) const
+   {
+   if ( _error != nullptr ) std::rethrow_exception( _error );
+   }
+
+SegmentReader::SegmentReader( const std::filesystem::path &directory )
+   {
+   const auto numSegments = SegmentWriter::countSegments( directory );
+   _segments.resize( numSegments );
+   for ( auto i = 0; i < numSegments; ++i )
+      {
+      auto &segment = _segments[ i ];
+      segment.firstDocId = _numRecords;
+      segment.isCompressed = SegmentWriter::isCompressed( directory, i );
+      segment.dataFile = ::open( SegmentWriter::dataPath( directory, i, segment.isCompressed ).c_str( ), O_RDONLY );
+      if ( segment.dataFile == -1 ) throw SystemException( );
+
+      std::ifstream indexFile( SegmentWriter::indexPath( directory, i ), std::ios::binary );
+      if ( !indexFile.is_open( ) ) throw IOException( "The segment index file cannot be opened." );
+      SegmentWriter::IndexEntry entry{ };
+      while ( indexFile.read( reinterpret_cast<char *>(&entry), sizeof( entry ) ) )
+         segment.entries.emplace_back( entry );
+      _numRecords += segment.entries.size( );
+      }
+   }
+
+SegmentReader::~SegmentReader( )
+   {
+   for ( const auto &segment : _segments )
+      if ( segment.dataFile != -1 ) ::close( segment.dataFile );
+   }
+
+String SegmentReader::read( DocId docId ) const
+   {
+   if ( docId >= _numRecords )
+      throw ArgumentException( "The record does not exist." );
+
+   const auto segment = std::prev( std::upper_bound( _segments.cbegin( ), _segments.cend( ), docId,
+                                                     [ ]( DocId docId, const Segment &segment )
+                                                        { return docId < segment.firstDocId; } ) );
+   const auto &entry = segment->entries[ docId - segment->firstDocId ];
+   if ( segment->isCompressed )
+      {
+      String compressedBlock, block;
+      readBlock( *segment, entry.offset, compressedBlock, block );
+      if ( entry.offsetInBlock + entry.length > block.size( ) )
+         throw FormatException( "The record is past the end of its block." );
+      return block.substr( entry.offsetInBlock, entry.length );
+      }
+
+   String record( entry.length, '\0' );
+   readAll( segment->dataFile, record.data( ), record.size( ), entry.offset );
+   return record;
+   }
+
+void SegmentReader::scan( const std::function<void( DocId, StringView )> &callback ) const
+   {
+   String buffer, compressedBlock;
+   for ( const auto &segment : _segments )
+      {
+      if ( segment.entries.empty( ) ) continue;
+      if ( segment.isCompressed )
+         {
+         // Decompresses each block once, for all of its records.
+         auto blockOffset = UINT64_MAX;
+         for ( size_t i = 0; i < segment.entries.size( ); ++i )
+            {
+            const auto &entry = segment.entries[ i ];
+            if ( entry.offset != blockOffset )
+               readBlock( segment, blockOffset = entry.offset, compressedBlock, buffer );
+            if ( entry.offsetInBlock + entry.length > buffer.size( ) )
+               throw FormatException( "The record is past the end of its block." );
+            callback( segment.firstDocId + i, StringView( buffer ).substr( entry.offsetInBlock, entry.length ) );
+            }
+         continue;
+         }
+      const auto segmentSize = segment.entries.back( ).offset + segment.entries.back( ).length;
+
+      // Refills the buffer from the first record that it does not hold whole, since records are back to back.
+      uint64_t bufferOffset = 0, bufferSize = 0;
+      for ( size_t i = 0; i < segment.entries.size( ); ++i )
+         {
+         const auto &entry = segment.entries[ i ];
+         if ( entry.offset + entry.length > bufferOffset + bufferSize )
+            {
+            bufferOffset = entry.offset;
+            bufferSize = std::min<uint64_t>( std::max<uint64_t>( _scanBufferSize, entry.length ),
+                                             segmentSize - entry.offset );
+            if ( buffer.size( ) < bufferSize ) buffer.resize( bufferSize );
+            readAll( segment.dataFile, buffer.data( ), bufferSize, bufferOffset );
+            }
+         callback( segment.firstDocId + i,
+                   StringView( buffer.data( ) + ( entry.offset - bufferOffset ), entry.length ) );
+         }
+      }
+   }
+
+void SegmentReader::readAll( int fileDescriptor, char *data, size_t size, uint64_t offset )
+   {
+   while ( size > 0 )
+      {
+      const auto numRead = ::pread( fileDescriptor, data, size, static_cast<off_t>(offset) );
+      if ( numRead == -1 )
+         {
+         if ( errno == EINTR ) continue;
+         throw SystemException( );
+         }
+      if ( numRead == 0 ) throw IOException( "The segment data file is truncated." );
+      data += numRead, size -= numRead, offset += numRead;
+      }
+   }
+
+void SegmentReader::readBlock( const Segment &segment, uint64_t offset, String &compressedBlock, String &block )
+   {
+   SegmentWriter::BlockHeader header{ };
+   readAll( segment.dataFile, reinterpret_cast<char *>(&header), sizeof( header ), offset );
+   compressedBlock.resize( header.compressedSize );
+   readAll( segment.dataFile, compressedBlock.data( ), compressedBlock.size( ), offset + sizeof( header ) );
+   block.resize( header.size );
+   BlockCodec::decompress( header.compression, compressedBlock, block );
+   }
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "storage/term_dictionary.h"
+
+namespace
+   {
+   void appendVarint( String &data, uint64_t value )
+      {
+      for ( ; value >= 0x80; value >>= 7 ) data += static_cast<char>(value | 0x80);
+      data += static_cast<char>(value);
+      }
+
+   // Reads a varint, or returns `nullopt` if the data ends before it does.
+   std::optional<uint64_t> readVarint( const char *&data, const char *end ) noexcept
+      {
+      uint64_t value = 0;
+      for ( auto shift = 0; data != end && shift < 64; shift += 7 )
+         {
+         const auto byte = static_cast<uint8_t>(*data++);
+         value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+         if ( !( byte & 0x80 ) ) return value;
+         }
+      return std::nullopt;
+      }
+   }
+
+TermDictionary::TermDictionary( ) : _chunks( new std::atomic<StringView *>[ _maxNumChunks ]( ) )
+   { }
+
+TermDictionary::TermDictionary( std::filesystem::path path, bool isReadOnly ) : TermDictionary( )
+   {
+   _path = std::move( path );
+   _file = ::open( _path->c_str( ), isReadOnly ? O_RDONLY : O_RDWR | O_CREAT | O_APPEND, 0644 );
+   if ( _file == -1 ) throw SystemException( );
+
+   String data( std::filesystem::file_size( _path.value( ) ), '\0' );
+   for ( size_t numRead = 0; numRead < data.size( ); )
+      {
+      const auto result = ::pread( _file, data.data( ) + numRead, data.size( ) - numRead,
+                                   static_cast<off_t>(numRead) );
+      if ( result == -1 && errno != EINTR ) throw SystemException( );
+      if ( result == 0 ) break;
+      if ( result > 0 ) numRead += result;
+      }
+
+   // Interns the terms in file order, so that they get their IDs back, up to the first torn term.
+   const auto *current = data.data( ), *end = current + data.size( );
+   for ( const auto *termBegin = current; current != end; termBegin = current )
+      {
+      const auto size = readVarint( current, end );
+      if ( !size.has_value( ) || size.value( ) > static_cast<uint64_t>(end - current) )
+         {
+         // Leaves a torn term to the writer, which may be appending it right now, when only reading.
+         if ( !isReadOnly && ::ftruncate( _file, termBegin - data.data( ) ) == -1 ) throw SystemException( );
+         current = termBegin;
+         break;
+         }
+      intern( StringView( current, size.value( ) ) );
+      current += size.value( );
+      }
+   _numPersistedTerms = size( );
+   _persistedSize = current - data.data( );
+   if ( isReadOnly )
+      {
+      ::close( _file );
+      _file = -1;
+      _path.reset( );
+      }
+   }
+
+TermDictionary::~TermDictionary( )
+   {
+   try
+      { persist( ); }
+   catch ( ... )
+      { }
+   if ( _file != -1 ) ::close( _file );
+   for ( size_t i = 0; i < _maxNumChunks; ++i ) delete[] _chunks[ i ].load( std::memory_order_relaxed );
+   }
+
+TermId TermDictionary::intern( StringView term )
+   {
+   auto &shard = shardOf( term );
+   UniqueLock lock( shard.mutex );
+   if ( const auto it = shard.termIds.find( term ); it != shard.termIds.cend( ) ) return it->second;
+
+   UniqueLock termIdLock( _termIdMutex );
+   const auto numTerms = _numTerms.load( std::memory_order_relaxed );
+   if ( numTerms == _maxNumChunks * _chunkSize ) throw InvalidOperationException( "The term dictionary is full." );
+   const auto termId = static_cast<TermId>(numTerms);
+   const auto storedTerm = storeLocked( shard, term );
+   shard.termIds.emplace( storedTerm, termId );
+
+   auto *chunk = _chunks[ termId >> _chunkBits ].load( std::memory_order_relaxed );
+   if ( chunk == nullptr )
+      {
+      chunk = new StringView[ _chunkSize ];
+      _chunks[ termId >> _chunkBits ].store( chunk, std::memory_order_relaxed );
+      }
+   // Points at the stored term, which never moves, and publishes it with the new number of terms.
+   chunk[ termId & ( _chunkSize - 1 ) ] = storedTerm;
+   _numTerms.store( numTerms + 1, std::memory_order_release );
+   return termId;
+   }
+
+std::optional<TermId> TermDictionary::find( StringView term ) const
+   {
+   const auto &shard = shardOf( term );
+   UniqueLock lock( shard.mutex );
+   if ( const auto it = shard.termIds.find( term ); it != shard.termIds.cend( ) ) return it->second;
+   return std::nullopt;
+   }
+
+StringView TermDictionary::storeLocked( Shard &shard, StringView term )
+   {
+   // Starts a new block when the term does not fit, and gives a term larger than a block a block of its own.
+   if ( shard.termBlocks.empty( ) || term.size( ) > shard.blockSize - shard.blockUsedSize )
+      {
+      shard.blockSize = std::max( _termBlockSize, term.size( ) );
+      shard.termBlocks.emplace_back( new char[ shard.blockSize ] );
+      shard.blockUsedSize = 0;
+      }
+   auto *storedTerm = shard.termBlocks.back( ).get( ) + shard.blockUsedSize;
+   std::copy( term.cbegin( ), term.cend( ), storedTerm );
+   shard.blockUsedSize += term.size( );
+   return { storedTerm, term.size( ) };
+   }
+
+StringView TermDictionary::term( TermId termId ) const
+   {
+   if ( termId >= _numTerms.load( std::memory_order_acquire ) )
+      throw FormatException( STRING( "The term ID " << termId << " is not in the dictionary." ) );
+   return _chunks[ termId >> _chunkBits ].load( std::memory_order_relaxed )[ termId & ( _chunkSize - 1 ) ];
+   }
+
+void TermDictionary::persist( )
+   {
+   if ( !_path.has_value( ) ) return;
+   UniqueLock lock( _fileMutex );
+   const auto numTerms = size( );
+   if ( numTerms == _numPersistedTerms ) return;
+
+   String data;
+   for ( auto termId = _numPersistedTerms; termId < numTerms; ++termId )
+      {
+      const auto termString = term( static_cast<TermId>(termId) );
+      appendVarint( data, termString.size( ) );
+      data.append( termString );
+      }
+   // Truncates a partial write, so that the next call appends the same terms again at the same offset.
+   for ( size_t numWritten = 0; numWritten < data.size( ); )
+      {
+      const auto result = ::write( _file, data.data( ) + numWritten, data.size( ) - numWritten );
+      if ( result == -1 )
+         {
+         if ( errno == EINTR ) continue;
+         const SystemException exception;
+         ::ftruncate( _file, static_cast<off_t>(_persistedSize) );
+         throw exception;
+         }
+      numWritten += result;
+      }
+   if ( ::fdatasync( _file ) == -1 ) throw SystemException( );
+   _numPersistedTerms = numTerms;
+   _persistedSize += data.size( );
+   }
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <fcntl.h>
+#include <iomanip>
+#include <random>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "storage/warc_archive.h"
+
+namespace
+   {
+   String currentUtcDateTime( )
+      {
+      const auto time = std::time( nullptr );
+      tm utcTime{ };
+      ::gmtime_r( &time, &utcTime );
+      return STRING( std::put_time( &utcTime, "%Y-%m-%dT%H:%M:%SZ" ) );
+      }
+
+   String randomUuid( )
+      {
+      thread_local std::mt19937_64 random( std::random_device{ }( ) );
+      const auto high = ( random( ) & ~0xf000ull ) | 0x4000ull; // Version 4.
+      const auto low = ( random( ) & ~( 0x3ull << 62 ) ) | 0x2ull << 62; // Variant 1.
+      return STRING( std::hex << std::setfill( '0' ) << std::setw( 8 ) << ( high >> 32 ) << '-' << std::setw( 4 )
+                              << ( high >> 16 & 0xffff ) << '-' << std::setw( 4 ) << ( high & 0xffff ) << '-'
+                              << std::setw( 4 ) << ( low >> 48 ) << '-' << std::setw( 12 )
+                              << ( low & 0xffffffffffffull ) );
+      }
+   }
+
+WarcWriter::WarcWriter( std::filesystem::path directory, const WarcArchiveConfiguration &config ) :
+      _directory( std::move( directory ) ), _config( config ), _writeQueue( *this, _config.writeQueue )
+   {
+   std::filesystem::create_directories( _directory );
+
+   // Starts a new archive file after those of earlier runs.
+   auto file = 0;
+   while ( std::filesystem::exists( filePath( _directory, file ) ) ) ++file;
+   openFile( file );
+   }
+
+WarcWriter::~WarcWriter( )
+   {
+   try
+      { flush( ); }
+   catch ( ... )
+      { }
+   }
+
+void WarcWriter::write( const Url &requestUrl, const HttpResponseMessage &response )
+   {
+   const auto payload = STRING( response );
+   auto record = STRING( "WARC/1.0\r\n"
+                               "WARC-Type: response\r\n"
+                               "WARC-Target-URI: " << requestUrl << "\r\n"
+                               "WARC-Date: " << currentUtcDateTime( ) << "\r\n"
+                               "WARC-Record-ID: <urn:uuid:" << randomUuid( ) << ">\r\n"
+                               "Content-Type: application/http; msgtype=response\r\n"
+                               "Content-Length: " << payload.size( ) << "\r\n\r\n" );
+   record.append( payload ).append( "\r\n\r\n" );
+   auto queuedRecord = STRING( requestUrl << ' ' );
+   queuedRecord.append( compressMember( record, _config.compressionLevel ) );
+   _writeQueue.push( std::move( queuedRecord ) );
+   ++_numRecords;
+   }
+
+void WarcWriter::flush( )
+   { _writeQueue.flush( ); }
+
+void WarcWriter::appendBatch( std::span<const StringView> records )
+   {
+   UniqueLock lock( _mutex );
+   for ( const auto record : records )
+      {
+      const auto urlEnd = record.find( ' ' );
+      const auto member = record.substr( urlEnd + 1 );
+      _fileStream.write( member.data( ), static_cast<std::streamsize>(member.size( )) );
+      if ( !_fileStream ) throw IOException( "The archive file cannot be written." );
+      _indexEntries.emplace_back( WarcIndexEntry{ String( record.substr( 0, urlEnd ) ), _file, _fileSize,
+                                                  member.size( ) } );
+      _fileSize += member.size( );
+      if ( _fileSize >= _config.maxFileSize )
+         {
+         _fileStream.flush( );
+         if ( !_fileStream ) throw IOException( "The archive file cannot be written." );
+         writeIndexLocked( );
+         openFile( _file + 1 );
+         }
+      }
+   }
+
+void WarcWriter::commit( )
+   {
+   UniqueLock lock( _mutex );
+   _fileStream.flush( );
+   if ( !_fileStream ) throw IOException( "The archive file cannot be written." );
+   writeIndexLocked( );
+   }
+
+void WarcWriter::writeIndexLocked( )
+   {
+   if ( _indexEntries.empty( ) ) return;
+
+   // Sorts the index stably, so that the responses from the same URL stay in the order that they were archived.
+   auto indexEntries = _indexEntries;
+   std::stable_sort( indexEntries.begin( ), indexEntries.end( ) );
+   const auto tempIndexPath = indexPath( _directory, _file ).concat( ".tmp" );
+   std::ofstream indexFile( tempIndexPath );
+   if ( !indexFile.is_open( ) ) throw IOException( "The archive index cannot be opened." );
+   for ( const auto &entry : indexEntries )
+      indexFile << entry.url << ' ' << entry.file << ' ' << entry.offset << ' ' << entry.length << '\n';
+   indexFile.close( );
+   if ( !indexFile ) throw IOException( "The archive index cannot be written." );
+   std::filesystem::rename( tempIndexPath, indexPath( _directory, _file ) );
+   }
+
+std::filesystem::path WarcWriter::filePath( const std::filesystem::path &directory, int file )
+   { return directory / STRING( "archive-" << std::setw( 6 ) << std::setfill( '0' ) << file << ".warc.gz" ); }
+
+std::filesystem::path WarcWriter::indexPath( const std::filesystem::path &directory, int file )
+   { return directory / STRING( "archive-" << std::setw( 6 ) << std::setfill( '0' ) << file << ".cdx" ); }
+
+String WarcWriter::compressMember( StringView data, int level )
+   {
+   z_stream stream{ };
+   // Writes a gzip header and trailer instead of a zlib one.
+   if ( deflateInit2( &stream, level != 0 ? level : Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                      Z_DEFAULT_STRATEGY ) != Z_OK )
+      throw ArgumentException( "The gzip compression level is invalid." );
+   String member( deflateBound( &stream, data.size( ) ), '\0' );
+   stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data( )));
+   stream.avail_in = static_cast<uInt>(data.size( ));
+   stream.next_out = reinterpret_cast<Bytef *>(member.data( ));
+   stream.avail_out = static_cast<uInt>(member.size( ));
+   const auto result = deflate( &stream, Z_FINISH );
+   member.resize( stream.total_out );
+   deflateEnd( &stream );
+   if ( result != Z_STREAM_END ) throw IOException( "The archive record cannot be compressed." );
+   return member;
+   }
+
+String WarcWriter::decompressMember( StringView member )
+   {
+   z_stream stream{ };
+   if ( inflateInit2( &stream, 15 + 16 ) != Z_OK ) throw FormatException( "The archive record cannot be inflated." );
+   String data( member.size( ) * 4, '\0' );
+   stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(member.data( )));
+   stream.avail_in = static_cast<uInt>(member.size( ));
+   auto result = Z_OK;
+   while ( result == Z_OK )
+      {
+      if ( stream.total_out == data.size( ) ) data.resize( data.size( ) * 2 );
+      stream.next_out = reinterpret_cast<Bytef *>(data.data( ) + stream.total_out);
+      stream.avail_out = static_cast<uInt>(data.size( ) - stream.total_out);
+      result = inflate( &stream, Z_NO_FLUSH );
+      }
+   data.resize( stream.total_out );
+   inflateEnd( &stream );
+   if ( result != Z_STREAM_END ) throw FormatException( "The archive record is corrupt." );
+   return data;
+   }
+
+void WarcWriter::openFile( int file )
+   {
+   _file = file;
+   _fileStream.close( );
+   _fileStream.open( filePath( _directory, file ), std::ios::binary | std::ios::app );
+   if ( !_fileStream.is_open( ) ) throw IOException( "The archive file cannot be opened." );
+   _fileSize = 0;
+   _indexEntries.clear( );
+   }
+
+WarcReader::WarcReader( std::filesystem::path directory ) : _directory( std::move( directory ) )
+   {
+   for ( auto file = 0; std::filesystem::exists( WarcWriter::filePath( _directory, file ) ); ++file )
+      {
+      _files.emplace_back( ::open( WarcWriter::filePath( _directory, file ).c_str( ), O_RDONLY ) );
+      if ( _files.back( ) == -1 ) throw SystemException( );
+
+      // Skips the index of an archive file that a crash left without one; its records are not found.
+      std::ifstream indexFile( WarcWriter::indexPath( _directory, file ) );
+      if ( !indexFile.is_open( ) ) continue;
+      const auto firstEntry = _entries.size( );
+      for ( WarcIndexEntry entry; indexFile >> entry.url >> entry.file >> entry.offset >> entry.length; )
+         _entries.emplace_back( std::move( entry ) );
+      if ( !indexFile.eof( ) ) throw FormatException( "The archive index is malformed." );
+      if ( !std::is_sorted( _entries.cbegin( ) + static_cast<ptrdiff_t>(firstEntry), _entries.cend( ) ) )
+         throw FormatException( "The archive index is not sorted." );
+      }
+
+   // Merges the indexes stably, so that the responses from the same URL stay in the order of the archive files.
+   std::stable_sort( _entries.begin( ), _entries.end( ) );
+   }
+
+WarcReader::~WarcReader( )
+   {
+   for ( const auto file : _files )
+      if ( file != -1 ) ::close( file );
+   }
+
+const WarcIndexEntry *WarcReader::find( const Url &url ) const
+   {
+   const WarcIndexEntry key{ url.toString( ) };
+   const auto next = std::upper_bound( _entries.cbegin( ), _entries.cend( ), key );
+   return next != _entries.cbegin( ) && std::prev( next )->url == key.url ? &*std::prev( next ) : nullptr;
+   }
+
+HttpResponseMessage WarcReader::read( const WarcIndexEntry &entry ) const
+   {
+   if ( entry.file < 0 || entry.file >= static_cast<int>(_files.size( )) )
+      throw FormatException( "The archive file does not exist." );
+   String member( entry.length, '\0' );
+   for ( size_t numRead = 0; numRead < member.size( ); )
+      {
+      const auto result = ::pread( _files[ entry.file ], member.data( ) + numRead, member.size( ) - numRead,
+                                   static_cast<off_t>(entry.offset + numRead) );
+      if ( result == -1 && errno != EINTR ) throw SystemException( );
+      if ( result == 0 ) throw FormatException( "The archive file is truncated." );
+      if ( result > 0 ) numRead += result;
+      }
+
+   // Finds the HTTP response after the WARC headers, by its Content-Length.
+   const auto record = WarcWriter::decompressMember( member );
+   const auto headersEnd = record.find( "\r\n\r\n" );
+   if ( !record.starts_with( "WARC/" ) || headersEnd == String::npos )
+      throw FormatException( "The archive record is malformed." );
+   const StringView contentLengthName = "\r\nContent-Length: ";
+   const auto contentLengthPos = record.find( contentLengthName );
+   if ( contentLengthPos == String::npos || contentLengthPos > headersEnd )
+      throw FormatException( "The archive record has no Content-Length." );
+   const auto *contentLengthBegin = record.data( ) + contentLengthPos + contentLengthName.size( );
+   uint64_t contentLength;
+   const auto [ contentLengthEnd, error ] = std::from_chars( contentLengthBegin, record.data( ) + headersEnd,
+                                                             contentLength );
+   if ( error != std::errc( ) || *contentLengthEnd != '\r' )
+      throw FormatException( "The archive record has an invalid Content-Length." );
+   if ( contentLength > record.size( ) - headersEnd - 4 ) throw FormatException( "The archive record is truncated." );
+
+   std::istringstream stream( record.substr( headersEnd + 4, contentLength ) );
+   HttpResponseMessage response;
+   stream >> response;
+   return response;
+   }
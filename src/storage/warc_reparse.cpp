@@ -0,0 +1,69 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "storage/page_record.h"
+#include "storage/segment_store.h"
+#include "storage/warc_archive.h"
+#include "storage/write_behind_queue.h"
+
+// Parses the archived responses of a raw response archive again, e.g. after the parser changes, into binary page
+// records in a segment store, without fetching anything. The threads parse interleaved index entries.
+// Usage: warc_reparse_cli <archive_dir> <store_dir> [num_threads]
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 3 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <archive_dir> <store_dir> [num_threads]" << std::endl;
+      return 1;
+      }
+   const auto numThreads = argc > 3 ? std::max( std::stoi( argv[ 3 ] ), 1 )
+                                    : std::max( static_cast<int>(std::thread::hardware_concurrency( )), 1 );
+
+   const WarcReader archive( argv[ 1 ] );
+   SegmentWriter pageStore( argv[ 2 ] );
+   WriteBehindQueue pageWriteQueue( pageStore );
+   HtmlParser htmlParser;
+   htmlParser.isRecovering = true;
+
+   const auto entries = archive.entries( );
+   std::atomic<long> numParsed = 0, numSkipped = 0;
+   const auto beginTime = std::chrono::steady_clock::now( );
+   Vector<Thread> threads;
+   for ( auto i = 0; i < numThreads; ++i )
+      threads.emplace_back( [ &, i ]( )
+         {
+         PageArena pageArena;
+         for ( auto j = static_cast<size_t>(i); j < entries.size( ); j += numThreads )
+            try
+               {
+               const auto response = archive.read( entries[ j ] );
+               if ( const auto &contentType = response.headers.contentType;
+                     contentType.has_value( ) && contentType->find( "text/html" ) == String::npos )
+                  {
+                  ++numSkipped;
+                  continue;
+                  }
+
+               String pageRecord;
+               PageRecord::encode( entries[ j ].url, htmlParser.parse( response.content, pageArena ), pageRecord );
+               pageWriteQueue.push( std::move( pageRecord ) );
+               ++numParsed;
+               }
+            catch ( const FormatException &e )
+               {
+               ++numSkipped;
+               std::cerr << "Skipped " << entries[ j ].url << " (" << e.message( ) << ")." << std::endl;
+               }
+         } );
+   for ( auto &thread : threads )
+      thread.join( );
+   pageWriteQueue.flush( );
+
+   const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   std::cout << "Parsed " << numParsed << " pages and skipped " << numSkipped << " in " << std::fixed
+             << std::setprecision( 2 ) << seconds << " s [" << std::setprecision( 0 ) << numParsed / seconds
+             << " pages/s]." << std::endl;
+   }
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#include "core/file_system.h"
+#include "storage/write_behind_queue.h"
+
+WriteBehindQueue::WriteBehindQueue( RecordAppender &recordAppender, const WriteBehindConfiguration &config ) :
+      _recordAppender( recordAppender ), _config( config )
+   {
+   for ( auto i = 0; i < std::max( _config.numWriterThreads, 1 ); ++i )
+      _writerThreads.emplace_back( [ this ]( )
+         { writeRecords( ); } );
+   }
+
+WriteBehindQueue::~WriteBehindQueue( )
+   {
+   try
+      { flush( ); }
+   catch ( ... )
+      { }
+
+      {
+      UniqueLock lock( _mutex );
+      _isClosing = true;
+      _recordPushed.notifyAll( );
+      }
+   for ( auto &thread : _writerThreads )
+      thread.join( );
+   }
+
+void WriteBehindQueue::push( String record )
+   {
+   UniqueLock lock( _mutex );
+   if ( _error != nullptr ) std::rethrow_exception( _error );
+   const auto isFull = [ & ]( )
+      { return _queueSize > 0 && _queueSize + record.size( ) > _config.maxQueueSize; };
+   if ( isFull( ) )
+      {
+      ++_numStalls;
+      _recordsTaken.wait( lock, [ & ]( )
+         { return !isFull( ); } );
+      }
+
+   _queueSize += record.size( );
+   _records.push( std::move( record ) );
+   ++_numPushed;
+   if ( _queueSize > _peakQueueSize.load( std::memory_order_relaxed ) )
+      _peakQueueSize.store( _queueSize, std::memory_order_relaxed );
+   _recordPushed.notifyOne( );
+   }
+
+void WriteBehindQueue::flush( )
+   {
+   UniqueLock lock( _mutex );
+   // Waits until the records pushed so far are taken, and the batches taken before them are written.
+   const auto numPushed = _numPushed;
+   _recordsWritten.wait( lock, [ & ]( )
+      {
+      return _numTaken >= numPushed && std::all_of( _batchesInFlight.cbegin( ), _batchesInFlight.cend( ),
+                                                    [ & ]( uint64_t firstRecord )
+                                                       { return firstRecord >= numPushed; } );
+      } );
+   if ( _error != nullptr ) std::rethrow_exception( _error );
+   lock.unlock( );
+
+   _recordAppender.commit( );
+   }
+
+size_t WriteBehindQueue::queueSize( ) const
+   {
+   UniqueLock lock( _mutex );
+   return _queueSize;
+   }
+
+double WriteBehindQueue::meanWriteLatency( ) const noexcept
+   {
+   const auto numBatches = _numBatches.load( std::memory_order_relaxed );
+   return numBatches > 0 ? static_cast<double>(_writeNanoseconds.load( std::memory_order_relaxed )) / numBatches / 1e6
+                         : 0.0;
+   }
+
+std::ostream &operator<<( std::ostream &stream, const WriteBehindQueue &writeBehindQueue )
+   {
+   return stream << "Write queue: " << fileSizeToString( writeBehindQueue.queueSize( ) ) << " (peak "
+                 << fileSizeToString( writeBehindQueue.peakQueueSize( ) )
+                 << ")\tStalls: " << writeBehindQueue.numStalls( ) << "\tWrite latency: "
+                 << STRING( std::fixed << std::setprecision( 1 ) << writeBehindQueue.meanWriteLatency( ) << " ms (max "
+                                       << writeBehindQueue.maxWriteLatency( ) << " ms)" );
+   }
+
+void WriteBehindQueue::writeRecords( )
+   {
+   Vector<String> batch;
+   Vector<StringView> batchViews;
+   while ( true )
+      {
+      // Takes the queued records up to the batch size, but at least one record.
+      UniqueLock lock( _mutex );
+      _recordPushed.wait( lock, [ & ]( )
+         { return !_records.empty( ) || _isClosing; } );
+      if ( _records.empty( ) ) return;
+      size_t batchSize = 0;
+      while ( !_records.empty( ) &&
+              ( batch.empty( ) || batchSize + _records.front( ).size( ) <= _config.maxBatchSize ) )
+         {
+         batchSize += _records.front( ).size( );
+         batch.emplace_back( std::move( _records.front( ) ) );
+         _records.pop( );
+         }
+      const auto firstRecord = _numTaken;
+      _numTaken += batch.size( );
+      _batchesInFlight.emplace_back( firstRecord );
+      _queueSize -= batchSize;
+      _recordsTaken.notifyAll( );
+      lock.unlock( );
+
+      std::exception_ptr error;
+      const auto beginTime = std::chrono::steady_clock::now( );
+      try
+         {
+         batchViews.assign( batch.cbegin( ), batch.cend( ) );
+         _recordAppender.appendBatch( batchViews );
+         }
+      catch ( ... )
+         { error = std::current_exception( ); }
+      const auto writeNanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now( ) - beginTime ).count( ));
+
+      lock.lock( );
+      ++_numBatches;
+      _writeNanoseconds += writeNanoseconds;
+      if ( writeNanoseconds > _maxWriteNanoseconds.load( std::memory_order_relaxed ) )
+         _maxWriteNanoseconds.store( writeNanoseconds, std::memory_order_relaxed );
+      if ( error != nullptr && _error == nullptr ) _error = error;
+      _batchesInFlight.erase( std::find( _batchesInFlight.begin( ), _batchesInFlight.end( ), firstRecord ) );
+      _recordsWritten.notifyAll( );
+      lock.unlock( );
+      batch.clear( );
+      }
+   }
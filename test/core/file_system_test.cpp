@@ -1,11 +1,13 @@
-#include <gtest/gtest.h>
-
-#include "core/file_system.h"
-
-TEST( FileSystemTest, FileSizeToString )
-   {
-   EXPECT_EQ( fileSizeToString( 512 ), "512 B" );
-   EXPECT_EQ( fileSizeToString( 512 * 1024 ), "512 KB" );
-   EXPECT_EQ( fileSizeToString( 512 * 1024 * 1024 ), "512 MB" );
-   EXPECT_EQ( fileSizeToString( 50000 ), "48.8 KB" );
-   }
+#include <gtest/gtest.h>
+
+#include "core/file_system.h"
+
+TEST( FileSystemTest, FileSizeToString )
+   {
+   EXPECT_EQ( fileSizeToString( 512 ), "512 B" );
+   EXPECT_EQ( fileSizeToString( 512 * 1024 ), "512 KB" );
+   EXPECT_EQ( fileSizeToString( 512 * 1024 * 1024 ), "512 MB" );
+   EXPECT_EQ( fileSizeToString( 50000 ), "48.8 KB" );
+   EXPECT_EQ( fileSizeToString( size_t( 3 ) << 30 ), "3 GB" );
+   EXPECT_EQ( fileSizeToString( size_t( 5 ) << 40 ), "5 TB" );
+   }
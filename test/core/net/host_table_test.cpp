@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "core/net/host_table.h"
+#include "core/net/url.h"
+
+TEST( HostTableTest, Intern )
+   {
+   HostTable hostTable;
+   EXPECT_EQ( hostTable.intern( "www.google.com" ), 0 );
+   EXPECT_EQ( hostTable.intern( "www.cnn.com" ), 1 );
+   EXPECT_EQ( hostTable.intern( "www.google.com" ), 0 );
+   EXPECT_EQ( hostTable.size( ), 2 );
+   EXPECT_EQ( hostTable.hostOf( 1 ), "www.cnn.com" );
+   EXPECT_EQ( hostTable.find( "www.cnn.com" ), 1 );
+   EXPECT_FALSE( hostTable.find( "www.nytimes.com" ).has_value( ) );
+   }
+
+TEST( HostTableTest, ConcurrentIntern )
+   {
+   static constexpr auto numThreads = 4, numHosts = 10'000;
+   HostTable hostTable;
+   Vector<Thread> threads;
+   for ( auto i = 0; i < numThreads; ++i )
+      threads.emplace_back( [ & ]( )
+                               {
+                               for ( auto j = 0; j < numHosts; ++j )
+                                  hostTable.intern( STRING( "host" << j << ".com" ) );
+                               } );
+   for ( auto &thread : threads ) thread.join( );
+
+   EXPECT_EQ( hostTable.size( ), numHosts );
+   for ( auto j = 0; j < numHosts; ++j )
+      EXPECT_EQ( hostTable.hostOf( hostTable.find( STRING( "host" << j << ".com" ) ).value( ) ),
+                 STRING( "host" << j << ".com" ) );
+   }
+
+TEST( HostTableTest, UrlHostId )
+   {
+   const Url url( "https://www.google.com/index.html" );
+   EXPECT_EQ( url.hostId( ), Url( "http://www.google.com:8080/about" ).hostId( ) );
+   EXPECT_EQ( url.hostId( ), Url( url, "/search?q=test" ).hostId( ) );
+   EXPECT_NE( url.hostId( ), Url( "https://www.cnn.com" ).hostId( ) );
+   EXPECT_EQ( HostTable::global( ).hostOf( url.hostId( ) ), "www.google.com" );
+
+   // Interns a host only when its ID is asked for, and keeps the ID once interned.
+   Url otherUrl( "https://www.example.org/" );
+   EXPECT_EQ( HostTable::global( ).find( "www.example.org" ), std::nullopt );
+   const auto otherHostId = otherUrl.internHost( );
+   EXPECT_EQ( HostTable::global( ).hostOf( otherHostId ), "www.example.org" );
+   EXPECT_EQ( otherUrl.hostId( ), otherHostId );
+   EXPECT_EQ( Url( otherUrl, "/about" ).hostId( ), otherHostId );
+   }
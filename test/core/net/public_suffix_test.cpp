@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "core/net/public_suffix.h"
+#include "core/net/url.h"
+
+TEST( PublicSuffixListTest, PublicSuffix )
+   {
+   const auto &publicSuffixList = PublicSuffixList::bundled( );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "www.google.com" ), "com" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "www.bbc.co.uk" ), "co.uk" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "example.unknowntld" ), "unknowntld" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "a.b.sch.uk" ), "b.sch.uk" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "www.ck" ), "ck" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "city.kawasaki.jp" ), "kawasaki.jp" );
+   EXPECT_EQ( publicSuffixList.publicSuffix( "foo.bar.kawasaki.jp" ), "bar.kawasaki.jp" );
+   }
+
+TEST( PublicSuffixListTest, RegistrableDomain )
+   {
+   const auto &publicSuffixList = PublicSuffixList::bundled( );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "a.example.com" ), "example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "b.example.com" ), "example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "example.com" ), "example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "www.BBC.co.uk" ), "BBC.co.uk" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "foo.github.io" ), "foo.github.io" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "co.uk" ), "co.uk" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "www.ck" ), "www.ck" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "a.b.www.ck" ), "www.ck" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "a.city.kawasaki.jp" ), "city.kawasaki.jp" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "example.com." ), "example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "192.168.0.1" ), "192.168.0.1" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "localhost" ), "localhost" );
+   }
+
+TEST( PublicSuffixListTest, CustomRules )
+   {
+   const PublicSuffixList publicSuffixList( { "com", "*.example.com", "!keep.example.com" } );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "a.b.example.com" ), "a.b.example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "x.a.b.example.com" ), "a.b.example.com" );
+   EXPECT_EQ( publicSuffixList.registrableDomain( "x.keep.example.com" ), "keep.example.com" );
+   }
+
+TEST( PublicSuffixListTest, UrlRegistrableDomain )
+   {
+   EXPECT_EQ( Url( "https://en.wikipedia.org/wiki/Main_Page" ).registrableDomain( ), "wikipedia.org" );
+   EXPECT_EQ( Url( "http://www.usa.philips.com/content" ).registrableDomain( ), "philips.com" );
+   EXPECT_THROW( auto domain [[gnu::unused]] = Url( "/index.html" ).registrableDomain( ), InvalidOperationException );
+   }
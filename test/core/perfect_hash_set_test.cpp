@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "core/hash_table/perfect_hash_set.h"
+
+TEST( PerfectHashSetTest, Find )
+   {
+   const Vector<String> keys = { "gif", "JPEG", "jpg", "pdf", "jpg" };
+   const PerfectHashSet perfectHashSet( keys );
+   EXPECT_EQ( perfectHashSet.size( ), 4 );
+   EXPECT_EQ( perfectHashSet.find( "gif" ), 0 );
+   EXPECT_EQ( perfectHashSet.find( "jpeg" ), 1 );
+   EXPECT_EQ( perfectHashSet.find( "JPG" ), 2 );
+   EXPECT_EQ( perfectHashSet.find( "Pdf" ), 3 );
+   EXPECT_EQ( perfectHashSet.find( "html" ), -1 );
+   EXPECT_FALSE( perfectHashSet.contains( "" ) );
+   EXPECT_FALSE( PerfectHashSet( ).contains( "gif" ) );
+   }
+
+TEST( PerfectHashSetTest, ManyKeys )
+   {
+   static constexpr auto size = 10'000;
+   Vector<String> keys;
+   for ( auto i = 0; i < size; ++i ) keys.emplace_back( STRING( "host" << i << ".com" ) );
+   const PerfectHashSet perfectHashSet( keys );
+   for ( auto i = 0; i < size; ++i )
+      EXPECT_EQ( perfectHashSet.find( keys[ i ] ), i );
+   for ( auto i = size; i < 2 * size; ++i )
+      EXPECT_FALSE( perfectHashSet.contains( STRING( "host" << i << ".com" ) ) );
+   }
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "crawler/link_filter.h"
+
+using namespace testing;
+
+class LinkFilterTest : public Test
+   {
+   protected:
+      const TagInfo anchor = TagInfo::parse( "<a>" );
+   };
+
+TEST_F( LinkFilterTest, DefaultRules )
+   {
+   const auto linkFilter = LinkFilter::compile( LinkFilter::defaultRules );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://www.example.com/index.html" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.com/image.PNG" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://de.wikipedia.org/wiki/Test" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://en.wikipedia.org/wiki/Test" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.com/" ), TagInfo::parse( "<a hreflang=\"fr\">" ) ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://www.example.com/" ), TagInfo::parse( "<a hreflang=\"en-US\">" ) ) );
+   EXPECT_EQ( linkFilter.numRejected( ), 3 );
+   }
+
+TEST_F( LinkFilterTest, HostsAndDomains )
+   {
+   const auto linkFilter = LinkFilter::compile( R"(
+allow_domain edu example.com  # Only crawls these domains.
+deny_domain private.example.com
+deny_host blocked.umich.edu
+)" );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://www.umich.edu/" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://Example.com/" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://a.b.example.com/" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.private.example.com/" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://blocked.umich.edu/" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.org/" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://notexample.com/" ), anchor ) );
+
+   EXPECT_EQ( linkFilter.numRules( ), 4 );
+   EXPECT_EQ( linkFilter.numHits( 0 ), 0 );
+   EXPECT_EQ( linkFilter.numHits( 1 ), 1 );
+   EXPECT_EQ( linkFilter.numHits( 2 ), 1 );
+   EXPECT_EQ( linkFilter.numHits( 3 ), 2 );
+   }
+
+TEST_F( LinkFilterTest, PathGlobs )
+   {
+   const auto linkFilter = LinkFilter::compile( "deny_path /wp-admin/* */print/*.htm? /search" );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.com/wp-admin/edit.php" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.com/news/print/a.html" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "https://www.example.com/search?q=test" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://www.example.com/search/help" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "https://www.example.com/news/print/a.htm" ), anchor ) );
+   }
+
+TEST_F( LinkFilterTest, MalformedRules )
+   {
+   EXPECT_THROW( LinkFilter::compile( "deny_everything *" ), FormatException );
+   EXPECT_THROW( LinkFilter::compile( "deny_host" ), FormatException );
+   EXPECT_THROW( LinkFilter::compile( "allow_host example.com\ndeny_host Example.com" ), FormatException );
+   EXPECT_THROW( LinkFilter::compile( "deny_domain example.com\nallow_domain example.com" ), FormatException );
+   EXPECT_NO_THROW( LinkFilter::compile( "deny_host example.com\ndeny_host example.com" ) );
+   }
+
+TEST_F( LinkFilterTest, RelativeUrls )
+   {
+   const auto linkFilter = LinkFilter::compile( "allow_host www.example.com\ndeny_extension png\ndeny_path /admin/*" );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "/about" ), anchor ) );
+   EXPECT_TRUE( linkFilter.isAllowed( Url( "about.html?page=png" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "/image.png" ), anchor ) );
+   EXPECT_FALSE( linkFilter.isAllowed( Url( "/admin/users" ), anchor ) );
+   }
+
+TEST_F( LinkFilterTest, ParseRelativeLinks )
+   {
+   const auto linkFilter = LinkFilter::compile( LinkFilter::defaultRules );
+   HtmlParser htmlParser;
+   htmlParser.linkFilter = [ & ]( const Url &url, const TagInfo &tagInfo )
+      { return linkFilter.isAllowed( url, tagInfo ); };
+   const auto htmlInfo = htmlParser.parse( R"(<a href="/about">About</a><a href="/logo.png">Logo</a>)" );
+   ASSERT_EQ( htmlInfo.links.size( ), 1 );
+   EXPECT_EQ( htmlInfo.links[ 0 ].url.toString( ), "/about" );
+
+   // A filter that throws drops the link instead of failing the page.
+   htmlParser.linkFilter = [ ]( const Url &url, const TagInfo & )
+      { return !url.host( ).empty( ); };
+   EXPECT_TRUE( htmlParser.parse( R"(<a href="/about">About</a><embed src="/movie.html">)" ).links.empty( ) );
+   }
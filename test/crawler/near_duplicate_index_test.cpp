@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "crawler/near_duplicate_index.h"
+
+TEST( NearDuplicateIndexTest, FindOrInsert )
+   {
+   NearDuplicateIndex nearDuplicateIndex;
+   const uint64_t fingerprint = 0x0123456789abcdefull;
+   EXPECT_FALSE( nearDuplicateIndex.findOrInsert( fingerprint ) );
+   EXPECT_TRUE( nearDuplicateIndex.findOrInsert( fingerprint ) );
+
+   // Flips three bits in different bands, and then four bits, which is too far.
+   EXPECT_TRUE( nearDuplicateIndex.findOrInsert( fingerprint ^ 0x0001000100010000ull ) );
+   EXPECT_FALSE( nearDuplicateIndex.findOrInsert( fingerprint ^ 0x0001000100010001ull ) );
+   EXPECT_EQ( nearDuplicateIndex.numChecked( ), 4 );
+   EXPECT_EQ( nearDuplicateIndex.numDuplicates( ), 2 );
+   }
+
+TEST( NearDuplicateIndexTest, MaxBucketSize )
+   {
+   // Splits the fingerprints into two 32-bit bands, and pushes the first fingerprint out of both of its buckets.
+   NearDuplicateIndex nearDuplicateIndex( { .maxDistance = 1, .maxBucketSize = 2 } );
+   for ( const uint64_t fingerprint : { 0x0ull, 0x3ull << 32, 0xcull << 32, 0x3ull, 0xcull } )
+      EXPECT_FALSE( nearDuplicateIndex.findOrInsert( fingerprint ) );
+   EXPECT_FALSE( nearDuplicateIndex.findOrInsert( 0x0ull ) );
+   EXPECT_TRUE( nearDuplicateIndex.findOrInsert( 0xcull << 32 ) );
+   }
+
+TEST( NearDuplicateIndexTest, MaxNumBuckets )
+   {
+   // Gives every fingerprint its own bucket in both bands, so that the third fingerprint pushes out the first.
+   NearDuplicateIndex nearDuplicateIndex( { .maxDistance = 1, .maxNumBuckets = 2 } );
+   for ( const uint64_t fingerprint : { 0x0ull, 0xff000000ffull, 0xff000000ff00ull } )
+      EXPECT_FALSE( nearDuplicateIndex.findOrInsert( fingerprint ) );
+   EXPECT_FALSE( nearDuplicateIndex.findOrInsert( 0x0ull ) );
+   EXPECT_TRUE( nearDuplicateIndex.findOrInsert( 0xff000000ff00ull ) );
+   }
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "crawler/page_sink.h"
+
+using namespace testing;
+
+TEST( PageSinkTest, StreamWithCredits )
+   {
+   static constexpr auto numRecords = 1000;
+   PageStreamReceiver receiver( 0, 8 );
+   long numCreditStalls = 0;
+   Thread writer( [ & ]( )
+      {
+      SocketPageSink pageSink( "127.0.0.1", receiver.port( ), { .maxQueueSize = 100, .maxSendSize = 64 } );
+      for ( auto i = 0; i < numRecords; ++i )
+         pageSink.write( STRING( "record " << i ) );
+      pageSink.write( "" );
+      pageSink.flush( );
+      numCreditStalls = pageSink.numCreditStalls( );
+      } );
+
+   String record;
+   for ( auto i = 0; i < numRecords; ++i )
+      {
+      ASSERT_TRUE( receiver.receive( record ) );
+      EXPECT_EQ( record, STRING( "record " << i ) );
+      }
+   ASSERT_TRUE( receiver.receive( record ) );
+   EXPECT_EQ( record, "" );
+   EXPECT_FALSE( receiver.receive( record ) );
+   writer.join( );
+
+   // The sink ran out of credits, since the window is far smaller than the stream.
+   EXPECT_GT( numCreditStalls, 1 );
+   }
+
+TEST( PageSinkTest, ReconnectWhenConsumerLeaves )
+   {
+   auto receiver = makeUnique<PageStreamReceiver>( 0, 2 );
+   const auto port = receiver->port( );
+   std::atomic<bool> isResumed = false;
+   long numReconnects = 0;
+   Thread writer( [ & ]( )
+      {
+      SocketPageSink pageSink( "127.0.0.1", port, { .minReconnectDelay = 10, .maxReconnectDelay = 100 } );
+      pageSink.write( "first" );
+      for ( auto i = 0; !isResumed; ++i )
+         {
+         pageSink.write( STRING( "record " << i ) );
+         std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+         }
+      pageSink.write( "last" );
+      pageSink.flush( );
+      numReconnects = pageSink.numReconnects( );
+      } );
+
+   String record;
+   ASSERT_TRUE( receiver->receive( record ) );
+   EXPECT_EQ( record, "first" );
+   receiver.reset( );
+
+   // A restarted consumer gets the stream from where the sink reconnected.
+   PageStreamReceiver restartedReceiver( port, 2 );
+   ASSERT_TRUE( restartedReceiver.receive( record ) );
+   EXPECT_TRUE( record.starts_with( "record " ) );
+   isResumed = true;
+   while ( restartedReceiver.receive( record ) && record != "last" );
+   EXPECT_EQ( record, "last" );
+   EXPECT_FALSE( restartedReceiver.receive( record ) );
+   writer.join( );
+   EXPECT_GE( numReconnects, 1 );
+   }
+
+TEST( PageSinkTest, FlushTimesOut )
+   {
+   // The consumer never accepts the connection, so the sink gets no credits.
+   PageStreamReceiver receiver( 0 );
+   SocketPageSink pageSink( "127.0.0.1", receiver.port( ), { .flushTimeout = 50 } );
+   pageSink.write( "first" );
+   EXPECT_THROW( pageSink.flush( ), SocketException );
+   }
+
+TEST( PageSinkTest, WriteSegments )
+   {
+   const auto directory = std::filesystem::temp_directory_path( ) / STRING( "page_sink_test_" << ::getpid( ) );
+   std::filesystem::remove_all( directory );
+      {
+      SegmentPageSink pageSink( directory, { }, { } );
+      pageSink.write( "first" );
+      pageSink.write( "second" );
+      pageSink.flush( );
+      EXPECT_NE( STRING( pageSink ).find( "Write queue" ), String::npos );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( reader.numRecords( ), 2 );
+   EXPECT_EQ( reader.read( 1 ), "second" );
+   std::filesystem::remove_all( directory );
+   }
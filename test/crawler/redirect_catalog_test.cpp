@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "crawler/redirect_catalog.h"
+
+TEST( RedirectCatalogTest, Redirect )
+   {
+   RedirectCatalog redirectCatalog;
+   redirectCatalog.addRedirect( Url( "https://www.example.com/old" ), Url( "https://www.example.com/new" ) );
+   redirectCatalog.addRedirect( Url( "https://www.example.com/new" ), Url( "https://www.example.org/newer" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "https://www.example.com/old" ) ), Url( "https://www.example.org/newer" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "https://www.example.com/other" ) ),
+              Url( "https://www.example.com/other" ) );
+   }
+
+TEST( RedirectCatalogTest, RedirectCycle )
+   {
+   RedirectCatalog redirectCatalog;
+   redirectCatalog.addRedirect( Url( "https://www.example.com/a" ), Url( "https://www.example.com/b" ) );
+   redirectCatalog.addRedirect( Url( "https://www.example.com/b" ), Url( "https://www.example.com/a" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "https://www.example.com/a" ) ), Url( "https://www.example.com/b" ) );
+   }
+
+TEST( RedirectCatalogTest, HttpsUpgrade )
+   {
+   RedirectCatalog redirectCatalog;
+   redirectCatalog.addRedirect( Url( "http://secure.example.com/a?b=c" ), Url( "https://secure.example.com/a?b=c" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "http://secure.example.com/x?y=z" ) ),
+              Url( "https://secure.example.com/x?y=z" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "http://secure.example.com:8080/x" ) ),
+              Url( "http://secure.example.com:8080/x" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "http://plain.example.com/x" ) ), Url( "http://plain.example.com/x" ) );
+
+   redirectCatalog.addHttpsOnlyHost( Url( "https://hsts.example.com/" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "http://hsts.example.com/" ) ), Url( "https://hsts.example.com/" ) );
+   }
+
+TEST( RedirectCatalogTest, StrictTransportSecurity )
+   {
+   RedirectCatalog redirectCatalog;
+   const Url url( "https://hsts.example.com/" ), plainUrl( "http://hsts.example.com/" );
+   redirectCatalog.addStrictTransportSecurity( url, "includeSubDomains" );
+   redirectCatalog.addStrictTransportSecurity( url, "max-age=soon" );
+   EXPECT_EQ( redirectCatalog.rewrite( plainUrl ), plainUrl );
+
+   redirectCatalog.addStrictTransportSecurity( url, "Max-Age=\"31536000\"; includeSubDomains" );
+   EXPECT_EQ( redirectCatalog.rewrite( plainUrl ), url );
+
+   // A zero age withdraws the policy.
+   redirectCatalog.addStrictTransportSecurity( url, "max-age=0" );
+   EXPECT_EQ( redirectCatalog.rewrite( plainUrl ), plainUrl );
+   }
+
+TEST( RedirectCatalogTest, Capacity )
+   {
+   RedirectCatalog redirectCatalog( 2 );
+   redirectCatalog.addRedirect( Url( "https://www.example.com/1" ), Url( "https://www.example.com/one" ) );
+   redirectCatalog.addRedirect( Url( "https://www.example.com/2" ), Url( "https://www.example.com/two" ) );
+   redirectCatalog.addRedirect( Url( "https://www.example.com/3" ), Url( "https://www.example.com/three" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "https://www.example.com/1" ) ), Url( "https://www.example.com/1" ) );
+   EXPECT_EQ( redirectCatalog.rewrite( Url( "https://www.example.com/3" ) ), Url( "https://www.example.com/three" ) );
+   }
+
+TEST( RedirectCatalogTest, Persistence )
+   {
+   RedirectCatalog redirectCatalog;
+   redirectCatalog.addRedirect( Url( "https://www.example.com/old" ), Url( "https://www.example.com/new" ) );
+   redirectCatalog.addHttpsOnlyHost( Url( "https://hsts.example.com/" ) );
+
+   std::stringstream stream;
+   stream << redirectCatalog;
+   RedirectCatalog loadedRedirectCatalog;
+   stream >> loadedRedirectCatalog;
+   EXPECT_EQ( loadedRedirectCatalog.rewrite( Url( "https://www.example.com/old" ) ),
+              Url( "https://www.example.com/new" ) );
+   EXPECT_EQ( loadedRedirectCatalog.rewrite( Url( "http://hsts.example.com/a" ) ),
+              Url( "https://hsts.example.com/a" ) );
+   }
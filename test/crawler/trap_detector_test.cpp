@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "crawler/trap_detector.h"
+
+TEST( TrapDetectorTest, PathDepth )
+   {
+   TrapDetector trapDetector( { .maxPathDepth = 4 } );
+   EXPECT_EQ( trapDetector.inspect( Url( "https://www.example.com/a/b/c/d" ) ), TrapSignal::None );
+   EXPECT_EQ( trapDetector.inspect( Url( "https://www.example.com/a/b/c/d/e" ) ), TrapSignal::PathDepth );
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::PathDepth ), 1 );
+   }
+
+TEST( TrapDetectorTest, RepeatingSegments )
+   {
+   TrapDetector trapDetector;
+   EXPECT_EQ( trapDetector.inspect( Url( "https://www.example.com/a/b/a/b/" ) ), TrapSignal::None );
+   EXPECT_EQ( trapDetector.inspect( Url( "https://www.example.com/a/b/a/b/a/b/" ) ), TrapSignal::RepeatingSegments );
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::RepeatingSegments ), 1 );
+   }
+
+TEST( TrapDetectorTest, ParameterExplosion )
+   {
+   TrapDetector trapDetector( { .maxVariantsPerPattern = 10, .minPagesChecked = 5, .pageWindow = 20,
+                                .probeInterval = 4 } );
+   const auto dayUrl = [ ]( int day )
+      { return Url( STRING( "https://cal.example.com/day/" << day << "?sid=" << day ) ); };
+   // Many variants alone do not flag a pattern before its pages are seen to be duplicates.
+   for ( auto i = 0; i < 20; ++i ) EXPECT_EQ( trapDetector.inspect( dayUrl( i ) ), TrapSignal::None );
+   for ( auto i = 0; i < 10; ++i )
+      trapDetector.recordContent( Url( STRING( "https://cal.example.com/about/" << static_cast<char>('a' + i) ) ), i );
+   for ( auto i = 0; i < 5; ++i ) trapDetector.recordContent( dayUrl( i ), 100 );
+   trapDetector.recordNearDuplicate( dayUrl( 5 ) );
+
+   EXPECT_EQ( trapDetector.inspect( dayUrl( 100 ) ), TrapSignal::ParameterExplosion );
+   EXPECT_EQ( trapDetector.inspect( dayUrl( 1 ) ), TrapSignal::ParameterExplosion );
+   EXPECT_EQ( trapDetector.inspect( dayUrl( 101 ) ), TrapSignal::ParameterExplosion );
+   // Lets a probe through.
+   EXPECT_EQ( trapDetector.inspect( dayUrl( 102 ) ), TrapSignal::None );
+   EXPECT_EQ( trapDetector.inspect( Url( "https://cal.example.com/day/1?lang=en" ) ), TrapSignal::None );
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::ParameterExplosion ), 3 );
+
+   // Clears the flag once the pages of the pattern are distinct again.
+   for ( auto i = 0; i < 14; ++i ) trapDetector.recordContent( dayUrl( 200 + i ), 200 + i );
+   EXPECT_EQ( trapDetector.inspect( dayUrl( 103 ) ), TrapSignal::None );
+   }
+
+TEST( TrapDetectorTest, HostGrowth )
+   {
+   TrapDetector trapDetector( { .minPagesChecked = 5, .pageWindow = 10, .probeInterval = 3 } );
+   const auto pageUrl = [ ]( char c )
+      { return Url( STRING( "https://grow.example.com/" << c ) ); };
+   for ( auto i = 0; i < 5; ++i ) trapDetector.recordContent( pageUrl( static_cast<char>('a' + i) ), 1 );
+   EXPECT_EQ( trapDetector.inspect( pageUrl( 'x' ) ), TrapSignal::None );
+   trapDetector.recordContent( pageUrl( 'f' ), 1 );
+
+   EXPECT_EQ( trapDetector.inspect( pageUrl( 'y' ) ), TrapSignal::HostGrowth );
+   EXPECT_EQ( trapDetector.inspect( pageUrl( 'z' ) ), TrapSignal::HostGrowth );
+   EXPECT_EQ( trapDetector.inspect( pageUrl( 'w' ) ), TrapSignal::None );
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::HostGrowth ), 2 );
+
+   // Halves the counts at the end of the window, after which the new pages outweigh the duplicates.
+   for ( auto i = 0; i < 4; ++i ) trapDetector.recordContent( pageUrl( static_cast<char>('g' + i) ), 10 + i );
+   EXPECT_EQ( trapDetector.inspect( pageUrl( 'v' ) ), TrapSignal::None );
+   }
+
+TEST( TrapDetectorTest, LargeSites )
+   {
+   TrapDetector trapDetector;
+   // A news site whose articles are numbered and distinct, each linking to its neighbours.
+   for ( auto id = 0; id < 5'000; ++id )
+      {
+      for ( auto link = id + 1; link <= id + 5; ++link )
+         EXPECT_EQ( trapDetector.inspect( Url( STRING( "https://news.example.com/article/" << link ) ) ),
+                    TrapSignal::None );
+      trapDetector.recordContent( Url( STRING( "https://news.example.com/article/" << id ) ), id );
+      }
+   // A popular host that yields far more URLs than are crawled from it yet.
+   for ( auto id = 0; id < 20'000; ++id )
+      {
+      EXPECT_EQ( trapDetector.inspect( Url( STRING( "https://shop.example.com/item?id=" << id << "&ref=" << id ) ) ),
+                 TrapSignal::None );
+      if ( id % 200 == 0 )
+         trapDetector.recordContent( Url( STRING( "https://shop.example.com/item?id=" << id ) ), id );
+      }
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::ParameterExplosion ), 0 );
+   EXPECT_EQ( trapDetector.numFlagged( TrapSignal::HostGrowth ), 0 );
+   }
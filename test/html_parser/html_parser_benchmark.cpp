@@ -0,0 +1,151 @@
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#include "core/file_system.h"
+#include "html_parser/html_parser.h"
+#include "html_parser/tokenizer.h"
+
+// Measures single-threaded throughput, i.e. MB/s per core, over a stored corpus of HTML files.
+// Usage: html_parser_benchmark <corpus_dir> [num_rounds]
+
+// The tokenizer that `HtmlParser` used before the vectorized tokenizer, kept as the baseline.
+Vector<String> legacyTokenize( StringView string )
+   {
+   Vector<String> tokens;
+   std::istringstream stream( String{ string } );
+   String token;
+   while ( stream >> token )
+      {
+      const auto begin = std::find_if( token.cbegin( ), token.cend( ), [ ]( char c )
+         { return std::isalnum( c ); } );
+      if ( begin == token.cend( ) ) continue;
+      const auto end = std::find_if( token.crbegin( ), token.crend( ), [ ]( char c )
+         { return std::isalnum( c ); } ).base( );
+      token = String( begin, end );
+      for ( auto &c : token ) c = toLower( c );
+      tokens.emplace_back( std::move( token ) );
+      }
+   return tokens;
+   }
+
+size_t legacyTokenizePage( StringView page )
+   {
+   size_t numWords = 0;
+   for ( size_t beginPos = 0, endPos; beginPos < page.size( ); beginPos = endPos + 1 )
+      {
+      endPos = std::min( page.find( '<', beginPos ), page.size( ) );
+      numWords += legacyTokenize( page.substr( beginPos, endPos - beginPos ) ).size( );
+      if ( ( endPos = page.find( '>', endPos ) ) == StringView::npos ) break;
+      }
+   return numWords;
+   }
+
+size_t tokenizePage( StringView page )
+   {
+   size_t numWords = 0;
+   String lowercasePage( page.size( ), '\0' );
+   HtmlTokenizer::copyToLower( page, lowercasePage.data( ) );
+   const auto *begin = lowercasePage.data( ), *end = begin + lowercasePage.size( );
+   for ( auto *text = begin; text < end; ++text )
+      {
+      text = HtmlTokenizer::tokenize( text, end, [ & ]( StringView )
+         { ++numWords; } );
+      if ( ( text = std::find( text, end, '>' ) ) == end ) break;
+      }
+   return numWords;
+   }
+
+size_t parsePage( StringView page )
+   {
+   static const HtmlParser htmlParser;
+   try
+      { return htmlParser.parse( page ).words.size( ); }
+   catch ( const FormatException & )
+      { return 0; }
+   }
+
+size_t parsePageIntoArena( StringView page, ParseMode mode )
+   {
+   static const HtmlParser htmlParser;
+   static PageArena arena;
+   try
+      { return htmlParser.parse( page, arena, mode ).words.size( ); }
+   catch ( const FormatException & )
+      { return 0; }
+   }
+
+// Counts the links as they are parsed instead of recording them.
+struct LinkCounter
+   {
+   public:
+      static constexpr bool recordsLinks = false;
+
+      size_t numLinks = 0;
+
+      [[nodiscard]] bool filterLink( const Url &, const TagInfo & ) const
+         { return true; }
+
+      void addLink( const Url &, bool )
+         { ++numLinks; }
+   };
+
+size_t parsePageIntoLinkPolicy( StringView page )
+   {
+   static const HtmlParser htmlParser;
+   static PageArena arena;
+   LinkCounter linkCounter;
+   try
+      { htmlParser.parse( page, arena, linkCounter, ParseMode::LinksOnly ); }
+   catch ( const FormatException & )
+      { }
+   return linkCounter.numLinks;
+   }
+
+void run( StringView name, const Vector<String> &corpus, size_t corpusSize, int numRounds,
+          const std::function<size_t( StringView )> &function )
+   {
+   size_t numWords = 0;
+   const auto beginTime = std::chrono::steady_clock::now( );
+   for ( auto i = 0; i < numRounds; ++i )
+      for ( const auto &page : corpus )
+         numWords += function( page );
+   const auto elapsedTime = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   std::cout << std::left << std::setw( 16 ) << name << std::right << std::fixed << std::setprecision( 1 )
+             << std::setw( 10 ) << static_cast<double>(corpusSize) * numRounds / elapsedTime / ( 1 << 20 )
+             << " MB/s" << std::setw( 14 ) << numWords / numRounds << " words" << std::endl;
+   }
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <corpus_dir> [num_rounds]" << std::endl;
+      return 1;
+      }
+   const auto numRounds = argc > 2 ? std::stoi( argv[ 2 ] ) : 5;
+
+   Vector<String> corpus;
+   size_t corpusSize = 0;
+   for ( const auto &entry : std::filesystem::recursive_directory_iterator( argv[ 1 ] ) )
+      {
+      if ( !entry.is_regular_file( ) ) continue;
+      std::ifstream file( entry.path( ), std::ios::binary );
+      corpus.emplace_back( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>( ) );
+      corpusSize += corpus.back( ).size( );
+      }
+   std::cout << corpus.size( ) << " pages [" << fileSizeToString( corpusSize ) << "], " << numRounds
+             << " rounds" << std::endl;
+
+   run( "legacy tokenize", corpus, corpusSize, numRounds, legacyTokenizePage );
+   run( "tokenize", corpus, corpusSize, numRounds, tokenizePage );
+   run( "parse", corpus, corpusSize, numRounds, parsePage );
+   run( "parse (arena)", corpus, corpusSize, numRounds, [ ]( StringView page )
+      { return parsePageIntoArena( page, ParseMode::Full ); } );
+   run( "links + anchors", corpus, corpusSize, numRounds, [ ]( StringView page )
+      { return parsePageIntoArena( page, ParseMode::LinksWithAnchorText ); } );
+   run( "links only", corpus, corpusSize, numRounds, [ ]( StringView page )
+      { return parsePageIntoArena( page, ParseMode::LinksOnly ); } );
+   run( "links (policy)", corpus, corpusSize, numRounds, parsePageIntoLinkPolicy );
+   }
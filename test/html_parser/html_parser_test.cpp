@@ -1,25 +1,271 @@
-#include <gtest/gtest.h>
-
-#include "html_parser/html_parser.h"
-
-using namespace testing;
-
-class HtmlParserTest : public Test
-   {
-   protected:
-      HttpClient httpClient;
-      HtmlParser htmlParser;
-   };
-
-TEST_F( HtmlParserTest, Parse )
-   {
-   auto htmlInfo = htmlParser.parse( httpClient.getString( "https://www.nytimes.com/" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://en.wikipedia.org/wiki/Main_Page" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.youtube.com/c/automattic" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://en.planet.wikimedia.org/" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://jenkins.io/" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://developer.github.com/" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.fsf.org/" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://t.co/DcKYmuApCO" ) );
-   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.youtube.com/about/policies/" ) );
-   }
+#include <gtest/gtest.h>
+
+#include "html_parser/html_parser.h"
+
+using namespace testing;
+
+class HtmlParserTest : public Test
+   {
+   protected:
+      HttpClient httpClient;
+      HtmlParser htmlParser;
+   };
+
+TEST_F( HtmlParserTest, Parse )
+   {
+   auto htmlInfo = htmlParser.parse( httpClient.getString( "https://www.nytimes.com/" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://en.wikipedia.org/wiki/Main_Page" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.youtube.com/c/automattic" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://en.planet.wikimedia.org/" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://jenkins.io/" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://developer.github.com/" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.fsf.org/" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://t.co/DcKYmuApCO" ) );
+   htmlInfo = htmlParser.parse( httpClient.getString( "https://www.youtube.com/about/policies/" ) );
+   }
+
+TEST_F( HtmlParserTest, ParseString )
+   {
+   const auto htmlInfo = htmlParser.parse(
+         "<!DOCTYPE html><html><head><title>Search Engine</title><base href=\"https://www.example.com/\">"
+         "<script>var x = '<a href=\"/hidden\">';</script></head><body><p>Hello, World!</p>"
+         "<a href=\"/About\">About <b>Us</b></a> and <embed src=\"movie.swf\"> <a href='#top'>Top</a></body></html>" );
+   EXPECT_EQ( htmlInfo.titleWords, Vector<String>( { "search", "engine" } ) );
+   EXPECT_EQ( htmlInfo.words, Vector<String>( { "hello", "world", "about", "us", "and", "top" } ) );
+   ASSERT_EQ( htmlInfo.links.size( ), 2 );
+   EXPECT_EQ( htmlInfo.links[ 0 ].url, Url( "/About" ) );
+   EXPECT_EQ( htmlInfo.links[ 0 ].anchorWords, Vector<String>( { "about", "us" } ) );
+   EXPECT_EQ( htmlInfo.links[ 1 ].url, Url( "movie.swf" ) );
+   EXPECT_TRUE( htmlInfo.links[ 1 ].anchorWords.empty( ) );
+   EXPECT_EQ( htmlInfo.base, Url( "https://www.example.com/" ) );
+   }
+
+TEST_F( HtmlParserTest, ParseIntoArena )
+   {
+   PageArena arena;
+   const StringView htmlString = "<title>First</title><a href=\"/a\">One Two</a> Three";
+   const auto &htmlInfo = htmlParser.parse( htmlString, arena );
+   EXPECT_EQ( htmlInfo.words, Vector<StringView>( { "one", "two", "three" } ) );
+   ASSERT_EQ( htmlInfo.links.size( ), 1 );
+   EXPECT_EQ( Vector<StringView>( htmlInfo.anchorWordsOf( htmlInfo.links[ 0 ] ).begin( ),
+                                  htmlInfo.anchorWordsOf( htmlInfo.links[ 0 ] ).end( ) ),
+              Vector<StringView>( { "one", "two" } ) );
+
+   std::ostringstream viewStream, stream;
+   viewStream << htmlInfo;
+   stream << htmlParser.parse( htmlString );
+   EXPECT_EQ( viewStream.str( ), stream.str( ) );
+
+   // Parsing another page reuses the arena and replaces the parsed information.
+   const auto &otherHtmlInfo = htmlParser.parse( "<p>Second Page</p>", arena );
+   EXPECT_EQ( &otherHtmlInfo, &htmlInfo );
+   EXPECT_EQ( otherHtmlInfo.words, Vector<StringView>( { "second", "page" } ) );
+   EXPECT_TRUE( otherHtmlInfo.links.empty( ) );
+   EXPECT_TRUE( otherHtmlInfo.titleWords.empty( ) );
+   }
+
+TEST_F( HtmlParserTest, ParseTagsIgnoringCase )
+   {
+   const auto htmlInfo = htmlParser.parse(
+         "<TITLE>Upper Case</Title><SCRIPT type=\"text/javascript\">Hidden</SCRIPT><Svg><text>Hidden</text></svg>"
+         "<A href=\"/a\">Link</A> <aside>Aside</aside> <abbr>Abbr</abbr> <BASE href=\"https://example.com/\"/>" );
+   EXPECT_EQ( htmlInfo.titleWords, Vector<String>( { "upper", "case" } ) );
+   EXPECT_EQ( htmlInfo.words, Vector<String>( { "link", "aside", "abbr" } ) );
+   ASSERT_EQ( htmlInfo.links.size( ), 1 );
+   EXPECT_EQ( htmlInfo.links[ 0 ].anchorWords, Vector<String>( { "link" } ) );
+   EXPECT_EQ( htmlInfo.base, Url( "https://example.com/" ) );
+   }
+
+TEST_F( HtmlParserTest, ParseStream )
+   {
+   const StringView htmlString =
+         "<!DOCTYPE html><html><head><title>Search   Engine Title</title><base href=\"https://www.example.com/\">"
+         "<script>var x = '<a href=\"/hidden\">'; // </scrip</script></head><body><p>Hello, World!</p>\n"
+         "<a href=\"/About\">About <b>Us</b></a> and <embed src=\"movie.swf\"> <a href='/top'>Top</a></body></html>";
+   std::ostringstream expectedStream;
+   expectedStream << htmlParser.parse( htmlString );
+
+   HtmlStreamParser htmlStreamParser( htmlParser );
+   for ( size_t chunkSize = 1; chunkSize <= htmlString.size( ); ++chunkSize )
+      {
+      for ( size_t pos = 0; pos < htmlString.size( ); pos += chunkSize )
+         htmlStreamParser.feed( htmlString.substr( pos, chunkSize ) );
+      std::ostringstream stream;
+      stream << htmlStreamParser.finish( );
+      EXPECT_EQ( stream.str( ), expectedStream.str( ) ) << "Chunk size: " << chunkSize;
+      }
+   }
+
+TEST_F( HtmlParserTest, ParseStreamLinksBeforeFinish )
+   {
+   HtmlStreamParser htmlStreamParser( htmlParser );
+   htmlStreamParser.feed( "<p>First <a href=\"/first\">link</a> then <scr" );
+   ASSERT_EQ( htmlStreamParser.htmlInfo( ).links.size( ), 1 );
+   EXPECT_EQ( htmlStreamParser.htmlInfo( ).links[ 0 ].url, Url( "/first" ) );
+   htmlStreamParser.feed( "ipt>ignored words</script> last" );
+   const auto htmlInfo = htmlStreamParser.finish( );
+   EXPECT_EQ( htmlInfo.words, Vector<String>( { "first", "link", "then", "last" } ) );
+   EXPECT_THROW( ( htmlStreamParser.feed( "<p>Unclosed <script>" ), htmlStreamParser.finish( ) ), FormatException );
+
+   // A failed HTML file does not leak into the next one.
+   htmlStreamParser.feed( "<p>Next</p>" );
+   EXPECT_EQ( htmlStreamParser.finish( ).words, Vector<String>( { "next" } ) );
+   }
+
+TEST_F( HtmlParserTest, ParseLinksOnly )
+   {
+   const StringView htmlString =
+         "<title>Title <a href=\"/not-a-link\"></title><base href=\"https://www.example.com/\">"
+         "<SCRIPT>document.write( '<a href=\"/hidden\">' );</Script><p>Some text</p>"
+         "<a href=\"/about\">About <b>Us</b></a> and <embed src=\"movie.swf\"> <a href=\"/top\">Top</a>";
+   const auto htmlInfo = htmlParser.parse( htmlString );
+
+   const auto linksOnlyHtmlInfo = htmlParser.parse( htmlString, ParseMode::LinksOnly );
+   EXPECT_TRUE( linksOnlyHtmlInfo.words.empty( ) );
+   EXPECT_TRUE( linksOnlyHtmlInfo.titleWords.empty( ) );
+   EXPECT_EQ( linksOnlyHtmlInfo.base, htmlInfo.base );
+   ASSERT_EQ( linksOnlyHtmlInfo.links.size( ), htmlInfo.links.size( ) );
+   for ( size_t i = 0; i < htmlInfo.links.size( ); ++i )
+      {
+      EXPECT_EQ( linksOnlyHtmlInfo.links[ i ].url, htmlInfo.links[ i ].url );
+      EXPECT_TRUE( linksOnlyHtmlInfo.links[ i ].anchorWords.empty( ) );
+      }
+
+   const auto anchorTextHtmlInfo = htmlParser.parse( htmlString, ParseMode::LinksWithAnchorText );
+   EXPECT_EQ( anchorTextHtmlInfo.words, Vector<String>( { "about", "us", "top" } ) );
+   EXPECT_TRUE( anchorTextHtmlInfo.titleWords.empty( ) );
+   ASSERT_EQ( anchorTextHtmlInfo.links.size( ), htmlInfo.links.size( ) );
+   for ( size_t i = 0; i < htmlInfo.links.size( ); ++i )
+      {
+      EXPECT_EQ( anchorTextHtmlInfo.links[ i ].url, htmlInfo.links[ i ].url );
+      EXPECT_EQ( anchorTextHtmlInfo.links[ i ].anchorWords, htmlInfo.links[ i ].anchorWords );
+      }
+   }
+
+TEST( TagInfoTest, ValueOf )
+   {
+   const auto tagInfo = TagInfo::parse(
+         "<A data-href=\"/data\" title='see href=/title' HREF = /path/page.html class=x hidden Lang=\"en\"/>" );
+   EXPECT_EQ( tagInfo.type, TagType::SelfClosing );
+   EXPECT_EQ( tagInfo.name, "a" );
+   EXPECT_EQ( tagInfo.valueOf( "href" ), "/path/page.html" );
+   EXPECT_EQ( tagInfo.valueOf( "data-href" ), "/data" );
+   EXPECT_EQ( tagInfo.valueOf( "title" ), "see href=/title" );
+   EXPECT_EQ( tagInfo.valueOf( "class" ), "x" );
+   EXPECT_EQ( tagInfo.valueOf( "hidden" ), "" );
+   EXPECT_EQ( tagInfo.valueOf( "lang" ), "en" );
+   EXPECT_EQ( tagInfo.valueOf( "hreflang" ), std::nullopt );
+   EXPECT_EQ( tagInfo.attributes( ).size( ), 6 );
+
+   EXPECT_EQ( TagInfo::parse( "<a href=\"/first\" href=\"/second\">" ).valueOf( "href" ), "/first" );
+   EXPECT_EQ( TagInfo::parse( "<a>" ).valueOf( "href" ), std::nullopt );
+   }
+
+TEST_F( HtmlParserTest, ParseAttributes )
+   {
+   const auto htmlInfo = htmlParser.parse(
+         "<a data-href=\"/data\" HREF=/unquoted>Unquoted</a> <a title=\"href=/title\" href='/quoted#top'>Quoted</a>" );
+   ASSERT_EQ( htmlInfo.links.size( ), 2 );
+   EXPECT_EQ( htmlInfo.links[ 0 ].url, Url( "/unquoted" ) );
+   EXPECT_EQ( htmlInfo.links[ 1 ].url, Url( "/quoted" ) );
+   }
+
+TEST_F( HtmlParserTest, ParseRecovering )
+   {
+   const StringView htmlString =
+         "<title>Title</title><p>Before <a href=\"/first\">First</a/> <a href=\"/second\">Second</a> and <script>x";
+   EXPECT_THROW( htmlParser.parse( htmlString ), FormatException );
+
+   htmlParser.isRecovering = true;
+   const auto htmlInfo = htmlParser.parse( htmlString );
+   EXPECT_EQ( htmlInfo.numErrors, 2 );
+   EXPECT_EQ( htmlInfo.titleWords, Vector<String>( { "title" } ) );
+   EXPECT_EQ( htmlInfo.words, Vector<String>( { "before", "first", "second", "and" } ) );
+   ASSERT_EQ( htmlInfo.links.size( ), 2 );
+   EXPECT_EQ( htmlInfo.links[ 1 ].url, Url( "/second" ) );
+
+   const auto unclosedHtmlInfo = htmlParser.parse( "<p>Less <b>than</b> 5 <a href=\"/x\">x</a> <br" );
+   EXPECT_EQ( unclosedHtmlInfo.numErrors, 1 );
+   EXPECT_EQ( unclosedHtmlInfo.words, Vector<String>( { "less", "than", "5", "x", "br" } ) );
+   EXPECT_EQ( unclosedHtmlInfo.links.size( ), 1 );
+
+   HtmlStreamParser htmlStreamParser( htmlParser );
+   htmlStreamParser.feed( htmlString.substr( 0, 50 ) );
+   htmlStreamParser.feed( htmlString.substr( 50 ) );
+   EXPECT_EQ( htmlStreamParser.finish( ).numErrors, 2 );
+   }
+
+struct LinkCollector
+   {
+   public:
+      static constexpr bool recordsLinks = false;
+
+      Vector<Url> urls;
+
+      [[nodiscard]] bool filterLink( const Url &url, const TagInfo &tagInfo ) const
+         { return !tagInfo.valueOf( "rel" ).has_value( ) && !( url == Url( "/filtered" ) ); }
+
+      void addLink( const Url &url, bool )
+         { urls.emplace_back( url ); }
+   };
+
+TEST_F( HtmlParserTest, ParseIntoLinkPolicy )
+   {
+   const StringView htmlString =
+         "<p>Text <a href=\"/first\">First</a> <a href=\"/filtered\">Filtered</a> <a rel=\"x\" href=\"/rel\">Rel</a>"
+         "<embed src=\"/movie.swf\">";
+   htmlParser.linkFilter = [ ]( const Url &, const TagInfo & )
+      { return false; };
+
+   PageArena arena;
+   LinkCollector linkCollector;
+   const auto &htmlInfo = htmlParser.parse( htmlString, arena, linkCollector );
+   EXPECT_EQ( linkCollector.urls, Vector<Url>( { Url( "/first" ), Url( "/movie.swf" ) } ) );
+   EXPECT_TRUE( htmlInfo.links.empty( ) );
+   EXPECT_EQ( htmlInfo.words, Vector<StringView>( { "text", "first", "filtered", "rel" } ) );
+
+   linkCollector.urls.clear( );
+   htmlParser.parse( htmlString, arena, linkCollector, ParseMode::LinksOnly );
+   EXPECT_EQ( linkCollector.urls.size( ), 2 );
+   }
+
+TEST( RobotsDirectivesTest, Parse )
+   {
+   auto robots = RobotsDirectives::parse( "NoIndex,follow" );
+   EXPECT_TRUE( robots.isNoIndex );
+   EXPECT_FALSE( robots.isNoFollow );
+   robots = RobotsDirectives::parse( "noindexing nofollowed" );
+   EXPECT_FALSE( robots.isNoIndex || robots.isNoFollow );
+   }
+
+TEST( RobotsDirectivesTest, ParseHeaders )
+   {
+   // Headers for other user agents are ignored.
+   auto robots = RobotsDirectives::parseHeaders( "otherbot: noindex, nofollow", "UMichBot" );
+   EXPECT_FALSE( robots.isNoIndex || robots.isNoFollow );
+   robots = RobotsDirectives::parseHeaders( "otherbot: noindex\numichbot: nofollow", "UMichBot/1.0" );
+   EXPECT_FALSE( robots.isNoIndex );
+   EXPECT_TRUE( robots.isNoFollow );
+   robots = RobotsDirectives::parseHeaders( "unavailable_after: 25 Jun 2010\nnone", "UMichBot" );
+   EXPECT_TRUE( robots.isNoIndex && robots.isNoFollow );
+   }
+
+TEST_F( HtmlParserTest, ParseCanonicalAndRobots )
+   {
+   const StringView htmlString =
+         "<head><link rel=\"stylesheet\" href=\"/style.css\">"
+         "<LINK REL=\"Canonical\" href=\"https://example.com/page\"/>"
+         "<link rel=\"canonical\" href=\"/other\"><meta name=\"description\" content=\"noindex\">"
+         "<meta name=\"ROBOTS\" content=\"nofollow\"></head><a rel=\"noopener nofollow\" href=\"/ugc\">User</a> "
+         "<a href=\"/followed\">Followed</a>";
+   for ( const auto mode : { ParseMode::Full, ParseMode::LinksOnly } )
+      {
+      const auto htmlInfo = htmlParser.parse( htmlString, mode );
+      EXPECT_EQ( htmlInfo.canonical, Url( "https://example.com/page" ) );
+      EXPECT_FALSE( htmlInfo.robots.isNoIndex );
+      EXPECT_TRUE( htmlInfo.robots.isNoFollow );
+      ASSERT_EQ( htmlInfo.links.size( ), 2 );
+      EXPECT_TRUE( htmlInfo.links[ 0 ].isNoFollow );
+      EXPECT_FALSE( htmlInfo.links[ 1 ].isNoFollow );
+      }
+   }
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "core/vector.h"
+#include "html_parser/sim_hash.h"
+
+uint64_t fingerprintOf( const Vector<String> &words )
+   {
+   SimHash simHash;
+   for ( const auto &word : words ) simHash.add( word );
+   return simHash.fingerprint( );
+   }
+
+Vector<String> makeWords( int numWords, int seed )
+   {
+   Vector<String> words;
+   for ( auto i = 0; i < numWords; ++i ) words.emplace_back( STRING( "word" << ( i * 7919 + seed ) % 1000 ) );
+   return words;
+   }
+
+TEST( SimHashTest, Fingerprint )
+   {
+   EXPECT_EQ( fingerprintOf( { } ), 0 );
+   const auto words = makeWords( 500, 0 );
+   EXPECT_EQ( fingerprintOf( words ), fingerprintOf( words ) );
+
+   // Changing a few words moves the fingerprint by a few bits, while different text lands far away.
+   auto editedWords = words;
+   editedWords[ 10 ] = "edited", editedWords[ 200 ] = "changed";
+   EXPECT_LE( SimHash::distance( fingerprintOf( words ), fingerprintOf( editedWords ) ), 3 );
+   EXPECT_GT( SimHash::distance( fingerprintOf( words ), fingerprintOf( makeWords( 500, 1 ) ) ), 10 );
+   }
+
+TEST( SimHashTest, Clear )
+   {
+   SimHash simHash;
+   simHash.add( "word" );
+   EXPECT_EQ( simHash.numWords( ), 1 );
+   simHash.clear( );
+   EXPECT_EQ( simHash.numWords( ), 0 );
+   EXPECT_EQ( simHash.fingerprint( ), 0 );
+   }
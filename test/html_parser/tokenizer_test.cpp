@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "core/vector.h"
+#include "html_parser/tokenizer.h"
+
+Vector<String> tokenize( StringView text, size_t &tagPos )
+   {
+   String lowercaseText( text.size( ), '\0' );
+   HtmlTokenizer::copyToLower( text, lowercaseText.data( ) );
+   Vector<String> words;
+   const auto *begin = lowercaseText.data( );
+   tagPos = HtmlTokenizer::tokenize( begin, begin + lowercaseText.size( ), [ & ]( StringView word )
+      { words.emplace_back( word ); } ) - begin;
+   return words;
+   }
+
+TEST( HtmlTokenizerTest, CopyToLower )
+   {
+   const StringView text = "The QUICK Brown Fox Jumps Over The Lazy Dog [@`{] 0123456789 \xc3\x89T\xc3\xa9";
+   String lowercaseText( text.size( ), '\0' );
+   HtmlTokenizer::copyToLower( text, lowercaseText.data( ) );
+   EXPECT_EQ( lowercaseText, "the quick brown fox jumps over the lazy dog [@`{] 0123456789 \xc3\x89t\xc3\xa9" );
+   }
+
+TEST( HtmlTokenizerTest, Tokenize )
+   {
+   size_t tagPos;
+   EXPECT_EQ( tokenize( "  (Hello,   World!)\tdon't\r\nstop -- 42\v\f", tagPos ),
+              Vector<String>( { "hello", "world", "don't", "stop", "42" } ) );
+   EXPECT_EQ( tagPos, 39 );
+   EXPECT_EQ( tokenize( "", tagPos ), Vector<String>( ) );
+   EXPECT_EQ( tagPos, 0 );
+   }
+
+TEST( HtmlTokenizerTest, TokenizeUntilTag )
+   {
+   size_t tagPos;
+   EXPECT_EQ( tokenize( "Search Engine<b>bold</b>", tagPos ), Vector<String>( { "search", "engine" } ) );
+   EXPECT_EQ( tagPos, 13 );
+   EXPECT_EQ( tokenize( "<p>", tagPos ), Vector<String>( ) );
+   EXPECT_EQ( tagPos, 0 );
+   }
+
+TEST( HtmlTokenizerTest, TokenizeAcrossBlocks )
+   {
+   String text;
+   Vector<String> expectedWords;
+   for ( auto i = 0; i < 100; ++i )
+      {
+      text += STRING( "Word" << i << String( i % 7 + 1, ' ' ) );
+      expectedWords.emplace_back( STRING( "word" << i ) );
+      }
+   size_t tagPos;
+   EXPECT_EQ( tokenize( text + "<", tagPos ), expectedWords );
+   EXPECT_EQ( tagPos, text.size( ) );
+   }
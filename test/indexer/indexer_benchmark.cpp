@@ -0,0 +1,67 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "html_parser/html_parser.h"
+#include "indexer/inverted_index.h"
+
+// Measures the single-threaded indexing throughput and the size of the postings for several memory budgets, over the
+// pages parsed from a stored corpus of HTML files, which are indexed repeatedly as new documents.
+// Usage: indexer_benchmark <corpus_dir> [num_rounds]
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <corpus_dir> [num_rounds]" << std::endl;
+      return 1;
+      }
+   const auto numRounds = argc > 2 ? std::stoi( argv[ 2 ] ) : 5;
+
+   const HtmlParser htmlParser;
+   Vector<HtmlInfo> htmlInfos;
+   for ( const auto &entry : std::filesystem::recursive_directory_iterator( argv[ 1 ] ) )
+      {
+      if ( !entry.is_regular_file( ) ) continue;
+      std::ifstream file( entry.path( ), std::ios::binary );
+      const String page( std::istreambuf_iterator<char>( file ), { } );
+      try
+         { htmlInfos.emplace_back( htmlParser.parse( page ) ); }
+      catch ( const FormatException & )
+         { }
+      }
+   std::cout << htmlInfos.size( ) << " pages, " << numRounds << " rounds" << std::endl;
+   Vector<Vector<StringView>> words, titleWords;
+   for ( const auto &htmlInfo : htmlInfos )
+      {
+      words.emplace_back( htmlInfo.words.cbegin( ), htmlInfo.words.cend( ) );
+      titleWords.emplace_back( htmlInfo.titleWords.cbegin( ), htmlInfo.titleWords.cend( ) );
+      }
+
+   const auto directory = std::filesystem::temp_directory_path( ) / STRING( "indexer_benchmark_" << ::getpid( ) );
+   for ( const auto maxMemorySize : { size_t( 1 ) << 20, size_t( 16 ) << 20, size_t( 256 ) << 20 } )
+      {
+      std::filesystem::remove_all( directory );
+      const auto beginTime = std::chrono::steady_clock::now( );
+      int numRuns;
+         {
+         IndexWriter indexWriter( directory, { .maxMemorySize = maxMemorySize } );
+         DocId docId = 0;
+         for ( auto round = 0; round < numRounds; ++round )
+            for ( size_t i = 0; i < htmlInfos.size( ); ++i ) indexWriter.add( docId++, words[ i ], titleWords[ i ] );
+         numRuns = indexWriter.numRuns( );
+         indexWriter.commit( );
+         }
+      const auto elapsedTime = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+
+      const IndexReader indexReader( directory );
+      std::cout << std::left << std::setw( 12 ) << STRING( ( maxMemorySize >> 20 ) << " MB" ) << std::right
+                << std::fixed << std::setprecision( 1 ) << std::setw( 12 )
+                << static_cast<double>(indexReader.endDocId( )) / elapsedTime << " docs/s" << std::setw( 8 ) << numRuns
+                << " runs" << std::setprecision( 2 ) << std::setw( 10 )
+                << static_cast<double>(indexReader.numBytes( )) / std::max<uint64_t>( indexReader.numPostings( ), 1 )
+                << " bytes/posting" << std::endl;
+      }
+   std::filesystem::remove_all( directory );
+   }
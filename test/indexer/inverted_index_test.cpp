@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "indexer/inverted_index.h"
+
+using namespace testing;
+
+class InvertedIndexTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "inverted_index_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      // Adds documents whose words are `word<j>` for each divisor j of the document ID up to 4, and the word `doc`.
+      static void addDocuments( IndexWriter &indexWriter, DocId firstDocId, DocId endDocId )
+         {
+         for ( auto docId = firstDocId; docId < endDocId; ++docId )
+            {
+            Vector<String> strings{ "doc" };
+            for ( auto j = 1; j <= 4; ++j )
+               if ( docId % j == 0 ) strings.emplace_back( STRING( "word" << j ) );
+            strings.emplace_back( "doc" );
+            const Vector<StringView> words( strings.cbegin( ), strings.cend( ) ), titleWords{ "title", "doc" };
+            indexWriter.add( docId, words, titleWords );
+            }
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( InvertedIndexTest, MergeRuns )
+   {
+   static constexpr auto numDocuments = 200;
+      {
+      // Spills a run for nearly every document.
+      IndexWriter indexWriter( directory, { .maxMemorySize = 100 } );
+      addDocuments( indexWriter, 0, numDocuments );
+      EXPECT_GT( indexWriter.numRuns( ), numDocuments / 2 );
+      indexWriter.commit( );
+      EXPECT_EQ( indexWriter.numRuns( ), 0 );
+      }
+   EXPECT_FALSE( std::filesystem::exists( directory / "run-0.tmp" ) );
+
+   const IndexReader indexReader( directory );
+   EXPECT_EQ( indexReader.numSegments( ), 1 );
+   EXPECT_EQ( indexReader.endDocId( ), numDocuments );
+   Vector<Posting> postings;
+   indexReader.postings( "word4", postings );
+   ASSERT_EQ( postings.size( ), numDocuments / 4 );
+   for ( size_t i = 0; i < postings.size( ); ++i )
+      {
+      EXPECT_EQ( postings[ i ].docId, i * 4 );
+      EXPECT_EQ( postings[ i ].bodyPositions, Vector<uint32_t>( { i % 3 == 0 ? 4u : 3u } ) );
+      EXPECT_TRUE( postings[ i ].titlePositions.empty( ) );
+      }
+   indexReader.postings( "doc", postings );
+   ASSERT_EQ( postings.size( ), numDocuments );
+   EXPECT_EQ( postings[ 3 ], ( Posting{ 3, { 0, 3 }, { 1 } } ) );
+   indexReader.postings( "missing", postings );
+   EXPECT_TRUE( postings.empty( ) );
+
+   // A writer that spills no runs builds the same postings.
+   const auto otherDirectory = directory / "other";
+      {
+      IndexWriter indexWriter( otherDirectory );
+      addDocuments( indexWriter, 0, numDocuments );
+      }
+   const IndexReader otherIndexReader( otherDirectory );
+   EXPECT_EQ( otherIndexReader.numPostings( ), indexReader.numPostings( ) );
+   EXPECT_EQ( otherIndexReader.numBytes( ), indexReader.numBytes( ) );
+   }
+
+TEST_F( InvertedIndexTest, AddSegments )
+   {
+      {
+      IndexWriter indexWriter( directory );
+      addDocuments( indexWriter, 0, 10 );
+      }
+      {
+      // Continues after the committed documents, and leaves no trace of uncommitted runs.
+      IndexWriter indexWriter( directory, { .maxMemorySize = 100 } );
+      EXPECT_EQ( indexWriter.nextDocId( ), 10 );
+      EXPECT_THROW( addDocuments( indexWriter, 9, 10 ), ArgumentException );
+      addDocuments( indexWriter, 12, 20 );
+      EXPECT_GT( indexWriter.numRuns( ), 0 );
+      }
+   std::filesystem::copy_file( directory / "segment-0.terms", directory / "run-0.tmp" );
+   IndexWriter( directory ).commit( );
+   EXPECT_FALSE( std::filesystem::exists( directory / "run-0.tmp" ) );
+
+   const IndexReader indexReader( directory );
+   EXPECT_EQ( indexReader.numSegments( ), 2 );
+   EXPECT_EQ( indexReader.endDocId( ), 20 );
+   Vector<Posting> postings;
+   indexReader.postings( "word3", postings );
+   Vector<DocId> docIds;
+   for ( const auto &posting : postings ) docIds.push_back( posting.docId );
+   EXPECT_EQ( docIds, Vector<DocId>( { 0, 3, 6, 9, 12, 15, 18 } ) );
+   }
+
+TEST_F( InvertedIndexTest, AddTermIds )
+   {
+   static constexpr auto numDocuments = 50;
+   TermDictionary termDictionary;
+      {
+      // Adds the even documents by the term IDs of their words, and the odd ones by their words, as for a store whose
+      // later records have term IDs.
+      IndexWriter indexWriter( directory, { .maxMemorySize = 1000 }, &termDictionary );
+      for ( DocId docId = 0; docId < numDocuments; ++docId )
+         {
+         Vector<String> strings{ "doc" };
+         for ( auto j = 1; j <= 4; ++j )
+            if ( docId % j == 0 ) strings.emplace_back( STRING( "word" << j ) );
+         strings.emplace_back( "doc" );
+         const Vector<StringView> words( strings.cbegin( ), strings.cend( ) ), titleWords{ "title", "doc" };
+         if ( docId % 2 == 0 )
+            {
+            Vector<TermId> wordIds, titleWordIds;
+            for ( const auto word : words ) wordIds.push_back( termDictionary.intern( word ) );
+            for ( const auto word : titleWords ) titleWordIds.push_back( termDictionary.intern( word ) );
+            indexWriter.add( docId, wordIds, titleWordIds );
+            }
+         else indexWriter.add( docId, words, titleWords );
+         }
+      const Vector<TermId> unknownTermIds{ static_cast<TermId>(termDictionary.size( )) };
+      EXPECT_THROW( indexWriter.add( numDocuments, unknownTermIds, { } ), ArgumentException );
+      }
+   const auto otherDirectory = directory / "other";
+      {
+      IndexWriter indexWriter( otherDirectory );
+      addDocuments( indexWriter, 0, numDocuments );
+      const Vector<TermId> termIds{ 0 };
+      EXPECT_THROW( indexWriter.add( numDocuments, termIds, { } ), InvalidOperationException );
+      }
+
+   const IndexReader indexReader( directory ), otherIndexReader( otherDirectory );
+   EXPECT_EQ( indexReader.numPostings( ), otherIndexReader.numPostings( ) );
+   Vector<Posting> postings, otherPostings;
+   for ( const auto term : { "doc", "word1", "word2", "word3", "word4", "title" } )
+      {
+      indexReader.postings( term, postings );
+      otherIndexReader.postings( term, otherPostings );
+      EXPECT_EQ( postings, otherPostings ) << term;
+      }
+   }
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "storage/block_codec.h"
+
+TEST( BlockCodecTest, CompressAndDecompress )
+   {
+   String block;
+   for ( auto i = 0; i < 1000; ++i ) block += STRING( "word" << i % 10 << ' ' );
+
+   for ( const auto compression : { Compression::None, Compression::Zlib, Compression::Zstd } )
+      {
+      if ( !BlockCodec::isAvailable( compression ) )
+         {
+         String compressedBlock;
+         EXPECT_THROW( BlockCodec::compress( compression, 0, block, compressedBlock ), ArgumentException );
+         continue;
+         }
+      String compressedBlock;
+      BlockCodec::compress( compression, 0, block, compressedBlock );
+      if ( compression != Compression::None )
+         {
+         EXPECT_LT( compressedBlock.size( ), block.size( ) / 4 );
+         }
+      String decompressedBlock( block.size( ), '\0' );
+      BlockCodec::decompress( compression, compressedBlock, decompressedBlock );
+      EXPECT_EQ( decompressedBlock, block );
+      }
+   }
+
+TEST( BlockCodecTest, DecompressCorrupt )
+   {
+   String compressedBlock;
+   BlockCodec::compress( Compression::Zlib, 0, "hello hello hello hello", compressedBlock );
+   String block( 23, '\0' );
+   EXPECT_THROW( BlockCodec::decompress( Compression::Zlib, compressedBlock.substr( 0, 5 ), block ), FormatException );
+   String largerBlock( 24, '\0' );
+   EXPECT_THROW( BlockCodec::decompress( Compression::Zlib, compressedBlock, largerBlock ), FormatException );
+   }
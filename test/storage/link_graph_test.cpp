@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "storage/link_graph.h"
+
+using namespace testing;
+
+class LinkGraphTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "link_graph_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      Vector<String> linksOf( const LinkGraph &linkGraph, StringView url ) const
+         {
+         Vector<UrlId> urlIds;
+         linkGraph.links( linkGraph.find( url ).value( ), urlIds );
+         Vector<String> urls;
+         for ( const auto urlId : urlIds ) urls.emplace_back( linkGraph.url( urlId ) );
+         std::sort( urls.begin( ), urls.end( ) );
+         return urls;
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( LinkGraphTest, MergeShards )
+   {
+   const auto aUrl = Url( "https://a.com/" ), bUrl = Url( "https://b.com/" ), cUrl = Url( "https://c.com/" );
+      {
+      LinkGraphWriter linkGraphWriter( directory / "node0" );
+      const Vector<Url> links{ bUrl, cUrl, bUrl };
+      linkGraphWriter.write( aUrl, links );
+      EXPECT_EQ( linkGraphWriter.numPages( ), 1 );
+      }
+      {
+      // Another node, and a recrawl by the first node whose links replace those of the first crawl.
+      LinkGraphWriter linkGraphWriter( directory / "node1" );
+      const Vector<Url> links{ aUrl };
+      linkGraphWriter.write( bUrl, links );
+      }
+      {
+      LinkGraphWriter linkGraphWriter( directory / "node0" );
+      const Vector<Url> links{ cUrl };
+      linkGraphWriter.write( aUrl, links );
+      }
+   EXPECT_TRUE( std::filesystem::exists( directory / "node0" / "links-1.dat" ) );
+
+   const Vector<std::filesystem::path> shardDirectories{ directory / "node0", directory / "node1" };
+   LinkGraph::merge( shardDirectories, directory / "merged", 2 );
+   const LinkGraph linkGraph( directory / "merged" );
+   ASSERT_EQ( linkGraph.numUrls( ), 3 );
+   EXPECT_EQ( linksOf( linkGraph, "https://a.com/" ), Vector<String>( { "https://c.com/" } ) );
+   EXPECT_EQ( linksOf( linkGraph, "https://b.com/" ), Vector<String>( { "https://a.com/" } ) );
+   EXPECT_TRUE( linksOf( linkGraph, "https://c.com/" ).empty( ) );
+   EXPECT_EQ( linkGraph.find( "https://d.com/" ), std::nullopt );
+
+   // The IDs follow the fingerprints.
+   for ( UrlId i = 0; i + 1 < linkGraph.numUrls( ); ++i )
+      EXPECT_LT( LinkGraphWriter::fingerprint( linkGraph.url( i ) ),
+                 LinkGraphWriter::fingerprint( linkGraph.url( i + 1 ) ) );
+   }
+
+TEST_F( LinkGraphTest, DropTornRecords )
+   {
+   static constexpr auto numPages = 100;
+      {
+      LinkGraphWriter linkGraphWriter( directory / "node0" );
+      for ( auto i = 0; i < numPages; ++i )
+         {
+         const Vector<Url> links{ Url( STRING( "https://example.com/" << i + 1 ) ) };
+         linkGraphWriter.write( Url( STRING( "https://example.com/" << i ) ), links );
+         }
+      }
+   // Tears the last URL, which the last page links to, and the last adjacency list.
+   std::filesystem::resize_file( directory / "node0" / "urls-0.dat",
+                                 std::filesystem::file_size( directory / "node0" / "urls-0.dat" ) - 1 );
+   std::filesystem::resize_file( directory / "node0" / "links-0.dat",
+                                 std::filesystem::file_size( directory / "node0" / "links-0.dat" ) - 1 );
+
+   const Vector<std::filesystem::path> shardDirectories{ directory / "node0" };
+   LinkGraph::merge( shardDirectories, directory / "merged", 1 );
+   const LinkGraph linkGraph( directory / "merged" );
+   EXPECT_EQ( linkGraph.numUrls( ), numPages );
+   EXPECT_EQ( linksOf( linkGraph, "https://example.com/0" ), Vector<String>( { "https://example.com/1" } ) );
+   EXPECT_TRUE( linksOf( linkGraph, STRING( "https://example.com/" << numPages - 1 ) ).empty( ) );
+   }
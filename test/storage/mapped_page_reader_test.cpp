@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "storage/mapped_page_reader.h"
+
+using namespace testing;
+
+class MappedPageReaderTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "mapped_page_reader_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      void writePages( int numPages, const SegmentStoreConfiguration &config ) const
+         {
+         SegmentWriter writer( directory, config );
+         String record;
+         for ( auto i = 0; i < numPages; ++i )
+            {
+            HtmlInfo htmlInfo;
+            htmlInfo.words = { "page", STRING( i ) };
+            htmlInfo.titleWords = { "title" };
+            htmlInfo.links.emplace_back( Url( STRING( "http://example.com/" << i + 1 ) ) ).anchorWords = { "next" };
+            record.clear( );
+            PageRecord::encode( STRING( "http://example.com/" << i ), htmlInfo, record );
+            writer.append( record );
+            }
+         }
+
+      // Checks that the partitions cover each page once, in order, with its content.
+      void expectAllPages( int numPages ) const
+         {
+         const MappedPageReader reader( directory );
+         EXPECT_EQ( reader.numDocuments( ), numPages );
+         DocId docId = 0;
+         for ( auto &partition : reader.partition( 3 ) )
+            for ( const auto &page : partition )
+               {
+               EXPECT_EQ( page.url, STRING( "http://example.com/" << docId ) );
+               ASSERT_EQ( page.words.size( ), 2 );
+               EXPECT_EQ( page.words[ 1 ], STRING( docId ) );
+               ASSERT_EQ( page.links.size( ), 1 );
+               EXPECT_EQ( page.links[ 0 ].url, STRING( "http://example.com/" << docId + 1 ) );
+               EXPECT_EQ( page.anchorWordsOf( page.links[ 0 ] )[ 0 ], "next" );
+               ++docId;
+               }
+         EXPECT_EQ( docId, numPages );
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( MappedPageReaderTest, ReadPartitions )
+   {
+   writePages( 1000, { .maxSegmentSize = 10000 } );
+   EXPECT_TRUE( std::filesystem::exists( directory / "segment-000001.dat" ) );
+   expectAllPages( 1000 );
+   }
+
+TEST_F( MappedPageReaderTest, ReadCompressedPartitions )
+   {
+   writePages( 1000, { .maxSegmentSize = 10000, .compression = Compression::Zlib, .blockSize = 1000 } );
+   expectAllPages( 1000 );
+   }
+
+TEST_F( MappedPageReaderTest, ForEachOnThreads )
+   {
+   writePages( 1000, { .maxSegmentSize = 10000 } );
+   const MappedPageReader reader( directory );
+   Vector<std::atomic<int>> numReads( 1000 );
+   reader.forEach( 4, [ & ]( DocId docId, const PageRecordView &page )
+      {
+      EXPECT_EQ( page.url, STRING( "http://example.com/" << docId ) );
+      ++numReads[ docId ];
+      } );
+   EXPECT_TRUE( std::all_of( numReads.cbegin( ), numReads.cend( ), [ ]( const auto &numRead )
+      { return numRead == 1; } ) );
+   }
+
+TEST_F( MappedPageReaderTest, ReadEmptyStore )
+   {
+   writePages( 0, { } );
+   const MappedPageReader reader( directory );
+   EXPECT_EQ( reader.numDocuments( ), 0 );
+   auto numPages = 0;
+   reader.forEach( 4, [ & ]( DocId, const PageRecordView & )
+      { ++numPages; } );
+   EXPECT_EQ( numPages, 0 );
+   }
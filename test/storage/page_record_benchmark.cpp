@@ -0,0 +1,109 @@
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#include "core/file_system.h"
+#include "storage/page_record.h"
+
+// Measures single-threaded write and read throughput of the text format and of binary page records, with words as
+// strings or as term IDs, over the pages parsed from a stored corpus of HTML files.
+// Usage: page_record_benchmark <corpus_dir> [num_rounds]
+
+void run( StringView name, size_t numPages, int numRounds, const std::function<size_t( )> &function )
+   {
+   size_t numBytes = 0;
+   const auto beginTime = std::chrono::steady_clock::now( );
+   for ( auto i = 0; i < numRounds; ++i )
+      numBytes += function( );
+   const auto elapsedTime = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( );
+   std::cout << std::left << std::setw( 24 ) << name << std::right << std::fixed << std::setprecision( 1 )
+             << std::setw( 10 ) << static_cast<double>(numBytes) / elapsedTime / ( 1 << 20 ) << " MB/s"
+             << std::setw( 12 ) << static_cast<double>(numPages) * numRounds / elapsedTime << " pages/s"
+             << std::setw( 14 ) << numBytes / numRounds << " bytes" << std::endl;
+   }
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <corpus_dir> [num_rounds]" << std::endl;
+      return 1;
+      }
+   const auto numRounds = argc > 2 ? std::stoi( argv[ 2 ] ) : 5;
+
+   const HtmlParser htmlParser;
+   Vector<String> urls;
+   Vector<HtmlInfo> htmlInfos;
+   for ( const auto &entry : std::filesystem::recursive_directory_iterator( argv[ 1 ] ) )
+      {
+      if ( !entry.is_regular_file( ) ) continue;
+      std::ifstream file( entry.path( ), std::ios::binary );
+      const String page( std::istreambuf_iterator<char>( file ), { } );
+      try
+         {
+         htmlInfos.emplace_back( htmlParser.parse( page ) );
+         urls.emplace_back( entry.path( ).string( ) );
+         }
+      catch ( const FormatException & )
+         { }
+      }
+   std::cout << htmlInfos.size( ) << " pages, " << numRounds << " rounds" << std::endl;
+
+   String text, records;
+   run( "text write", htmlInfos.size( ), numRounds, [ & ]( )
+      {
+      std::ostringstream stream;
+      for ( size_t i = 0; i < htmlInfos.size( ); ++i ) stream << urls[ i ] << '\n' << htmlInfos[ i ] << '\n';
+      text = stream.str( );
+      return text.size( );
+      } );
+   run( "text read", htmlInfos.size( ), numRounds, [ & ]( )
+      {
+      std::istringstream stream( text );
+      for ( size_t i = 0; i < htmlInfos.size( ); ++i )
+         {
+         String url;
+         HtmlInfo htmlInfo;
+         stream >> url >> htmlInfo;
+         }
+      return text.size( );
+      } );
+
+   for ( const auto hasChecksum : { false, true } )
+      {
+      const String suffix = hasChecksum ? " (checksum)" : "";
+      run( "binary write" + suffix, htmlInfos.size( ), numRounds, [ & ]( )
+         {
+         records.clear( );
+         for ( size_t i = 0; i < htmlInfos.size( ); ++i )
+            PageRecord::encode( urls[ i ], htmlInfos[ i ], records, hasChecksum );
+         return records.size( );
+         } );
+      run( "binary read" + suffix, htmlInfos.size( ), numRounds, [ & ]( )
+         {
+         PageRecordView view;
+         for ( size_t pos = 0; pos < records.size( ); )
+            pos += PageRecord::decode( StringView( records ).substr( pos ), view );
+         return records.size( );
+         } );
+      }
+
+   // The dictionary is filled by the first round, so later rounds measure looking up known terms, as in a long crawl.
+   TermDictionary termDictionary;
+   run( "binary write (term IDs)", htmlInfos.size( ), numRounds, [ & ]( )
+      {
+      records.clear( );
+      for ( size_t i = 0; i < htmlInfos.size( ); ++i )
+         PageRecord::encode( urls[ i ], htmlInfos[ i ], records, false, &termDictionary );
+      return records.size( );
+      } );
+   run( "binary read (term IDs)", htmlInfos.size( ), numRounds, [ & ]( )
+      {
+      PageRecordView view;
+      for ( size_t pos = 0; pos < records.size( ); )
+         pos += PageRecord::decode( StringView( records ).substr( pos ), view, &termDictionary );
+      return records.size( );
+      } );
+   std::cout << termDictionary.size( ) << " terms" << std::endl;
+   }
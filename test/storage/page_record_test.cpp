@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "storage/page_record.h"
+
+using namespace testing;
+
+class PageRecordTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         htmlInfo.words = { "search", "engine", "home", "about" };
+         htmlInfo.titleWords = { "search", "engine" };
+         htmlInfo.links.emplace_back( "https://example.com/" ).anchorWords = { "home" };
+         auto &aboutLink = htmlInfo.links.emplace_back( "https://example.com/about" );
+         aboutLink.anchorWords = { "about" };
+         aboutLink.isNoFollow = true;
+         htmlInfo.links.emplace_back( "https://example.com/empty" );
+         htmlInfo.base = Url( "https://example.com/" );
+         }
+
+      static Vector<String> toStrings( std::span<const StringView> words )
+         { return { words.begin( ), words.end( ) }; }
+
+      HtmlInfo htmlInfo;
+   };
+
+TEST_F( PageRecordTest, EncodeAndDecode )
+   {
+   htmlInfo.canonical = Url( "https://example.com/index" );
+   htmlInfo.robots.isNoFollow = true;
+   htmlInfo.simHash = 0xfedcba9876543210ull;
+   String record;
+   PageRecord::encode( "https://example.com/index.html", htmlInfo, record );
+
+   PageRecordView view;
+   EXPECT_EQ( PageRecord::decode( record, view ), record.size( ) );
+   EXPECT_EQ( view.url, "https://example.com/index.html" );
+   EXPECT_EQ( toStrings( view.words ), htmlInfo.words );
+   EXPECT_EQ( toStrings( view.titleWords ), htmlInfo.titleWords );
+   ASSERT_EQ( view.links.size( ), 3 );
+   EXPECT_EQ( view.links[ 1 ].url, "https://example.com/about" );
+   EXPECT_EQ( toStrings( view.anchorWordsOf( view.links[ 1 ] ) ), Vector<String>( { "about" } ) );
+   EXPECT_TRUE( view.links[ 1 ].isNoFollow );
+   EXPECT_FALSE( view.links[ 2 ].isNoFollow );
+   EXPECT_TRUE( view.anchorWordsOf( view.links[ 2 ] ).empty( ) );
+   EXPECT_EQ( view.base, "https://example.com/" );
+   EXPECT_EQ( view.canonical, "https://example.com/index" );
+   EXPECT_FALSE( view.robots.isNoIndex );
+   EXPECT_TRUE( view.robots.isNoFollow );
+   EXPECT_EQ( view.simHash, 0xfedcba9876543210ull );
+
+   // The strings are views into the record.
+   EXPECT_GE( view.words[ 0 ].data( ), record.data( ) );
+   EXPECT_LT( view.words[ 0 ].data( ), record.data( ) + record.size( ) );
+
+   const auto copiedHtmlInfo = view.toHtmlInfo( );
+   EXPECT_EQ( copiedHtmlInfo.links[ 0 ].anchorWords, htmlInfo.links[ 0 ].anchorWords );
+   EXPECT_EQ( copiedHtmlInfo.canonical, htmlInfo.canonical );
+   }
+
+TEST_F( PageRecordTest, DecodeConcatenatedRecords )
+   {
+   String records;
+   PageRecord::encode( "https://example.com/1", htmlInfo, records, true );
+   htmlInfo.base.reset( );
+   PageRecord::encode( "https://example.com/2", htmlInfo, records );
+
+   PageRecordView view;
+   const auto firstSize = PageRecord::decode( records, view );
+   EXPECT_EQ( view.url, "https://example.com/1" );
+   EXPECT_TRUE( view.base.has_value( ) );
+   EXPECT_EQ( PageRecord::decode( StringView( records ).substr( firstSize ), view ), records.size( ) - firstSize );
+   EXPECT_EQ( view.url, "https://example.com/2" );
+   EXPECT_FALSE( view.base.has_value( ) );
+   EXPECT_EQ( view.words.size( ), 4 );
+   }
+
+TEST_F( PageRecordTest, DecodeMalformed )
+   {
+   String record;
+   PageRecord::encode( "https://example.com/", htmlInfo, record, true );
+   PageRecordView view;
+
+   auto corruptRecord = record;
+   corruptRecord[ corruptRecord.size( ) / 2 ] ^= 1;
+   EXPECT_THROW( PageRecord::decode( corruptRecord, view ), FormatException );
+   EXPECT_THROW( PageRecord::decode( StringView( record ).substr( 0, record.size( ) - 1 ), view ), FormatException );
+   corruptRecord = record;
+   corruptRecord[ 0 ] = PageRecord::version + 1;
+   EXPECT_THROW( PageRecord::decode( corruptRecord, view ), FormatException );
+   }
+
+TEST_F( PageRecordTest, EncodeTermIds )
+   {
+   TermDictionary termDictionary;
+   String record, stringRecord;
+   PageRecord::encode( "https://example.com/", htmlInfo, record, false, &termDictionary );
+   PageRecord::encode( "https://example.com/", htmlInfo, stringRecord );
+   EXPECT_LT( record.size( ), stringRecord.size( ) );
+   EXPECT_EQ( termDictionary.size( ), 4 );
+
+   PageRecordView view;
+   EXPECT_EQ( PageRecord::decode( record, view, &termDictionary ), record.size( ) );
+   EXPECT_EQ( toStrings( view.words ), htmlInfo.words );
+   EXPECT_EQ( view.wordIds, Vector<TermId>( { 0, 1, 2, 3 } ) );
+   EXPECT_EQ( view.titleWordIds, Vector<TermId>( { 0, 1 } ) );
+   EXPECT_EQ( toStrings( view.anchorWordsOf( view.links[ 1 ] ) ), Vector<String>( { "about" } ) );
+   EXPECT_EQ( view.anchorWordIds, Vector<TermId>( { 2, 3 } ) );
+
+   // Records of strings have no term IDs, and records of term IDs cannot be read without their dictionary.
+   PageRecord::decode( stringRecord, view, &termDictionary );
+   EXPECT_TRUE( view.wordIds.empty( ) );
+   EXPECT_THROW( PageRecord::decode( record, view ), FormatException );
+   TermDictionary otherTermDictionary;
+   EXPECT_THROW( PageRecord::decode( record, view, &otherTermDictionary ), FormatException );
+   }
+
+TEST_F( PageRecordTest, ReadTextFormat )
+   {
+   std::stringstream stream;
+   stream << htmlInfo;
+   HtmlInfo readHtmlInfo;
+   stream >> readHtmlInfo;
+   EXPECT_EQ( readHtmlInfo.words, htmlInfo.words );
+   EXPECT_EQ( readHtmlInfo.titleWords, htmlInfo.titleWords );
+   ASSERT_EQ( readHtmlInfo.links.size( ), 3 );
+   EXPECT_EQ( readHtmlInfo.links[ 1 ].url, htmlInfo.links[ 1 ].url );
+   EXPECT_EQ( readHtmlInfo.links[ 1 ].anchorWords, htmlInfo.links[ 1 ].anchorWords );
+   EXPECT_EQ( readHtmlInfo.base, htmlInfo.base );
+   }
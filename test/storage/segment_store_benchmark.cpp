@@ -0,0 +1,90 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#include "core/file_system.h"
+#include "storage/page_record.h"
+#include "storage/segment_store.h"
+
+// Measures the compression ratio, the compression CPU cost, and the write, scan and random read throughput of a segment
+// store of the page records parsed from a stored corpus of HTML files, for each available codec.
+// Usage: segment_store_benchmark <corpus_dir> [num_copies] [compression_level]
+
+double secondsSince( std::chrono::steady_clock::time_point beginTime )
+   { return std::chrono::duration<double>( std::chrono::steady_clock::now( ) - beginTime ).count( ); }
+
+int main( int argc, char **argv )
+   {
+   if ( argc < 2 )
+      {
+      std::cerr << "Usage: " << argv[ 0 ] << " <corpus_dir> [num_copies] [compression_level]" << std::endl;
+      return 1;
+      }
+   const auto numCopies = argc > 2 ? std::stoi( argv[ 2 ] ) : 20;
+   const auto compressionLevel = argc > 3 ? std::stoi( argv[ 3 ] ) : 0;
+
+   const HtmlParser htmlParser;
+   Vector<String> records;
+   size_t recordsSize = 0;
+   for ( const auto &entry : std::filesystem::recursive_directory_iterator( argv[ 1 ] ) )
+      {
+      if ( !entry.is_regular_file( ) ) continue;
+      std::ifstream file( entry.path( ), std::ios::binary );
+      const String page( std::istreambuf_iterator<char>( file ), { } );
+      try
+         {
+         PageRecord::encode( entry.path( ).string( ), htmlParser.parse( page ), records.emplace_back( ) );
+         recordsSize += records.back( ).size( );
+         }
+      catch ( const FormatException & )
+         { }
+      }
+   const auto totalSize = static_cast<double>(recordsSize) * numCopies / ( 1 << 20 );
+   std::cout << records.size( ) << " records x " << numCopies << " copies [" << std::fixed << std::setprecision( 1 )
+             << totalSize << " MB]" << std::endl;
+
+   const auto directory = std::filesystem::temp_directory_path( ) / "segment_store_benchmark";
+   for ( const auto compression : { Compression::None, Compression::Zlib, Compression::Zstd } )
+      {
+      if ( !BlockCodec::isAvailable( compression ) ) continue;
+      std::filesystem::remove_all( directory );
+
+      auto beginTime = std::chrono::steady_clock::now( );
+      double ratio, compressionTime;
+         {
+         SegmentWriter writer( directory, { .compression = compression, .compressionLevel = compressionLevel } );
+         for ( auto i = 0; i < numCopies; ++i )
+            for ( const auto &record : records )
+               writer.append( record );
+         writer.commit( );
+         ratio = writer.numCompressedBytes( ) > 0 ?
+                 static_cast<double>(writer.numUncompressedBytes( )) / writer.numCompressedBytes( ) : 1.0;
+         compressionTime = writer.compressionTime( );
+         }
+      const auto writeTime = secondsSince( beginTime );
+
+      const SegmentReader reader( directory );
+      beginTime = std::chrono::steady_clock::now( );
+      size_t numScanned = 0;
+      reader.scan( [ & ]( DocId, StringView )
+         { ++numScanned; } );
+      const auto scanTime = secondsSince( beginTime );
+
+      std::mt19937_64 random( 42 );
+      const auto numReads = 1000;
+      beginTime = std::chrono::steady_clock::now( );
+      for ( auto i = 0; i < numReads; ++i )
+         ( void )reader.read( random( ) % reader.numRecords( ) );
+      const auto readTime = secondsSince( beginTime );
+
+      static const char *const names[ ] = { "none", "zlib", "zstd" };
+      std::cout << std::left << std::setw( 6 ) << names[ static_cast<int>(compression) ] << std::right
+                << "ratio " << std::setprecision( 2 ) << ratio << "x" << std::setprecision( 1 )
+                << "  write " << totalSize / writeTime << " MB/s"
+                << "  compress " << ( compressionTime > 0 ? totalSize / compressionTime : 0.0 ) << " MB/CPU-s"
+                << "  scan " << totalSize / scanTime << " MB/s"
+                << "  read " << readTime / numReads * 1e6 << " us/record" << std::endl;
+      }
+   std::filesystem::remove_all( directory );
+   }
@@ -0,0 +1,231 @@
+#include <csignal>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+
+#include "storage/segment_store.h"
+
+using namespace testing;
+
+class SegmentStoreTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "segment_store_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      static Vector<String> scan( const SegmentReader &reader )
+         {
+         Vector<String> records;
+         reader.scan( [ & ]( DocId docId, StringView record )
+            {
+            EXPECT_EQ( docId, records.size( ) );
+            records.emplace_back( record );
+            } );
+         return records;
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( SegmentStoreTest, AppendAndRead )
+   {
+      {
+      SegmentWriter writer( directory );
+      EXPECT_EQ( writer.append( "first" ), 0 );
+      EXPECT_EQ( writer.append( "" ), 1 );
+      EXPECT_EQ( writer.append( "third" ), 2 );
+      EXPECT_EQ( writer.numRecords( ), 3 );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( reader.numRecords( ), 3 );
+   EXPECT_EQ( reader.read( 2 ), "third" );
+   EXPECT_EQ( reader.read( 1 ), "" );
+   EXPECT_EQ( reader.read( 0 ), "first" );
+   EXPECT_THROW( ( void )reader.read( 3 ), ArgumentException );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "first", "", "third" } ) );
+   }
+
+TEST_F( SegmentStoreTest, RollSegments )
+   {
+   Vector<String> records;
+      {
+      SegmentWriter writer( directory, { .maxSegmentSize = 100, .groupCommitSize = 30 } );
+      for ( auto i = 0; i < 50; ++i )
+         writer.append( records.emplace_back( STRING( "record " << i ) ) );
+      // A record larger than a segment gets a segment of its own.
+      writer.append( records.emplace_back( 200, 'x' ) );
+      }
+   EXPECT_TRUE( std::filesystem::exists( directory / "segment-000004.dat" ) );
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( reader.numRecords( ), records.size( ) );
+   for ( size_t i = 0; i < records.size( ); ++i )
+      EXPECT_EQ( reader.read( i ), records[ i ] );
+   EXPECT_EQ( scan( reader ), records );
+   }
+
+TEST_F( SegmentStoreTest, Reopen )
+   {
+      {
+      SegmentWriter writer( directory, { .maxSegmentSize = 16 } );
+      writer.append( "0123456789" );
+      writer.append( "abcdefghij" );
+      }
+      {
+      SegmentWriter writer( directory, { .maxSegmentSize = 16 } );
+      EXPECT_EQ( writer.numRecords( ), 2 );
+      EXPECT_EQ( writer.append( "klmnopqrst" ), 2 );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "0123456789", "abcdefghij", "klmnopqrst" } ) );
+   }
+
+TEST_F( SegmentStoreTest, RepairAfterCrash )
+   {
+      {
+      SegmentWriter writer( directory );
+      writer.append( "committed" );
+      }
+
+   // Simulates a crash after the data of a group was written, and during the write of its index entries.
+   std::ofstream( directory / "segment-000000.dat", std::ios::app ) << "uncommitted";
+   std::ofstream( directory / "segment-000000.idx", std::ios::app | std::ios::binary ) << "torn";
+
+      {
+      SegmentWriter writer( directory );
+      EXPECT_EQ( writer.numRecords( ), 1 );
+      EXPECT_EQ( writer.append( "recovered" ), 1 );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "committed", "recovered" } ) );
+   }
+
+TEST_F( SegmentStoreTest, RetryPartialCommit )
+   {
+   String record;
+   for ( auto i = 0; i < 10; ++i ) record += "0123456789";
+      {
+      SegmentWriter writer( directory, { .groupCommitSize = SIZE_MAX } );
+      writer.append( record );
+
+      // Fails the commit halfway through the data with a file size limit, as a full disk would.
+      const auto previousHandler = std::signal( SIGXFSZ, SIG_IGN );
+      rlimit limit{ };
+      ::getrlimit( RLIMIT_FSIZE, &limit );
+      const auto previousLimit = limit;
+      limit.rlim_cur = record.size( ) / 2;
+      ::setrlimit( RLIMIT_FSIZE, &limit );
+      EXPECT_THROW( writer.commit( ), SystemException );
+      ::setrlimit( RLIMIT_FSIZE, &previousLimit );
+      std::signal( SIGXFSZ, previousHandler );
+
+      writer.commit( );
+      writer.append( "second" );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( scan( reader ), Vector<String>( { record, "second" } ) );
+   }
+
+TEST_F( SegmentStoreTest, CallBeforeCommit )
+   {
+   Vector<size_t> numCommittedRecords;
+   auto isFailing = false;
+   const SegmentStoreConfiguration config{
+      .groupCommitSize = SIZE_MAX,
+      .beforeCommit = [ & ]( )
+         {
+         numCommittedRecords.push_back( SegmentReader( directory ).numRecords( ) );
+         if ( isFailing ) throw IOException( "The dictionary cannot be written." );
+         } };
+      {
+      SegmentWriter writer( directory, config );
+      writer.append( "first" );
+      writer.commit( );
+      writer.append( "second" );
+
+      // A failure before the commit leaves the records buffered for a retry.
+      isFailing = true;
+      EXPECT_THROW( writer.commit( ), IOException );
+      isFailing = false;
+      writer.commit( );
+      }
+   EXPECT_EQ( numCommittedRecords, Vector<size_t>( { 0, 1, 1 } ) );
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "first", "second" } ) );
+   }
+
+TEST_F( SegmentStoreTest, CompressBlocks )
+   {
+   const SegmentStoreConfiguration config{
+         .maxSegmentSize = 1000, .compression = Compression::Zlib, .blockSize = 256, .numCompressionThreads = 3 };
+   Vector<String> records;
+      {
+      SegmentWriter writer( directory, config );
+      for ( auto i = 0; i < 500; ++i )
+         EXPECT_EQ( writer.append( records.emplace_back( STRING( "https://example.com/page/" << i ) ) ), i );
+      writer.commit( );
+      EXPECT_GT( writer.numCompressedBytes( ), 0 );
+      EXPECT_GT( writer.numUncompressedBytes( ), 2 * writer.numCompressedBytes( ) );
+      }
+   EXPECT_TRUE( std::filesystem::exists( directory / "segment-000001.blk" ) );
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( reader.numRecords( ), records.size( ) );
+   EXPECT_EQ( reader.read( 0 ), records[ 0 ] );
+   EXPECT_EQ( reader.read( 257 ), records[ 257 ] );
+   EXPECT_EQ( reader.read( 499 ), records[ 499 ] );
+   EXPECT_EQ( scan( reader ), records );
+   }
+
+TEST_F( SegmentStoreTest, SwitchCompression )
+   {
+      {
+      SegmentWriter writer( directory );
+      writer.append( "stored as is" );
+      }
+      {
+      SegmentWriter writer( directory, { .compression = Compression::Zlib } );
+      EXPECT_EQ( writer.append( "compressed" ), 1 );
+      }
+      {
+      SegmentWriter writer( directory );
+      EXPECT_EQ( writer.append( "stored as is again" ), 2 );
+      }
+   EXPECT_TRUE( std::filesystem::exists( directory / "segment-000001.blk" ) );
+   EXPECT_TRUE( std::filesystem::exists( directory / "segment-000002.dat" ) );
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( reader.read( 1 ), "compressed" );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "stored as is", "compressed", "stored as is again" } ) );
+   }
+
+TEST_F( SegmentStoreTest, RepairCompressedAfterCrash )
+   {
+   const SegmentStoreConfiguration config{ .compression = Compression::Zlib, .blockSize = 1 };
+      {
+      SegmentWriter writer( directory, config );
+      writer.append( "committed" );
+      }
+   std::ofstream( directory / "segment-000000.blk", std::ios::app ) << "uncommitted block";
+
+      {
+      SegmentWriter writer( directory, config );
+      EXPECT_EQ( writer.append( "recovered" ), 1 );
+      }
+
+   const SegmentReader reader( directory );
+   EXPECT_EQ( scan( reader ), Vector<String>( { "committed", "recovered" } ) );
+   }
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "storage/term_dictionary.h"
+
+using namespace testing;
+
+// Half of the threads intern the terms in reverse order, so that new terms race with each other.
+String termOf( int thread, int i )
+   { return STRING( "term" << ( thread % 2 == 0 ? i : 9999 - i ) ); }
+
+TEST( TermDictionaryTest, InternConcurrently )
+   {
+   static constexpr auto numThreads = 4, numTerms = 10000;
+   TermDictionary termDictionary;
+   Vector<Vector<TermId>> termIds( numThreads );
+   Vector<Thread> threads;
+   for ( auto i = 0; i < numThreads; ++i )
+      threads.emplace_back( [ &, i ]( )
+         {
+         for ( auto j = 0; j < numTerms; ++j )
+            termIds[ i ].push_back( termDictionary.intern( termOf( i, j ) ) );
+         } );
+   for ( auto &thread : threads )
+      thread.join( );
+
+   // Every thread gets the same ID for a term, and the IDs are dense.
+   ASSERT_EQ( termDictionary.size( ), numTerms );
+   for ( auto i = 0; i < numThreads; ++i )
+      for ( auto j = 0; j < numTerms; ++j )
+         {
+         const auto term = termOf( i, j );
+         EXPECT_EQ( termIds[ i ][ j ], termDictionary.find( term ) );
+         EXPECT_EQ( termDictionary.term( termIds[ i ][ j ] ), term );
+         }
+   EXPECT_EQ( termDictionary.find( "missing" ), std::nullopt );
+   EXPECT_THROW( static_cast<void>(termDictionary.term( numTerms )), FormatException );
+   }
+
+TEST( TermDictionaryTest, PersistAndReload )
+   {
+   const auto path = std::filesystem::temp_directory_path( ) / STRING( "term_dictionary_test_" << ::getpid( ) );
+   std::filesystem::remove( path );
+      {
+      TermDictionary termDictionary( path );
+      EXPECT_EQ( termDictionary.intern( "search" ), 0 );
+      EXPECT_EQ( termDictionary.intern( "engine" ), 1 );
+      termDictionary.persist( );
+      EXPECT_EQ( termDictionary.intern( "crawler" ), 2 );
+      }
+
+      {
+      // The destructor persisted the last term, and new terms continue the IDs.
+      TermDictionary termDictionary( path );
+      EXPECT_EQ( termDictionary.size( ), 3 );
+      EXPECT_EQ( termDictionary.find( "crawler" ), 2 );
+      EXPECT_EQ( termDictionary.intern( "index" ), 3 );
+      }
+
+   // A torn last term is dropped, and the file is appended to after the last whole term.
+   std::filesystem::resize_file( path, std::filesystem::file_size( path ) - 2 );
+      {
+      TermDictionary termDictionary( path );
+      EXPECT_EQ( termDictionary.size( ), 3 );
+      EXPECT_EQ( termDictionary.intern( "ranker" ), 3 );
+      }
+      {
+      const TermDictionary termDictionary( path );
+      EXPECT_EQ( termDictionary.size( ), 4 );
+      EXPECT_EQ( termDictionary.term( 3 ), "ranker" );
+      }
+
+   // Reading only leaves a torn last term in the file, and new terms are not persisted.
+   const auto tornSize = std::filesystem::file_size( path ) - 2;
+   std::filesystem::resize_file( path, tornSize );
+      {
+      TermDictionary termDictionary( path, true );
+      EXPECT_EQ( termDictionary.size( ), 3 );
+      EXPECT_EQ( termDictionary.intern( "snippet" ), 3 );
+      termDictionary.persist( );
+      }
+   EXPECT_EQ( std::filesystem::file_size( path ), tornSize );
+   std::filesystem::remove( path );
+   }
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "storage/warc_archive.h"
+
+using namespace testing;
+
+class WarcArchiveTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "warc_archive_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      static HttpResponseMessage makeResponse( StringView content )
+         {
+         HttpResponseHeaders headers;
+         headers.contentType = "text/html; charset=utf-8";
+         return { "1.1", 200, "OK", std::move( headers ), String( content ) };
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( WarcArchiveTest, ReadByUrl )
+   {
+      {
+      WarcWriter writer( directory, { .maxFileSize = 300 } );
+      for ( auto i = 0; i < 20; ++i )
+         writer.write( Url( STRING( "http://example.com/" << i ) ),
+                       makeResponse( STRING( "<p>page " << i << "</p>" ) ) );
+      writer.write( Url( "http://example.com/3" ), makeResponse( "<p>page 3 again</p>" ) );
+      EXPECT_EQ( writer.numRecords( ), 21 );
+      }
+   EXPECT_TRUE( std::filesystem::exists( directory / "archive-000001.warc.gz" ) );
+
+   const WarcReader reader( directory );
+   EXPECT_EQ( reader.entries( ).size( ), 21 );
+   const auto *entry = reader.find( Url( "http://example.com/7" ) );
+   ASSERT_NE( entry, nullptr );
+   const auto response = reader.read( *entry );
+   EXPECT_EQ( response.statusCode, 200 );
+   EXPECT_EQ( response.reasonPhrase, "OK" );
+   EXPECT_EQ( response.headers.contentType, "text/html; charset=utf-8" );
+   EXPECT_EQ( response.content, "<p>page 7</p>" );
+
+   // The latest response from a URL is found.
+   EXPECT_EQ( reader.read( *reader.find( Url( "http://example.com/3" ) ) ).content, "<p>page 3 again</p>" );
+   EXPECT_EQ( reader.find( Url( "http://example.com/missing" ) ), nullptr );
+   }
+
+TEST_F( WarcArchiveTest, AppendAcrossRuns )
+   {
+   WarcWriter( directory ).write( Url( "http://example.com/a" ), makeResponse( "a" ) );
+   WarcWriter( directory ).write( Url( "http://example.com/b" ), makeResponse( "b" ) );
+
+   const WarcReader reader( directory );
+   EXPECT_EQ( reader.entries( ).size( ), 2 );
+   EXPECT_EQ( reader.read( *reader.find( Url( "http://example.com/a" ) ) ).content, "a" );
+   EXPECT_EQ( reader.read( *reader.find( Url( "http://example.com/b" ) ) ).content, "b" );
+   }
+
+TEST_F( WarcArchiveTest, IndexEachFile )
+   {
+   auto numFiles = 0;
+      {
+      WarcWriter writer( directory, { .maxFileSize = 300 } );
+      for ( auto i = 0; i < 20; ++i )
+         writer.write( Url( STRING( "http://example.com/" << i ) ), makeResponse( STRING( "page " << i ) ) );
+      writer.flush( );
+      while ( std::filesystem::exists( directory / STRING( "archive-00000" << numFiles << ".warc.gz" ) ) ) ++numFiles;
+      ASSERT_GT( numFiles, 2 );
+
+      // The index of a full archive file lists its records only.
+      const WarcReader reader( directory );
+      EXPECT_EQ( reader.entries( ).size( ), 20 );
+      EXPECT_EQ( reader.find( Url( "http://example.com/0" ) )->file, 0 );
+      EXPECT_EQ( reader.find( Url( "http://example.com/19" ) )->file, numFiles - 1 );
+      }
+
+   // A crash before the index of the open archive file is written loses the index of that file only.
+   std::filesystem::remove( directory / STRING( "archive-00000" << numFiles - 1 << ".cdx" ) );
+   const WarcReader reader( directory );
+   EXPECT_EQ( reader.find( Url( "http://example.com/19" ) ), nullptr );
+   EXPECT_EQ( reader.read( *reader.find( Url( "http://example.com/0" ) ) ).content, "page 0" );
+   }
+
+TEST_F( WarcArchiveTest, ReadAsGzip )
+   {
+      {
+      WarcWriter writer( directory );
+      writer.write( Url( "http://example.com/a" ), makeResponse( "first" ) );
+      writer.write( Url( "http://example.com/b" ), makeResponse( "second" ) );
+      }
+
+   // A standard gzip reader decompresses the concatenated members of the archive file.
+   const auto file = gzopen( ( directory / "archive-000000.warc.gz" ).c_str( ), "rb" );
+   ASSERT_NE( file, nullptr );
+   String data( 4096, '\0' );
+   data.resize( gzread( file, data.data( ), static_cast<unsigned>(data.size( )) ) );
+   gzclose( file );
+   EXPECT_TRUE( data.starts_with( "WARC/1.0\r\nWARC-Type: response\r\n" ) );
+   EXPECT_NE( data.find( "WARC-Target-URI: http://example.com/b\r\n" ), String::npos );
+   EXPECT_TRUE( data.ends_with( "second\r\n\r\n" ) );
+   }
+
+TEST_F( WarcArchiveTest, ReadCorruptContentLength )
+   {
+   WarcWriter( directory ).write( Url( "http://example.com/a" ), makeResponse( "a" ) );
+
+   // Rewrites the archive file with letters in place of the digits of the WARC Content-Length.
+   const auto path = directory / "archive-000000.warc.gz";
+   auto file = gzopen( path.c_str( ), "rb" );
+   ASSERT_NE( file, nullptr );
+   String data( 4096, '\0' );
+   data.resize( gzread( file, data.data( ), static_cast<unsigned>(data.size( )) ) );
+   gzclose( file );
+   const StringView contentLengthName = "\r\nContent-Length: ";
+   for ( auto i = data.find( contentLengthName ) + contentLengthName.size( ); std::isdigit( data[ i ] ); ++i )
+      data[ i ] = 'x';
+   file = gzopen( path.c_str( ), "wb" );
+   ASSERT_NE( file, nullptr );
+   gzwrite( file, data.data( ), static_cast<unsigned>(data.size( )) );
+   gzclose( file );
+
+   const WarcReader reader( directory );
+   auto entry = *reader.find( Url( "http://example.com/a" ) );
+   entry.length = std::filesystem::file_size( path );
+   EXPECT_THROW( reader.read( entry ), FormatException );
+   }
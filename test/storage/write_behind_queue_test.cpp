@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "core/hash_table.h"
+#include "storage/segment_store.h"
+#include "storage/write_behind_queue.h"
+
+using namespace testing;
+
+class WriteBehindQueueTest : public Test
+   {
+   protected:
+      void SetUp( ) override
+         {
+         directory = std::filesystem::temp_directory_path( ) /
+                     STRING( "write_behind_queue_test_" << ::getpid( ) << '_' <<
+                             UnitTest::GetInstance( )->current_test_info( )->name( ) );
+         std::filesystem::remove_all( directory );
+         }
+
+      void TearDown( ) override
+         { std::filesystem::remove_all( directory ); }
+
+      HashSet<String> readAll( ) const
+         {
+         HashSet<String> records;
+         SegmentReader( directory ).scan( [ & ]( DocId, StringView record )
+            { records.emplace( record ); } );
+         return records;
+         }
+
+      std::filesystem::path directory;
+   };
+
+TEST_F( WriteBehindQueueTest, PushFromManyThreads )
+   {
+   static constexpr auto numThreads = 4, numRecordsPerThread = 1000;
+   SegmentWriter segmentWriter( directory );
+   WriteBehindQueue writeBehindQueue( segmentWriter, { .maxBatchSize = 100, .numWriterThreads = 2 } );
+   Vector<Thread> threads;
+   for ( auto i = 0; i < numThreads; ++i )
+      threads.emplace_back( [ &, i ]( )
+         {
+         for ( auto j = 0; j < numRecordsPerThread; ++j )
+            writeBehindQueue.push( STRING( "record " << i << ' ' << j ) );
+         } );
+   for ( auto &thread : threads )
+      thread.join( );
+   writeBehindQueue.flush( );
+
+   EXPECT_EQ( writeBehindQueue.queueSize( ), 0 );
+   EXPECT_GT( writeBehindQueue.peakQueueSize( ), 0 );
+   EXPECT_EQ( segmentWriter.numRecords( ), numThreads * numRecordsPerThread );
+   const auto records = readAll( );
+   EXPECT_EQ( records.size( ), numThreads * numRecordsPerThread );
+   EXPECT_TRUE( records.contains( "record 3 999" ) );
+   }
+
+TEST_F( WriteBehindQueueTest, WaitWhileFull )
+   {
+   SegmentWriter segmentWriter( directory );
+      {
+      // Only one record fits at a time, and a record larger than the queue still gets in when it is empty.
+      WriteBehindQueue writeBehindQueue( segmentWriter, { .maxQueueSize = 10 } );
+      for ( auto i = 0; i < 100; ++i )
+         writeBehindQueue.push( STRING( "record " << i ) );
+      writeBehindQueue.push( String( 100, 'x' ) );
+      EXPECT_LE( writeBehindQueue.peakQueueSize( ), 100 );
+      }
+
+   const auto records = readAll( );
+   EXPECT_EQ( records.size( ), 101 );
+   EXPECT_TRUE( records.contains( String( 100, 'x' ) ) );
+   }